@@ -1,6 +1,7 @@
 -- ============================================
 -- WordMaster 数据库初始化脚本
 -- Version: 1.0.0
+-- 由 SchemaMigrator 作为 1 号迁移执行；语句均为幂等，可在旧库上重复执行
 -- ============================================
 
 -- 1. 词库元数据表
@@ -18,8 +19,8 @@ CREATE TABLE IF NOT EXISTS books (
     is_active BOOLEAN DEFAULT 0
 );
 
-CREATE INDEX idx_books_category ON books(category);
-CREATE INDEX idx_books_is_active ON books(is_active);
+CREATE INDEX IF NOT EXISTS idx_books_category ON books(category);
+CREATE INDEX IF NOT EXISTS idx_books_is_active ON books(is_active);
 
 -- 2. 单词主表
 CREATE TABLE IF NOT EXISTS words (
@@ -40,9 +41,9 @@ CREATE TABLE IF NOT EXISTS words (
     UNIQUE(book_id, word_id)                -- 同一词库内word_id唯一
 );
 
-CREATE INDEX idx_words_word ON words(word);
-CREATE INDEX idx_words_book_id ON words(book_id);
-CREATE UNIQUE INDEX idx_words_book_word ON words(book_id, word);
+CREATE INDEX IF NOT EXISTS idx_words_word ON words(word);
+CREATE INDEX IF NOT EXISTS idx_words_book_id ON words(book_id);
+CREATE UNIQUE INDEX IF NOT EXISTS idx_words_book_word ON words(book_id, word);
 
 -- 3. 学习记录表
 CREATE TABLE IF NOT EXISTS study_records (
@@ -57,9 +58,9 @@ CREATE TABLE IF NOT EXISTS study_records (
     FOREIGN KEY(book_id) REFERENCES books(id) ON DELETE CASCADE
 );
 
-CREATE INDEX idx_study_records_word_id ON study_records(word_id);
-CREATE INDEX idx_study_records_studied_at ON study_records(studied_at);
-CREATE INDEX idx_study_records_book_id ON study_records(book_id);
+CREATE INDEX IF NOT EXISTS idx_study_records_word_id ON study_records(word_id);
+CREATE INDEX IF NOT EXISTS idx_study_records_studied_at ON study_records(studied_at);
+CREATE INDEX IF NOT EXISTS idx_study_records_book_id ON study_records(book_id);
 
 -- 4. 复习计划表
 CREATE TABLE IF NOT EXISTS review_schedule (
@@ -77,9 +78,9 @@ CREATE TABLE IF NOT EXISTS review_schedule (
     FOREIGN KEY(book_id) REFERENCES books(id) ON DELETE CASCADE
 );
 
-CREATE INDEX idx_review_next_date ON review_schedule(next_review_date);
-CREATE INDEX idx_review_mastery ON review_schedule(mastery_level);
-CREATE INDEX idx_review_book_id ON review_schedule(book_id);
+CREATE INDEX IF NOT EXISTS idx_review_next_date ON review_schedule(next_review_date);
+CREATE INDEX IF NOT EXISTS idx_review_mastery ON review_schedule(mastery_level);
+CREATE INDEX IF NOT EXISTS idx_review_book_id ON review_schedule(book_id);
 
 -- 5. 单词标签表（生词本/错误本/收藏本）
 CREATE TABLE IF NOT EXISTS word_tags (
@@ -90,7 +91,7 @@ CREATE TABLE IF NOT EXISTS word_tags (
     FOREIGN KEY(word_id) REFERENCES words(id) ON DELETE CASCADE
 );
 
-CREATE INDEX idx_word_tags_type ON word_tags(tag_type);
+CREATE INDEX IF NOT EXISTS idx_word_tags_type ON word_tags(tag_type);
 
 -- 6. 用户设置表
 CREATE TABLE IF NOT EXISTS user_preferences (
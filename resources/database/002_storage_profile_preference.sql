@@ -0,0 +1,7 @@
+-- ============================================
+-- 002: 存储参数配置
+-- 可选值见 StorageProfile::presetNames()
+-- ============================================
+
+INSERT OR IGNORE INTO user_preferences (key, value) VALUES
+    ('storage_profile', 'desktop');
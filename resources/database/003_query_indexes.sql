@@ -0,0 +1,37 @@
+-- ============================================
+-- 003: 按仓储查询调整索引
+-- 每条仓储查询都应命中索引，由 test_query_plans 检查
+-- ============================================
+
+-- 今日复习/逾期：book_id 等值 + next_review_date 范围，按 (next_review_date, repetition_count) 排序；
+-- word_id 即 rowid，mastery_level 也在索引中，查询无需回表、无需排序
+CREATE INDEX IF NOT EXISTS idx_review_book_due
+    ON review_schedule(book_id, next_review_date, repetition_count, mastery_level);
+DROP INDEX IF EXISTS idx_review_book_id;
+
+-- 今日统计：book_id 等值 + studied_at 范围
+CREATE INDEX IF NOT EXISTS idx_study_records_book_studied_at
+    ON study_records(book_id, studied_at);
+DROP INDEX IF EXISTS idx_study_records_book_id;
+
+-- 标签列表按标记时间倒序
+CREATE INDEX IF NOT EXISTS idx_word_tags_type_tagged_at
+    ON word_tags(tag_type, tagged_at);
+DROP INDEX IF EXISTS idx_word_tags_type;
+
+-- 单词前缀搜索（不区分大小写）
+CREATE INDEX IF NOT EXISTS idx_words_word_nocase
+    ON words(word COLLATE NOCASE);
+DROP INDEX IF EXISTS idx_words_word;
+
+-- 今日统计视图改为范围条件
+DROP VIEW IF EXISTS v_today_stats;
+CREATE VIEW v_today_stats AS
+SELECT 
+    book_id,
+    COUNT(CASE WHEN study_type = 'learn' THEN 1 END) as new_words_count,
+    COUNT(CASE WHEN study_type = 'review' THEN 1 END) as review_words_count,
+    SUM(study_duration) as total_duration
+FROM study_records
+WHERE studied_at >= DATE('now') AND studied_at < DATE('now', '+1 day')
+GROUP BY book_id;
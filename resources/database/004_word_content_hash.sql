@@ -0,0 +1,7 @@
+-- ============================================
+-- 004: 单词内容哈希
+-- 增量导入据此判断单词是否变化（Word::contentHash()，SHA-1）；
+-- 旧数据为 NULL，下次增量导入时视为已变化并原地补写
+-- ============================================
+
+ALTER TABLE words ADD COLUMN content_hash BLOB;
@@ -0,0 +1,41 @@
+-- ============================================
+-- 005: 单词表冷热拆分
+-- words 只保留列表视图需要的热数据（单词、音标、简释），
+-- 释义、例句等 JSON 大字段移到 word_details，按需读取。
+-- words 中原有的 JSON 列保留但置空（SQLite 旧版本不支持 DROP COLUMN，
+-- 重建表又会级联删除学习记录），空间在下次 VACUUM 时回收。
+-- ============================================
+
+CREATE TABLE IF NOT EXISTS word_details (
+    word_id INTEGER PRIMARY KEY,            -- 关联words表的自增ID
+    translations TEXT,                      -- JSON: trans数组
+    sentences TEXT,                         -- JSON: sentences数组
+    phrases TEXT,                           -- JSON: phrases数组
+    synonyms TEXT,                          -- JSON: synos数组
+    related_words TEXT,                     -- JSON: relWords对象
+    etymology TEXT,                         -- JSON: etymology数组
+    FOREIGN KEY(word_id) REFERENCES words(id) ON DELETE CASCADE
+);
+
+INSERT OR REPLACE INTO word_details
+    (word_id, translations, sentences, phrases, synonyms, related_words, etymology)
+SELECT id, translations, sentences, phrases, synonyms, related_words, etymology
+FROM words;
+
+-- 简释：第一条释义的 cn（或 tranCn）字段，最多 40 个字符（与 Word::glossFromTranslations() 一致）。
+-- 旧数据是紧凑 JSON，按 "cn":" 定位即可；含转义引号的释义会被截断在引号处
+ALTER TABLE words ADD COLUMN gloss TEXT;
+
+UPDATE words SET gloss = substr(trim(substr(
+        substr(translations, instr(translations, '"cn":"') + 6), 1,
+        instr(substr(translations, instr(translations, '"cn":"') + 6), '"') - 1)), 1, 40)
+WHERE instr(translations, '"cn":"') > 0;
+
+UPDATE words SET gloss = substr(trim(substr(
+        substr(translations, instr(translations, '"tranCn":"') + 10), 1,
+        instr(substr(translations, instr(translations, '"tranCn":"') + 10), '"') - 1)), 1, 40)
+WHERE gloss IS NULL AND instr(translations, '"tranCn":"') > 0;
+
+UPDATE words
+SET translations = NULL, sentences = NULL, phrases = NULL,
+    synonyms = NULL, related_words = NULL, etymology = NULL;
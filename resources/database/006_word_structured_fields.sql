@@ -0,0 +1,39 @@
+-- ============================================
+-- 006: 释义、例句、短语的结构化子表
+-- 导入时由 word_details 中的 JSON 解析写入，可按词性等字段建索引查询，
+-- 显示时不再解析 JSON。近义词、相关词、词源结构不统一，仍只存 JSON。
+-- 本迁移之前导入的单词没有子表数据：仓储读取时回退到解析 JSON，
+-- 增量更新（--update）或重新导入后写入子表。
+-- ============================================
+
+CREATE TABLE IF NOT EXISTS word_translations (
+    word_id INTEGER NOT NULL,               -- 关联words表的自增ID
+    position INTEGER NOT NULL,              -- 在 trans 数组中的序号
+    book_id TEXT NOT NULL,                  -- 冗余词库ID，按词库+词性查询不必回表
+    pos TEXT,                               -- 词性，如 "v."
+    meaning TEXT,                           -- 中文释义
+    PRIMARY KEY(word_id, position),
+    FOREIGN KEY(word_id) REFERENCES words(id) ON DELETE CASCADE
+);
+
+-- 按词库+词性查单词（如 CET-4 中的全部动词），覆盖 word_id
+CREATE INDEX IF NOT EXISTS idx_word_translations_book_pos
+    ON word_translations(book_id, pos, word_id);
+
+CREATE TABLE IF NOT EXISTS word_sentences (
+    word_id INTEGER NOT NULL,
+    position INTEGER NOT NULL,              -- 在 sentences 数组中的序号
+    english TEXT,                           -- 例句原文
+    chinese TEXT,                           -- 例句译文
+    PRIMARY KEY(word_id, position),
+    FOREIGN KEY(word_id) REFERENCES words(id) ON DELETE CASCADE
+);
+
+CREATE TABLE IF NOT EXISTS word_phrases (
+    word_id INTEGER NOT NULL,
+    position INTEGER NOT NULL,              -- 在 phrases 数组中的序号
+    phrase TEXT,                            -- 短语
+    meaning TEXT,                           -- 短语释义
+    PRIMARY KEY(word_id, position),
+    FOREIGN KEY(word_id) REFERENCES words(id) ON DELETE CASCADE
+);
@@ -0,0 +1,17 @@
+-- ============================================
+-- 007: word_details 字段的压缩字典
+-- 按词库训练的 zstd 字典（导入时可选生成）。压缩后的字段以 BLOB 存于 word_details，
+-- 开头 4 字节为本表 id（小端）；未压缩的字段仍为 TEXT，两者可以混存。
+-- 字典只追加不修改：已压缩的字段始终引用训练时的字典。
+-- ============================================
+
+CREATE TABLE IF NOT EXISTS detail_dictionaries (
+    id INTEGER PRIMARY KEY AUTOINCREMENT,
+    book_id TEXT NOT NULL,                  -- 训练样本所属词库
+    dictionary BLOB NOT NULL,               -- zstd 字典
+    created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
+    FOREIGN KEY(book_id) REFERENCES books(id) ON DELETE CASCADE
+);
+
+CREATE INDEX IF NOT EXISTS idx_detail_dictionaries_book
+    ON detail_dictionaries(book_id, id);
@@ -0,0 +1,32 @@
+-- ============================================
+-- 008: 单词全文索引（FTS5）
+-- word_search 的 rowid 即 words.id：删除单词由触发器同步删除索引行，
+-- 写入与修改单词时由仓储同步写入（替换单词前先删除旧 id 的索引行）。
+-- FTS5 是 SQLite 的编译选项，不可用时跳过本迁移，搜索回退为 LIKE。
+-- 已有单词不在迁移中建索引（大库耗时较长）：search_backfill 记录待补建的 id 范围，
+-- 由程序分批补建（WordRepository::backfillSearchIndex），补建完成前搜索回退为 LIKE。
+-- ============================================
+-- @optional
+
+CREATE VIRTUAL TABLE IF NOT EXISTS word_search USING fts5(
+    word, meaning, sentence, phrase,
+    tokenize = 'unicode61', prefix = '2 3'
+);
+
+-- 旧版本按需创建的索引可能含有替换单词后遗留的行，清空后统一补建
+DELETE FROM word_search;
+
+CREATE TRIGGER IF NOT EXISTS words_search_delete AFTER DELETE ON words
+BEGIN
+    DELETE FROM word_search WHERE rowid = old.id;
+END;
+
+CREATE TABLE IF NOT EXISTS search_backfill (
+    next_id INTEGER NOT NULL,               -- 下一个待建索引的 words.id
+    end_id INTEGER NOT NULL                 -- 迁移时的 id 上界（不含），之后写入的单词已同步建索引
+);
+
+DELETE FROM search_backfill;
+
+INSERT INTO search_backfill (next_id, end_id)
+    SELECT 1, MAX(id) + 1 FROM words HAVING COUNT(*) > 0;
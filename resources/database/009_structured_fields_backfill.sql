@@ -0,0 +1,18 @@
+-- ============================================
+-- 009: 补建 006 之前导入的单词的结构化子表
+-- 这些单词只有 word_details 中的 JSON，没有子表行（按词性查询查不到）。
+-- 解析在程序中进行：JSON 格式有别名（cn / tranCn），压缩过的字段是 BLOB，
+-- 且旧版 SQLite 不一定含 JSON 函数。此处只记录待补建的单词，
+-- 由程序分批补建（WordRepository::backfillStructuredFields），补建后从本表删除。
+-- ============================================
+
+CREATE TABLE IF NOT EXISTS structured_backfill (
+    word_id INTEGER PRIMARY KEY             -- 待解析 word_details 的 words.id
+);
+
+-- 三张子表都没有行的单词（之后导入的单词子表为空时也会列入，重新解析结果不变）
+INSERT OR IGNORE INTO structured_backfill (word_id)
+    SELECT d.word_id FROM word_details d
+    WHERE NOT EXISTS (SELECT 1 FROM word_translations t WHERE t.word_id = d.word_id)
+      AND NOT EXISTS (SELECT 1 FROM word_sentences s WHERE s.word_id = d.word_id)
+      AND NOT EXISTS (SELECT 1 FROM word_phrases p WHERE p.word_id = d.word_id);
@@ -1,4 +1,5 @@
 #include "book_service.h"
+#include "import_pipeline.h"
 #include <QFile>
 #include <QFileInfo>
 #include <QDir>
@@ -18,7 +19,7 @@ BookService::BookService(Domain::IBookRepository& bookRepo,
 }
 
 BookService::ImportResult BookService::importBooksFromMeta(
-    const QString& metaJsonPath) 
+    const QString& metaJsonPath, bool bulkLoad, bool compressDetails) 
 {
     ImportResult result;
     
@@ -34,7 +35,7 @@ BookService::ImportResult BookService::importBooksFromMeta(
     QFileInfo metaFileInfo(metaJsonPath);
     QDir metaDir = metaFileInfo.dir();
     
-    // 遍历每个词库
+    QList<ImportPipeline::Source> sources;
     for (const Domain::Book& book : books) {
         // 检查词库是否已存在
         if (bookRepo_.exists(book.id)) {
@@ -42,31 +43,97 @@ BookService::ImportResult BookService::importBooksFromMeta(
             continue;
         }
         
-        // 保存词库元数据
-        if (!bookRepo_.save(book)) {
-            qWarning() << "Failed to save book:" << book.name;
-            continue;
-        }
-        
-        result.importedBooks++;
-        
-        // 导入单词数据
-        QString bookJsonPath = metaDir.filePath(book.url);
-        int importedWords = 0;
-        
-        if (importWordsFromJson(book.id, bookJsonPath, importedWords)) {
-            result.importedWords += importedWords;
-            qDebug() << "Imported" << importedWords << "words for book:" << book.name;
-        } else {
-            qWarning() << "Failed to import words for book:" << book.name;
+        ImportPipeline::Source source;
+        source.book = book;
+        source.jsonPath = metaDir.filePath(book.url);
+        sources.append(source);
+    }
+    
+    ImportPipeline::Options options;
+    options.bulkLoad = bulkLoad;
+    options.compressDetails = compressDetails;
+    
+    ImportPipeline pipeline(bookRepo_, wordRepo_, options);
+    ImportPipeline::Result imported = pipeline.run(sources);
+    
+    if (!imported.success) {
+        result.success = false;
+        result.message = "导入失败，数据库已回滚";
+        return result;
+    }
+    
+    for (const ImportPipeline::BookResult& book : imported.books) {
+        if (book.success) {
+            qDebug() << "Imported" << book.importedWords << "words for book:" << book.bookId;
         }
     }
     
+    result.importedBooks = imported.importedBooks;
+    result.importedWords = imported.importedWords;
     result.success = true;
     result.message = QString("成功导入 %1 个词库，共 %2 个单词")
         .arg(result.importedBooks)
         .arg(result.importedWords);
     
+    qDebug() << "Import finished in" << imported.elapsedMs << "ms";
+    return result;
+}
+
+ImportJob* BookService::createImportJob(const QString& metaJsonPath, QObject* parent)
+{
+    QDir metaDir = QFileInfo(metaJsonPath).dir();
+    
+    QList<ImportPipeline::Source> sources;
+    for (const Domain::Book& book : parseBookMetaJson(metaJsonPath)) {
+        if (bookRepo_.exists(book.id)) {
+            qDebug() << "Book already exists:" << book.id;
+            continue;
+        }
+        
+        ImportPipeline::Source source;
+        source.book = book;
+        source.jsonPath = metaDir.filePath(book.url);
+        sources.append(source);
+    }
+    
+    if (sources.isEmpty()) {
+        return nullptr;
+    }
+    
+    return new ImportJob(sources, bookRepo_, wordRepo_, parent);
+}
+
+BookService::ImportResult BookService::updateBooksFromMeta(
+    const QString& metaJsonPath)
+{
+    // 导入前已存在的词库做增量更新，其余的走完整导入
+    QList<Domain::Book> existing;
+    for (const Domain::Book& book : parseBookMetaJson(metaJsonPath)) {
+        if (bookRepo_.exists(book.id)) {
+            existing.append(book);
+        }
+    }
+    
+    ImportResult result = importBooksFromMeta(metaJsonPath);
+    if (!result.success) {
+        return result;
+    }
+    
+    QDir metaDir = QFileInfo(metaJsonPath).dir();
+    DeltaImporter importer(bookRepo_, wordRepo_);
+    int updatedBooks = 0;
+    
+    for (const Domain::Book& book : existing) {
+        DeltaImporter::Summary summary = importer.apply(book, metaDir.filePath(book.url));
+        if (summary.success) {
+            ++updatedBooks;
+        }
+        result.updates.append(summary);
+    }
+    
+    result.message += QString("；增量更新 %1/%2 个词库")
+        .arg(updatedBooks)
+        .arg(existing.size());
     return result;
 }
 
@@ -142,30 +209,6 @@ QList<BookService::BookStatistics> BookService::getAllBooksStatistics() {
     return statsList;
 }
 
-bool BookService::importWordsFromJson(const QString& bookId,
-                                       const QString& jsonPath,
-                                       int& importedCount) 
-{
-    importedCount = 0;
-    
-    // 解析单词JSON
-    QList<Domain::Word> words = parseWordsJson(bookId, jsonPath);
-    
-    if (words.isEmpty()) {
-        qWarning() << "No words found in:" << jsonPath;
-        return false;
-    }
-    
-    // 批量保存
-    if (!wordRepo_.saveBatch(words)) {
-        qWarning() << "Failed to save words batch";
-        return false;
-    }
-    
-    importedCount = words.size();
-    return true;
-}
-
 QList<Domain::Book> BookService::parseBookMetaJson(const QString& jsonPath) {
     QList<Domain::Book> books;
     
@@ -219,80 +262,5 @@ QList<Domain::Book> BookService::parseBookMetaJson(const QString& jsonPath) {
     return books;
 }
 
-QList<Domain::Word> BookService::parseWordsJson(const QString& bookId,
-                                                 const QString& jsonPath) 
-{
-    QList<Domain::Word> words;
-    
-    QFile file(jsonPath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qWarning() << "Failed to open file:" << jsonPath;
-        return words;
-    }
-    
-    QByteArray jsonData = file.readAll();
-    file.close();
-    
-    QJsonDocument doc = QJsonDocument::fromJson(jsonData);
-    if (!doc.isArray()) {
-        qWarning() << "Invalid JSON format: expected array";
-        return words;
-    }
-    
-    QJsonArray wordsArray = doc.array();
-    
-    for (const QJsonValue& value : wordsArray) {
-        if (!value.isObject()) {
-            continue;
-        }
-        
-        QJsonObject obj = value.toObject();
-        
-        Domain::Word word;
-        word.bookId = bookId;
-        word.wordId = obj["id"].toInt();
-        word.word = obj["word"].toString();
-        word.phoneticUk = obj["phonetic0"].toString();
-        word.phoneticUs = obj["phonetic1"].toString();
-        
-        // 序列化复杂字段为JSON字符串
-        if (obj.contains("trans")) {
-            word.translations = QJsonDocument(obj["trans"].toArray())
-                .toJson(QJsonDocument::Compact);
-        }
-        
-        if (obj.contains("sentences")) {
-            word.sentences = QJsonDocument(obj["sentences"].toArray())
-                .toJson(QJsonDocument::Compact);
-        }
-        
-        if (obj.contains("phrases")) {
-            word.phrases = QJsonDocument(obj["phrases"].toArray())
-                .toJson(QJsonDocument::Compact);
-        }
-        
-        if (obj.contains("synos")) {
-            word.synonyms = QJsonDocument(obj["synos"].toArray())
-                .toJson(QJsonDocument::Compact);
-        }
-        
-        if (obj.contains("relWords")) {
-            word.relatedWords = QJsonDocument(obj["relWords"].toObject())
-                .toJson(QJsonDocument::Compact);
-        }
-        
-        if (obj.contains("etymology")) {
-            word.etymology = QJsonDocument(obj["etymology"].toArray())
-                .toJson(QJsonDocument::Compact);
-        }
-        
-        if (word.isValid()) {
-            words.append(word);
-        }
-    }
-    
-    return words;
-}
-
 } // namespace Application
 } // namespace WordMaster
\ No newline at end of file
@@ -3,6 +3,8 @@
 
 #include "domain/repositories.h"
 #include "domain/entities.h"
+#include "delta_importer.h"
+#include "import_job.h"
 #include <QString>
 #include <QList>
 
@@ -27,6 +29,7 @@ public:
         QString message;
         int importedBooks;
         int importedWords;
+        QList<DeltaImporter::Summary> updates;  // 增量更新的词库（updateBooksFromMeta）
         
         ImportResult() : success(false), importedBooks(0), importedWords(0) {}
     };
@@ -51,8 +54,24 @@ public:
     
     ~BookService() = default;
     
-    // 词库导入
-    ImportResult importBooksFromMeta(const QString& metaJsonPath);
+    // 词库导入（多个词库由 ImportPipeline 并行读取、解析，单线程写入）
+    // bulkLoad：导入期间暂停单词索引维护，结束时一次性重建（适合向空库或小库导入大量词库）
+    // compressDetails：导入后按词库训练字典压缩 JSON 字段（需 zstd 构建）
+    ImportResult importBooksFromMeta(const QString& metaJsonPath, bool bulkLoad = false,
+                                     bool compressDetails = false);
+    
+    // 导入新词库，已导入的词库按内容哈希增量更新（保留单词 id 与学习进度）
+    ImportResult updateBooksFromMeta(const QString& metaJsonPath);
+    
+    /**
+     * @brief 创建后台导入任务（未启动）
+     * 
+     * 元数据在调用线程解析，已存在的词库被跳过；
+     * 单词的读取和解析在任务的工作线程上进行，写入经本服务的仓储
+     * 在调用线程（写连接所属线程）的事件循环中逐批执行。
+     * @return 元数据中没有可导入的词库时返回 nullptr
+     */
+    ImportJob* createImportJob(const QString& metaJsonPath, QObject* parent = nullptr);
     
     // 词库查询
     QList<Domain::Book> getAllBooks();
@@ -72,17 +91,8 @@ private:
     Domain::IBookRepository& bookRepo_;
     Domain::IWordRepository& wordRepo_;
     
-    // 导入单个词库的单词数据
-    bool importWordsFromJson(const QString& bookId, 
-                            const QString& jsonPath,
-                            int& importedCount);
-    
     // 解析词库元数据JSON
     QList<Domain::Book> parseBookMetaJson(const QString& jsonPath);
-    
-    // 解析单词JSON
-    QList<Domain::Word> parseWordsJson(const QString& bookId, 
-                                       const QString& jsonPath);
 };
 
 } // namespace Application
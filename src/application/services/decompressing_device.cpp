@@ -0,0 +1,355 @@
+#include "decompressing_device.h"
+#include <QFile>
+#include <QByteArray>
+#include <QDebug>
+
+#ifdef WORDMASTER_GZIP
+#include <zlib.h>
+#endif
+
+#ifdef WORDMASTER_ZSTD
+#include <zstd.h>
+#endif
+
+namespace WordMaster {
+namespace Application {
+
+namespace {
+
+// 每次从源设备读取的压缩数据字节数
+const int kInputBufferSize = 64 * 1024;
+
+} // namespace
+
+/**
+ * @brief 解码器：把源设备的压缩数据解压到调用方缓冲区
+ */
+class DecompressingDevice::Decoder {
+public:
+    Decoder()
+        : input_(kInputBufferSize, Qt::Uninitialized)
+        , done_(false)
+    {
+    }
+
+    virtual ~Decoder() = default;
+
+    /**
+     * @return 解压出的字节数；0 表示数据已结束，-1 表示出错（见 error()）
+     */
+    virtual qint64 decode(QIODevice& source, char* out, qint64 maxSize) = 0;
+
+    bool isDone() const { return done_; }
+    QString error() const { return error_; }
+
+protected:
+    // 从源设备读取下一块压缩数据；源设备已读完返回0
+    qint64 fill(QIODevice& source) {
+        qint64 read = source.read(input_.data(), input_.size());
+        return read > 0 ? read : 0;
+    }
+
+    qint64 fail(const QString& message) {
+        error_ = message;
+        return -1;
+    }
+
+    QByteArray input_;
+    bool done_;
+    QString error_;
+};
+
+#ifdef WORDMASTER_GZIP
+class DecompressingDevice::GzipDecoder : public Decoder {
+public:
+    GzipDecoder()
+        : initialized_(false)
+        , memberEnded_(false)
+    {
+        stream_.zalloc = Z_NULL;
+        stream_.zfree = Z_NULL;
+        stream_.opaque = Z_NULL;
+        stream_.next_in = Z_NULL;
+        stream_.avail_in = 0;
+
+        // 15 + 32：自动识别 gzip 与 zlib 头
+        initialized_ = inflateInit2(&stream_, 15 + 32) == Z_OK;
+    }
+
+    ~GzipDecoder() override {
+        if (initialized_) {
+            inflateEnd(&stream_);
+        }
+    }
+
+    qint64 decode(QIODevice& source, char* out, qint64 maxSize) override {
+        if (!initialized_) {
+            return fail("Failed to initialize zlib");
+        }
+
+        stream_.next_out = reinterpret_cast<Bytef*>(out);
+        stream_.avail_out = static_cast<uInt>(qMin<qint64>(maxSize, 1 << 30));
+        const uInt capacity = stream_.avail_out;
+
+        while (stream_.avail_out > 0 && !done_) {
+            if (stream_.avail_in == 0) {
+                qint64 read = fill(source);
+                if (read == 0) {
+                    if (!memberEnded_) {
+                        return fail("Unexpected end of gzip data");
+                    }
+                    done_ = true;
+                    break;
+                }
+                stream_.next_in = reinterpret_cast<Bytef*>(input_.data());
+                stream_.avail_in = static_cast<uInt>(read);
+            }
+
+            // 一个 gzip 成员结束后还有数据：连接的多个成员（如 cat a.gz b.gz）
+            if (memberEnded_) {
+                inflateReset(&stream_);
+                memberEnded_ = false;
+            }
+
+            int ret = inflate(&stream_, Z_NO_FLUSH);
+            if (ret == Z_STREAM_END) {
+                memberEnded_ = true;
+            } else if (ret != Z_OK && ret != Z_BUF_ERROR) {
+                return fail(QString("Corrupt gzip data: %1")
+                    .arg(stream_.msg ? stream_.msg : "unknown error"));
+            }
+        }
+
+        return capacity - stream_.avail_out;
+    }
+
+private:
+    z_stream stream_;
+    bool initialized_;
+    bool memberEnded_;
+};
+#endif
+
+#ifdef WORDMASTER_ZSTD
+class DecompressingDevice::ZstdDecoder : public Decoder {
+public:
+    ZstdDecoder()
+        : stream_(ZSTD_createDStream())
+        , lastResult_(1)
+    {
+        if (stream_) {
+            ZSTD_initDStream(stream_);
+        }
+        in_.src = input_.constData();
+        in_.size = 0;
+        in_.pos = 0;
+    }
+
+    ~ZstdDecoder() override {
+        ZSTD_freeDStream(stream_);
+    }
+
+    qint64 decode(QIODevice& source, char* out, qint64 maxSize) override {
+        if (!stream_) {
+            return fail("Failed to initialize zstd");
+        }
+
+        ZSTD_outBuffer output = { out, static_cast<size_t>(maxSize), 0 };
+
+        while (output.pos < output.size && !done_) {
+            if (in_.pos == in_.size) {
+                qint64 read = fill(source);
+                in_.size = static_cast<size_t>(read);
+                in_.pos = 0;
+
+                if (read == 0) {
+                    // 上一次调用已完整解出一帧并全部输出
+                    if (lastResult_ == 0) {
+                        done_ = true;
+                        break;
+                    }
+
+                    // 输出缓冲区满时解码器内可能还有数据，先冲刷
+                    size_t before = output.pos;
+                    size_t ret = ZSTD_decompressStream(stream_, &output, &in_);
+                    if (ZSTD_isError(ret)) {
+                        return fail(QString("Corrupt zstd data: %1").arg(ZSTD_getErrorName(ret)));
+                    }
+                    lastResult_ = ret;
+                    if (output.pos == before && ret != 0) {
+                        return fail("Unexpected end of zstd data");
+                    }
+                    continue;
+                }
+            }
+
+            size_t ret = ZSTD_decompressStream(stream_, &output, &in_);
+            if (ZSTD_isError(ret)) {
+                return fail(QString("Corrupt zstd data: %1").arg(ZSTD_getErrorName(ret)));
+            }
+            lastResult_ = ret;
+        }
+
+        return static_cast<qint64>(output.pos);
+    }
+
+private:
+    ZSTD_DStream* stream_;
+    ZSTD_inBuffer in_;
+    size_t lastResult_;     // 0 表示在帧边界上
+};
+#endif
+
+DecompressingDevice::Compression DecompressingDevice::compressionForPath(const QString& path) {
+    if (path.endsWith(".gz", Qt::CaseInsensitive)) {
+        return Compression::Gzip;
+    }
+    if (path.endsWith(".zst", Qt::CaseInsensitive)) {
+        return Compression::Zstd;
+    }
+    return Compression::None;
+}
+
+bool DecompressingDevice::isSupported(Compression compression) {
+    switch (compression) {
+    case Compression::None:
+        return true;
+    case Compression::Gzip:
+#ifdef WORDMASTER_GZIP
+        return true;
+#else
+        return false;
+#endif
+    case Compression::Zstd:
+#ifdef WORDMASTER_ZSTD
+        return true;
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+std::unique_ptr<QIODevice> DecompressingDevice::openFile(const QString& path, QString* error) {
+    Compression compression = compressionForPath(path);
+    if (!isSupported(compression)) {
+        if (error) {
+            *error = QString("Compressed word book not supported by this build: %1").arg(path);
+        }
+        return nullptr;
+    }
+
+    std::unique_ptr<QFile> file(new QFile(path));
+    if (!file->open(QIODevice::ReadOnly)) {
+        if (error) {
+            *error = QString("Failed to open file: %1").arg(path);
+        }
+        return nullptr;
+    }
+
+    if (compression == Compression::None) {
+        return std::move(file);
+    }
+
+    // 文件作为子对象随解压设备一起释放
+    std::unique_ptr<DecompressingDevice> device(
+        new DecompressingDevice(file.get(), compression));
+    file.release()->setParent(device.get());
+    device->open(QIODevice::ReadOnly);
+    return std::move(device);
+}
+
+DecompressingDevice::DecompressingDevice(QIODevice* source, Compression compression,
+                                         QObject* parent)
+    : QIODevice(parent)
+    , source_(source)
+    , compression_(compression)
+    , failed_(false)
+{
+}
+
+DecompressingDevice::~DecompressingDevice() = default;
+
+bool DecompressingDevice::open(OpenMode mode) {
+    if (mode != QIODevice::ReadOnly) {
+        qWarning() << "DecompressingDevice only supports ReadOnly";
+        return false;
+    }
+
+    decoder_.reset();
+    failed_ = false;
+
+    switch (compression_) {
+#ifdef WORDMASTER_GZIP
+    case Compression::Gzip:
+        decoder_.reset(new GzipDecoder());
+        break;
+#endif
+#ifdef WORDMASTER_ZSTD
+    case Compression::Zstd:
+        decoder_.reset(new ZstdDecoder());
+        break;
+#endif
+    default:
+        break;
+    }
+
+    if (!decoder_ && compression_ != Compression::None) {
+        setErrorString("Unsupported compression format");
+        failed_ = true;
+    }
+
+    return QIODevice::open(mode);
+}
+
+void DecompressingDevice::close() {
+    decoder_.reset();
+    QIODevice::close();
+}
+
+bool DecompressingDevice::isSequential() const {
+    return true;
+}
+
+bool DecompressingDevice::atEnd() const {
+    if (!isOpen()) {
+        return true;
+    }
+    bool drained = failed_ || (decoder_ ? decoder_->isDone() : source_->atEnd());
+    return drained && QIODevice::bytesAvailable() == 0;
+}
+
+bool DecompressingDevice::hasError() const {
+    return failed_;
+}
+
+qint64 DecompressingDevice::readData(char* data, qint64 maxSize) {
+    if (failed_) {
+        return -1;
+    }
+
+    // 未压缩：直接透传
+    if (!decoder_) {
+        qint64 read = source_->read(data, maxSize);
+        return read > 0 ? read : -1;
+    }
+
+    qint64 decoded = decoder_->decode(*source_, data, maxSize);
+    if (decoded < 0) {
+        setErrorString(decoder_->error());
+        failed_ = true;
+        return -1;
+    }
+
+    // 顺序设备没有更多数据时返回 -1
+    return decoded > 0 ? decoded : -1;
+}
+
+qint64 DecompressingDevice::writeData(const char* data, qint64 maxSize) {
+    Q_UNUSED(data);
+    Q_UNUSED(maxSize);
+    return -1;
+}
+
+} // namespace Application
+} // namespace WordMaster
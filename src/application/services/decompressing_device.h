@@ -0,0 +1,87 @@
+#ifndef WORDMASTER_APPLICATION_DECOMPRESSING_DEVICE_H
+#define WORDMASTER_APPLICATION_DECOMPRESSING_DEVICE_H
+
+#include <QIODevice>
+#include <QString>
+#include <memory>
+
+namespace WordMaster {
+namespace Application {
+
+/**
+ * @brief 流式解压设备（只读、顺序）
+ *
+ * 包装一个已打开的源设备，读取时按块解压，不生成临时文件，
+ * 内存占用只有输入缓冲区和调用方的读缓冲区。
+ *
+ * - gzip（.gz）：需以 WORDMASTER_GZIP 构建（找到 zlib 时自动开启）
+ * - zstd（.zst）：需以 WORDMASTER_ZSTD 构建
+ *
+ * 压缩数据损坏或被截断时 read() 返回 -1，hasError() 为 true。
+ */
+class DecompressingDevice : public QIODevice {
+    Q_OBJECT
+
+public:
+    enum class Compression {
+        None,
+        Gzip,
+        Zstd
+    };
+
+    /**
+     * @brief 按扩展名判断压缩格式（book.json.gz / book.json.zst）
+     */
+    static Compression compressionForPath(const QString& path);
+
+    /**
+     * @brief 当前构建是否支持该格式
+     */
+    static bool isSupported(Compression compression);
+
+    /**
+     * @brief 打开词库文件，压缩文件返回解压设备（拥有底层 QFile）
+     * @return 失败时返回空指针并设置 error
+     */
+    static std::unique_ptr<QIODevice> openFile(const QString& path, QString* error = nullptr);
+
+    /**
+     * @param source 已打开的源设备（不转移所有权）
+     */
+    DecompressingDevice(QIODevice* source, Compression compression,
+                        QObject* parent = nullptr);
+    ~DecompressingDevice() override;
+
+    /**
+     * @brief 只支持 ReadOnly
+     */
+    bool open(OpenMode mode) override;
+    void close() override;
+
+    bool isSequential() const override;
+    bool atEnd() const override;
+
+    /**
+     * @brief 压缩数据是否有错误（截断、损坏或格式不受支持）
+     */
+    bool hasError() const;
+
+protected:
+    qint64 readData(char* data, qint64 maxSize) override;
+    qint64 writeData(const char* data, qint64 maxSize) override;
+
+private:
+    class Decoder;
+    class GzipDecoder;
+    class ZstdDecoder;
+
+    QIODevice* source_;
+    Compression compression_;
+    std::unique_ptr<Decoder> decoder_;
+    bool failed_;
+};
+
+} // namespace Application
+} // namespace WordMaster
+
+#endif // WORDMASTER_APPLICATION_DECOMPRESSING_DEVICE_H
@@ -0,0 +1,149 @@
+#include "delta_importer.h"
+#include "word_book_reader.h"
+#include "word_pack.h"
+#include <QHash>
+#include <QMap>
+#include <QSet>
+#include <QElapsedTimer>
+#include <QDebug>
+
+namespace WordMaster {
+namespace Application {
+
+DeltaImporter::DeltaImporter(Domain::IBookRepository& bookRepo,
+                             Domain::IWordRepository& wordRepo)
+    : bookRepo_(bookRepo)
+    , wordRepo_(wordRepo)
+{
+}
+
+DeltaImporter::Summary DeltaImporter::apply(const Domain::Book& book,
+                                            const QString& jsonPath) {
+    Summary summary;
+    summary.bookId = book.id;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // 数据库中的单词，按 word_id 索引
+    QHash<int, Domain::WordFingerprint> stored;
+    for (const Domain::WordFingerprint& fingerprint : wordRepo_.getFingerprints(book.id)) {
+        stored.insert(fingerprint.wordId, fingerprint);
+    }
+
+    // 只保留新增或变化的单词；同一 word_id 重复出现时以后出现的为准
+    QMap<int, Domain::Word> changed;
+    QSet<int> seen;
+
+    if (WordPack::isPackPath(jsonPath)) {
+        // 词库包自带内容哈希，只解码有变化的记录
+        WordPack pack;
+        if (pack.open(jsonPath)) {
+            for (int i = 0; i < pack.count(); ++i) {
+                int wordId = pack.wordIdAt(i);
+                seen.insert(wordId);
+
+                auto it = stored.constFind(wordId);
+                if (it != stored.constEnd() && it->contentHash == pack.contentHashAt(i)) {
+                    continue;
+                }
+
+                Domain::Word updated = pack.wordAt(i, book.id);
+                updated.id = it != stored.constEnd() ? it->id : 0;
+                changed.insert(wordId, updated);
+            }
+        } else {
+            summary.error = pack.errorString();
+        }
+    } else {
+        WordBookReader reader(book.id);
+        bool ok = reader.readFile(jsonPath, [&](const Domain::Word& word) {
+            seen.insert(word.wordId);
+
+            auto it = stored.constFind(word.wordId);
+            if (it != stored.constEnd() && it->contentHash == word.contentHash()) {
+                changed.remove(word.wordId);
+                return true;
+            }
+
+            Domain::Word updated = word;
+            updated.id = it != stored.constEnd() ? it->id : 0;
+            changed.insert(word.wordId, updated);
+            return true;
+        });
+
+        if (!ok) {
+            summary.error = reader.errorString();
+        }
+    }
+
+    if (summary.error.isEmpty() && seen.isEmpty()) {
+        // 空文件不应删光整个词库
+        summary.error = "No words found";
+    }
+    if (!summary.error.isEmpty()) {
+        qWarning() << "Failed to read book" << book.id << ":" << summary.error;
+        summary.elapsedMs = timer.elapsed();
+        return summary;
+    }
+
+    QList<int> removedIds;
+    for (auto it = stored.constBegin(); it != stored.constEnd(); ++it) {
+        if (!seen.contains(it.key())) {
+            removedIds.append(it->id);
+        }
+    }
+
+    QList<Domain::Word> inserts;
+    QList<Domain::Word> updates;
+    for (const Domain::Word& word : changed) {
+        (word.id > 0 ? updates : inserts).append(word);
+    }
+
+    if (!wordRepo_.beginTransaction()) {
+        summary.error = "Failed to begin transaction";
+        return summary;
+    }
+
+    // 元数据原地更新：save() 是 INSERT OR REPLACE，会级联删除全部单词
+    bool written = bookRepo_.update(book);
+    if (!written) {
+        summary.error = "Book not found";
+    }
+
+    // 先删除，再更新和插入，word_id 不会冲突
+    for (int i = 0; written && i < removedIds.size(); ++i) {
+        written = wordRepo_.remove(removedIds[i]);
+    }
+    for (int i = 0; written && i < updates.size(); ++i) {
+        written = wordRepo_.update(updates[i]);
+    }
+    if (written) {
+        written = wordRepo_.saveBatch(inserts);
+    }
+
+    if (!written || !wordRepo_.commit()) {
+        wordRepo_.rollback();
+        if (summary.error.isEmpty()) {
+            summary.error = "Failed to write changes";
+        }
+        qWarning() << "Delta import failed for book" << book.id << ":" << summary.error;
+        summary.elapsedMs = timer.elapsed();
+        return summary;
+    }
+
+    summary.success = true;
+    summary.inserted = inserts.size();
+    summary.updated = updates.size();
+    summary.deleted = removedIds.size();
+    summary.unchanged = seen.size() - changed.size();
+    summary.elapsedMs = timer.elapsed();
+
+    qDebug() << "Delta import" << book.id << ": +" << summary.inserted
+             << "~" << summary.updated << "-" << summary.deleted
+             << "=" << summary.unchanged;
+    return summary;
+}
+
+} // namespace Application
+} // namespace WordMaster
@@ -0,0 +1,62 @@
+#ifndef WORDMASTER_APPLICATION_DELTA_IMPORTER_H
+#define WORDMASTER_APPLICATION_DELTA_IMPORTER_H
+
+#include "domain/repositories.h"
+#include "domain/entities.h"
+#include <QString>
+
+namespace WordMaster {
+namespace Application {
+
+/**
+ * @brief 已导入词库的增量更新
+ *
+ * 按 word_id 对比词库文件与数据库中的单词（内容哈希见 Word::contentHash()）：
+ * - 新增的单词插入
+ * - 内容变化的单词按 id 原地 UPDATE，id 不变，学习记录、复习计划、标签保留
+ * - 文件中已不存在的单词删除（其学习数据随之级联删除）
+ * - 未变化的单词不写库
+ *
+ * 词库文件流式读取，内存中只保留变化的单词。
+ * 全部修改在一个事务中完成，文件读取失败时不做任何修改。
+ */
+class DeltaImporter {
+public:
+    /**
+     * @brief 变更摘要
+     */
+    struct Summary {
+        QString bookId;
+        bool success;
+        int inserted;
+        int updated;
+        int deleted;
+        int unchanged;
+        qint64 elapsedMs;
+        QString error;
+
+        Summary() : success(false), inserted(0), updated(0), deleted(0),
+                    unchanged(0), elapsedMs(0) {}
+
+        bool hasChanges() const { return inserted + updated + deleted > 0; }
+    };
+
+    DeltaImporter(Domain::IBookRepository& bookRepo,
+                  Domain::IWordRepository& wordRepo);
+
+    /**
+     * @brief 用词库文件更新已导入的词库
+     * @param book 词库元数据（原地更新，不改变激活状态）
+     * @param jsonPath 单词 JSON 文件或词库包（.wmpack）
+     */
+    Summary apply(const Domain::Book& book, const QString& jsonPath);
+
+private:
+    Domain::IBookRepository& bookRepo_;
+    Domain::IWordRepository& wordRepo_;
+};
+
+} // namespace Application
+} // namespace WordMaster
+
+#endif // WORDMASTER_APPLICATION_DELTA_IMPORTER_H
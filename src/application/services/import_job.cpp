@@ -0,0 +1,182 @@
+#include "import_job.h"
+#include <QThread>
+#include <QMutexLocker>
+#include <QMetaObject>
+#include <QDebug>
+
+namespace WordMaster {
+namespace Application {
+
+class ImportJob::Thread : public QThread {
+public:
+    explicit Thread(ImportJob& job)
+        : job_(job)
+    {
+    }
+
+protected:
+    void run() override {
+        job_.run();
+    }
+
+private:
+    ImportJob& job_;
+};
+
+ImportJob::ImportJob(const QList<ImportPipeline::Source>& sources,
+                     Domain::IBookRepository& bookRepo,
+                     Domain::IWordRepository& wordRepo,
+                     QObject* parent,
+                     const ImportPipeline::Options& options)
+    : QObject(parent)
+    , sources_(sources)
+    , bookRepo_(bookRepo)
+    , wordRepo_(wordRepo)
+    , options_(options)
+    , writePending_(false)
+    , writeFinished_(false)
+    , writeResult_(false)
+{
+    // 写连接同时服务界面，事务不能跨越两次排队的写入
+    options_.commitEachBatch = true;
+}
+
+ImportJob::~ImportJob() {
+    if (thread_) {
+        cancel();
+        // 工作线程可能正等待本线程执行写入（包括取消后的清理），不能直接 wait()
+        while (!thread_->wait(10)) {
+            runPendingWrite();
+        }
+    }
+}
+
+void ImportJob::start() {
+    if (thread_) {
+        qWarning() << "Import job already started";
+        return;
+    }
+
+    thread_.reset(new Thread(*this));
+    thread_->start();
+}
+
+void ImportJob::cancel() {
+    cancelled_.storeRelease(1);
+}
+
+bool ImportJob::isRunning() const {
+    return thread_ && thread_->isRunning();
+}
+
+bool ImportJob::isCancelled() const {
+    return cancelled_.loadAcquire() != 0;
+}
+
+int ImportJob::bookCount() const {
+    return sources_.size();
+}
+
+bool ImportJob::write(const std::function<bool()>& work) {
+    QMutexLocker locker(&writeMutex_);
+    pendingWrite_ = work;
+    writePending_ = true;
+    writeFinished_ = false;
+    QMetaObject::invokeMethod(this, "runPendingWrite", Qt::QueuedConnection);
+    while (!writeFinished_) {
+        writeDone_.wait(&writeMutex_);
+    }
+    pendingWrite_ = nullptr;
+    return writeResult_;
+}
+
+void ImportJob::runPendingWrite() {
+    std::function<bool()> work;
+    {
+        // 析构函数代为执行后，排队的调用到达时已没有待执行的写入
+        QMutexLocker locker(&writeMutex_);
+        if (!writePending_) {
+            return;
+        }
+        writePending_ = false;
+        work = pendingWrite_;
+    }
+
+    bool ok = work();
+
+    QMutexLocker locker(&writeMutex_);
+    writeResult_ = ok;
+    writeFinished_ = true;
+    writeDone_.wakeAll();
+}
+
+void ImportJob::run() {
+    int importedBooks = 0;
+    int importedWords = 0;
+    int failedBooks = 0;
+    bool writeFailed = false;
+
+    for (int i = 0; i < sources_.size() && !isCancelled(); ++i) {
+        const ImportPipeline::Source& source = sources_[i];
+        const int expected = source.book.wordCount;
+        emit bookStarted(source.book.id, source.book.name, i, sources_.size());
+
+        // 每个词库单独一条流水线：取消或出错时只删除当前词库
+        ImportPipeline pipeline(bookRepo_, wordRepo_, options_);
+        pipeline.setWriteExecutor([this](const std::function<bool()>& work) {
+            return write(work);
+        });
+        pipeline.setProgressHandler([&](const ImportPipeline::Progress& current) {
+            double rate = current.elapsedMs > 0
+                ? current.bookWords * 1000.0 / current.elapsedMs : 0.0;
+            qint64 eta = -1;
+            if (expected > 0 && rate > 0) {
+                eta = static_cast<qint64>(qMax(0, expected - current.bookWords) * 1000.0 / rate);
+            }
+            emit progress(source.book.id, current.bookWords, expected, rate, eta);
+            return !isCancelled();
+        });
+
+        ImportPipeline::Result result = pipeline.run(QList<ImportPipeline::Source>() << source);
+
+        if (result.cancelled) {
+            emit bookFinished(source.book.id, false, 0, "已取消");
+            break;
+        }
+        if (!result.success) {
+            writeFailed = true;
+            emit bookFinished(source.book.id, false, 0, "数据库写入失败");
+            break;
+        }
+
+        const ImportPipeline::BookResult& book = result.books.first();
+        if (book.success) {
+            ++importedBooks;
+            importedWords += book.importedWords;
+        } else {
+            ++failedBooks;
+        }
+        emit bookFinished(book.bookId, book.success, book.importedWords, book.error);
+    }
+
+    QString message;
+    if (isCancelled()) {
+        message = QString("已取消：已导入 %1 个词库，共 %2 个单词，当前词库已删除")
+            .arg(importedBooks)
+            .arg(importedWords);
+    } else if (writeFailed) {
+        message = QString("导入失败，当前词库已删除（已导入 %1 个词库）").arg(importedBooks);
+    } else {
+        message = QString("成功导入 %1 个词库，共 %2 个单词")
+            .arg(importedBooks)
+            .arg(importedWords);
+        if (failedBooks > 0) {
+            message += QString("，%1 个词库失败").arg(failedBooks);
+        }
+    }
+
+    emit finished(!writeFailed && !isCancelled(), isCancelled(), message);
+}
+
+} // namespace Application
+} // namespace WordMaster
@@ -0,0 +1,123 @@
+#ifndef WORDMASTER_APPLICATION_IMPORT_JOB_H
+#define WORDMASTER_APPLICATION_IMPORT_JOB_H
+
+#include "import_pipeline.h"
+#include "domain/repositories.h"
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QAtomicInt>
+#include <QMutex>
+#include <QWaitCondition>
+#include <functional>
+#include <memory>
+
+namespace WordMaster {
+namespace Application {
+
+/**
+ * @brief 后台导入任务
+ *
+ * 在工作线程上逐个导入词库（每个词库一个 ImportPipeline），工作线程只读文件和解析，
+ * 写入通过任务对象所在线程（持有唯一写连接的界面线程）的事件循环逐批执行，
+ * 每批一个短事务，批次之间界面的写入照常进行，导入期间可以继续学习其他词库。
+ *
+ * - 每个词库开始/结束、每写完一批都发出信号（跨线程信号自动排队到接收者线程）
+ * - cancel() 后删除当前词库已写入的数据，已完成的词库保留
+ *
+ *     ImportJob* job = bookService->createImportJob(metaPath, this);
+ *     connect(job, &ImportJob::progress, ...);
+ *     connect(job, &ImportJob::finished, job, &QObject::deleteLater);
+ *     job->start();
+ */
+class ImportJob : public QObject {
+    Q_OBJECT
+
+public:
+    /**
+     * @param bookRepo, wordRepo 写连接上的仓储，只在任务对象所在线程上访问
+     * @param options 流水线参数（总是逐批提交）
+     */
+    ImportJob(const QList<ImportPipeline::Source>& sources,
+              Domain::IBookRepository& bookRepo,
+              Domain::IWordRepository& wordRepo,
+              QObject* parent = nullptr,
+              const ImportPipeline::Options& options = ImportPipeline::Options());
+
+    /**
+     * @brief 析构时取消并等待工作线程结束（期间代为执行排队的写入，以便删除当前词库）
+     */
+    ~ImportJob() override;
+
+    /**
+     * @brief 启动工作线程（只能调用一次）
+     */
+    void start();
+
+    /**
+     * @brief 请求取消（任意线程可调用），当前词库在下一批写入后删除
+     */
+    void cancel();
+
+    bool isRunning() const;
+    bool isCancelled() const;
+
+    /**
+     * @brief 待导入的词库数
+     */
+    int bookCount() const;
+
+signals:
+    void bookStarted(const QString& bookId, const QString& bookName, int index, int count);
+
+    /**
+     * @brief 当前词库的写入进度
+     * @param total 元数据中的单词数（0 表示未知）
+     * @param wordsPerSecond 当前词库的写入速度
+     * @param etaMs 当前词库预计剩余时间，-1 表示未知
+     */
+    void progress(const QString& bookId, int written, int total,
+                  double wordsPerSecond, qint64 etaMs);
+
+    void bookFinished(const QString& bookId, bool success, int importedWords,
+                      const QString& error);
+
+    /**
+     * @brief 全部结束（包括取消）
+     */
+    void finished(bool success, bool cancelled, const QString& message);
+
+private slots:
+    // 在任务对象所在线程上执行工作线程排队的写入
+    void runPendingWrite();
+
+private:
+    class Thread;
+
+    // 工作线程入口
+    void run();
+
+    // 工作线程调用：把写入交给任务对象所在线程执行，阻塞等待结果
+    bool write(const std::function<bool()>& work);
+
+    QList<ImportPipeline::Source> sources_;
+    Domain::IBookRepository& bookRepo_;
+    Domain::IWordRepository& wordRepo_;
+    ImportPipeline::Options options_;
+    std::unique_ptr<Thread> thread_;
+    QAtomicInt cancelled_;
+
+    // 工作线程与写连接线程之间一次只传递一个写入
+    QMutex writeMutex_;
+    QWaitCondition writeDone_;
+    std::function<bool()> pendingWrite_;
+    bool writePending_;
+    bool writeFinished_;
+    bool writeResult_;
+};
+
+} // namespace Application
+} // namespace WordMaster
+
+#endif // WORDMASTER_APPLICATION_IMPORT_JOB_H
@@ -0,0 +1,527 @@
+#include "import_pipeline.h"
+#include "word_book_reader.h"
+#include "decompressing_device.h"
+#include "word_pack.h"
+#include <QThread>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QWaitCondition>
+#include <QQueue>
+#include <QMap>
+#include <QVector>
+#include <QStringList>
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QDebug>
+#include <algorithm>
+
+namespace WordMaster {
+namespace Application {
+
+namespace {
+
+/**
+ * @brief 发给写入阶段的消息：一批单词，或某个词库已切分完毕
+ */
+struct Message {
+    enum class Kind { Batch, BookEnd };
+
+    Kind kind;
+    int book;                       // Source 下标
+    int seq;                        // Batch: 批次序号；BookEnd: 批次总数
+    QList<Domain::Word> words;
+    QString error;                  // BookEnd: 非空表示读取失败
+};
+
+/**
+ * @brief 各阶段共享的状态
+ */
+class Channel {
+public:
+    explicit Channel(int maxInFlight)
+        : slots_(maxInFlight)
+    {
+    }
+
+    void post(const Message& message) {
+        QMutexLocker locker(&mutex_);
+        messages_.enqueue(message);
+        available_.wakeOne();
+    }
+
+    Message take() {
+        QMutexLocker locker(&mutex_);
+        while (messages_.isEmpty()) {
+            available_.wait(&mutex_);
+        }
+        return messages_.dequeue();
+    }
+
+    // 切分阶段每产生一批先占一个名额，写入阶段处理完该批后归还
+    void acquireSlot() { slots_.acquire(); }
+    void releaseSlot() { slots_.release(); }
+
+    void abort() { aborted_.storeRelease(1); }
+    bool isAborted() const { return aborted_.loadAcquire() != 0; }
+
+private:
+    QMutex mutex_;
+    QWaitCondition available_;
+    QQueue<Message> messages_;
+    QSemaphore slots_;
+    QAtomicInt aborted_;
+};
+
+/**
+ * @brief 批内按原始ID排序，UNIQUE(book_id, word_id) 索引按键序追加
+ */
+void sortByWordId(QList<Domain::Word>& words) {
+    std::stable_sort(words.begin(), words.end(),
+                     [](const Domain::Word& a, const Domain::Word& b) {
+                         return a.wordId < b.wordId;
+                     });
+}
+
+/**
+ * @brief 解析阶段：把一批原始元素解析为 Word
+ */
+class ParseTask : public QRunnable {
+public:
+    ParseTask(Channel& channel, int book, const QString& bookId, int seq,
+              const QList<QByteArray>& items, bool validate, bool sorted)
+        : channel_(channel), book_(book), bookId_(bookId), seq_(seq), items_(items)
+        , validate_(validate), sorted_(sorted)
+    {
+    }
+
+    void run() override {
+        Message message;
+        message.kind = Message::Kind::Batch;
+        message.book = book_;
+        message.seq = seq_;
+        message.words.reserve(items_.size());
+
+        for (const QByteArray& item : items_) {
+            Domain::Word word;
+            if (WordBookReader::parseItem(bookId_, item, word, validate_)) {
+                message.words.append(word);
+            }
+        }
+
+        if (sorted_) {
+            sortByWordId(message.words);
+        }
+        channel_.post(message);
+    }
+
+private:
+    Channel& channel_;
+    int book_;
+    QString bookId_;
+    int seq_;
+    QList<QByteArray> items_;
+    bool validate_;
+    bool sorted_;
+};
+
+/**
+ * @brief 切分阶段：读取一个词库文件，按批分发给解析线程池
+ */
+class SplitTask : public QRunnable {
+public:
+    SplitTask(Channel& channel, QThreadPool& parsePool, int book,
+              const ImportPipeline::Source& source, int batchSize, bool validate,
+              bool sorted)
+        : channel_(channel), parsePool_(parsePool), book_(book)
+        , source_(source), batchSize_(batchSize), validate_(validate), sorted_(sorted)
+    {
+    }
+
+    void run() override {
+        int batches = 0;
+        QString error;
+
+        if (WordPack::isPackPath(source_.jsonPath)) {
+            splitPack(batches, error);
+        } else {
+            splitJson(batches, error);
+        }
+
+        Message end;
+        end.kind = Message::Kind::BookEnd;
+        end.book = book_;
+        end.seq = batches;
+        end.error = error;
+        channel_.post(end);
+    }
+
+private:
+    void splitJson(int& batches, QString& error) {
+        std::unique_ptr<QIODevice> file = DecompressingDevice::openFile(source_.jsonPath, &error);
+        if (!file) {
+            return;
+        }
+
+        QList<QByteArray> items;
+        WordBookReader reader(source_.book.id);
+
+        auto dispatch = [&]() {
+            channel_.acquireSlot();
+            parsePool_.start(new ParseTask(channel_, book_, source_.book.id,
+                                           batches++, items, validate_, sorted_));
+            items.clear();
+        };
+
+        bool ok = reader.readItems(*file, [&](const QByteArray& item) {
+            if (channel_.isAborted()) {
+                return false;
+            }
+            items.append(item);
+            if (items.size() >= batchSize_) {
+                dispatch();
+            }
+            return true;
+        });
+
+        if (ok && !items.isEmpty()) {
+            dispatch();
+        }
+        if (!ok) {
+            error = reader.errorString();
+        }
+    }
+
+    // 词库包已是定长记录，不经过解析线程池，直接按批发给写入阶段
+    void splitPack(int& batches, QString& error) {
+        WordPack pack;
+        if (!pack.open(source_.jsonPath)) {
+            error = pack.errorString();
+            return;
+        }
+
+        for (int begin = 0; begin < pack.count() && !channel_.isAborted(); begin += batchSize_) {
+            int end = qMin(pack.count(), begin + batchSize_);
+
+            Message message;
+            message.kind = Message::Kind::Batch;
+            message.book = book_;
+            message.words.reserve(end - begin);
+            for (int i = begin; i < end; ++i) {
+                Domain::Word word = pack.wordAt(i, source_.book.id);
+                word.parseStructuredFields();   // 结构化字段在读取线程上解析，不占用写入线程
+                message.words.append(word);
+            }
+            if (sorted_) {
+                sortByWordId(message.words);
+            }
+
+            channel_.acquireSlot();
+            message.seq = batches++;
+            channel_.post(message);
+        }
+    }
+
+    Channel& channel_;
+    QThreadPool& parsePool_;
+    int book_;
+    ImportPipeline::Source source_;
+    int batchSize_;
+    bool validate_;
+    bool sorted_;
+};
+
+/**
+ * @brief 写入阶段中每个词库的进度
+ */
+struct BookProgress {
+    bool started = false;
+    bool ended = false;
+    int nextSeq = 0;                // 下一个应写入的批次
+    int totalBatches = 0;           // ended 之后有效
+    QMap<int, QList<Domain::Word>> waiting;  // 先到达的后续批次
+};
+
+} // namespace
+
+ImportPipeline::Options::Options()
+    : readerThreads(2)
+    , parserThreads(qMax(1, QThread::idealThreadCount() - 1))
+    , batchSize(1000)
+    , maxInFlightBatches(16)
+    , validateJson(false)
+    , bulkLoad(false)
+    , compressDetails(false)
+    , commitEachBatch(false)
+{
+}
+
+ImportPipeline::ImportPipeline(Domain::IBookRepository& bookRepo,
+                               Domain::IWordRepository& wordRepo,
+                               const Options& options)
+    : bookRepo_(bookRepo)
+    , wordRepo_(wordRepo)
+    , options_(options)
+{
+    options_.readerThreads = qMax(1, options_.readerThreads);
+    options_.parserThreads = qMax(1, options_.parserThreads);
+    options_.batchSize = qMax(1, options_.batchSize);
+    options_.maxInFlightBatches = qMax(1, options_.maxInFlightBatches);
+    
+    // 批量导入模式暂停索引维护直到整体提交，不能与逐批提交同时使用
+    if (options_.commitEachBatch) {
+        options_.bulkLoad = false;
+    }
+}
+
+void ImportPipeline::setProgressHandler(const ProgressHandler& handler) {
+    progressHandler_ = handler;
+}
+
+void ImportPipeline::setWriteExecutor(const WriteExecutor& executor) {
+    writeExecutor_ = executor;
+}
+
+ImportPipeline::Result ImportPipeline::run(const QList<Source>& sources) {
+    Result result;
+    QElapsedTimer timer;
+    timer.start();
+
+    for (const Source& source : sources) {
+        BookResult bookResult;
+        bookResult.bookId = source.book.id;
+        result.books.append(bookResult);
+    }
+
+    if (sources.isEmpty()) {
+        result.success = true;
+        return result;
+    }
+
+    // 数据库访问都经过 write()：设置了执行器时在写连接的线程上执行
+    auto write = [this](const std::function<bool()>& work) {
+        return writeExecutor_ ? writeExecutor_(work) : work();
+    };
+    
+    // 逐批提交模式下的短事务：失败时回滚，连接不停留在事务中
+    auto commitBatch = [this](const QList<Domain::Word>& words) {
+        if (!wordRepo_.beginTransaction()) {
+            return false;
+        }
+        if (!wordRepo_.saveBatch(words) || !wordRepo_.commit()) {
+            wordRepo_.rollback();
+            return false;
+        }
+        return true;
+    };
+    
+    // 逐批提交模式下已提交的批次无法回滚，在一个事务中删除这些词库
+    auto removeBooks = [this](const QStringList& bookIds) {
+        if (!wordRepo_.beginTransaction()) {
+            return false;
+        }
+        for (const QString& bookId : bookIds) {
+            if (!wordRepo_.removeByBookId(bookId) || !bookRepo_.remove(bookId)) {
+                wordRepo_.rollback();
+                return false;
+            }
+        }
+        if (!wordRepo_.commit()) {
+            wordRepo_.rollback();
+            return false;
+        }
+        return true;
+    };
+    
+    // 批量导入模式下由仓储暂停并在提交时重建索引，失败时恢复原状
+    const bool bulk = options_.bulkLoad;
+    const bool perBatch = options_.commitEachBatch;
+    bool began = perBatch || write([&]() {
+        return bulk ? wordRepo_.beginBulkLoad() : wordRepo_.beginTransaction();
+    });
+    if (!began) {
+        qWarning() << "Failed to begin import transaction";
+        return result;
+    }
+
+    Channel channel(options_.maxInFlightBatches);
+    QThreadPool readerPool;
+    QThreadPool parsePool;
+    readerPool.setMaxThreadCount(options_.readerThreads);
+    parsePool.setMaxThreadCount(options_.parserThreads);
+
+    QVector<BookProgress> progress(sources.size());
+    int pendingBooks = 0;
+
+    // 词库元数据先写入（单词表外键引用词库），再启动该词库的读取
+    for (int i = 0; i < sources.size(); ++i) {
+        const Domain::Book& book = sources[i].book;
+        if (!write([&]() { return bookRepo_.save(book); })) {
+            result.books[i].error = "Failed to save book";
+            continue;
+        }
+        progress[i].started = true;
+        ++pendingBooks;
+        readerPool.start(new SplitTask(channel, parsePool, i, sources[i],
+                                       options_.batchSize, options_.validateJson,
+                                       options_.bulkLoad));
+    }
+
+    bool writeFailed = false;
+    bool cancelled = false;
+    int totalWords = 0;
+
+    while (pendingBooks > 0) {
+        Message message = channel.take();
+        BookProgress& book = progress[message.book];
+        BookResult& bookResult = result.books[message.book];
+
+        if (message.kind == Message::Kind::BookEnd) {
+            book.ended = true;
+            book.totalBatches = message.seq;
+            if (!message.error.isEmpty() && bookResult.error.isEmpty()) {
+                bookResult.error = message.error;
+            }
+        } else {
+            book.waiting.insert(message.seq, message.words);
+        }
+
+        // 按序号写入已到达的连续批次；失败的词库只丢弃、归还名额
+        while (book.waiting.contains(book.nextSeq)) {
+            QList<Domain::Word> words = book.waiting.take(book.nextSeq);
+            ++book.nextSeq;
+
+            if (!writeFailed && !cancelled && bookResult.error.isEmpty() && !words.isEmpty()) {
+                bool saved = write([&]() {
+                    return perBatch ? commitBatch(words) : wordRepo_.saveBatch(words);
+                });
+                if (saved) {
+                    bookResult.importedWords += words.size();
+                    totalWords += words.size();
+                    
+                    if (progressHandler_) {
+                        Progress current;
+                        current.book = message.book;
+                        current.bookId = bookResult.bookId;
+                        current.bookWords = bookResult.importedWords;
+                        current.totalWords = totalWords;
+                        current.elapsedMs = timer.elapsed();
+                        if (!progressHandler_(current)) {
+                            cancelled = true;
+                            channel.abort();
+                        }
+                    }
+                } else {
+                    // 写连接出错时整体回滚，通知读取线程尽快停止
+                    writeFailed = true;
+                    channel.abort();
+                }
+            }
+            channel.releaseSlot();
+        }
+
+        if (book.ended && book.nextSeq == book.totalBatches) {
+            --pendingBooks;
+        }
+    }
+
+    readerPool.waitForDone();
+    parsePool.waitForDone();
+
+    if (writeFailed || cancelled) {
+        if (cancelled) {
+            qDebug() << "Import cancelled, rolling back";
+        } else {
+            qWarning() << "Import failed while writing words, rolling back";
+        }
+        if (perBatch) {
+            QStringList startedBooks;
+            for (int i = 0; i < sources.size(); ++i) {
+                if (progress[i].started) {
+                    startedBooks << sources[i].book.id;
+                }
+            }
+            if (!write([&]() { return removeBooks(startedBooks); })) {
+                qWarning() << "Failed to remove partially imported books:" << startedBooks;
+            }
+        } else {
+            write([&]() { return bulk ? wordRepo_.rollbackBulkLoad() : wordRepo_.rollback(); });
+        }
+        result.cancelled = cancelled;
+        for (BookResult& bookResult : result.books) {
+            bookResult.success = false;
+            bookResult.importedWords = 0;
+        }
+        result.elapsedMs = timer.elapsed();
+        return result;
+    }
+
+    // 失败或没有单词的词库不留下半成品
+    QStringList failedBooks;
+    for (int i = 0; i < sources.size(); ++i) {
+        BookResult& bookResult = result.books[i];
+        if (bookResult.error.isEmpty() && bookResult.importedWords == 0) {
+            bookResult.error = "No words found";
+        }
+
+        if (bookResult.error.isEmpty()) {
+            bookResult.success = true;
+            ++result.importedBooks;
+            result.importedWords += bookResult.importedWords;
+            continue;
+        }
+
+        qWarning() << "Failed to import book" << bookResult.bookId << ":" << bookResult.error;
+        bookResult.importedWords = 0;
+        if (progress[i].started) {
+            failedBooks << bookResult.bookId;
+        }
+    }
+
+    if (perBatch) {
+        // 成功的词库已逐批提交，失败的词库删除失败只留下警告
+        if (!failedBooks.isEmpty() && !write([&]() { return removeBooks(failedBooks); })) {
+            qWarning() << "Failed to remove failed books:" << failedBooks;
+        }
+        result.success = true;
+    } else {
+        result.success = write([&]() {
+            for (const QString& bookId : failedBooks) {
+                wordRepo_.removeByBookId(bookId);
+                bookRepo_.remove(bookId);
+            }
+            if (bulk) {
+                return wordRepo_.commitBulkLoad();
+            }
+            // 提交失败时事务仍然打开，回滚后连接才能继续用于其他写入
+            if (!wordRepo_.commit()) {
+                wordRepo_.rollback();
+                return false;
+            }
+            return true;
+        });
+    }
+    if (!result.success) {
+        result.importedBooks = 0;
+        result.importedWords = 0;
+    }
+
+    // 导入已提交后逐个词库压缩，失败只保留未压缩的数据
+    if (result.success && options_.compressDetails) {
+        for (const BookResult& bookResult : result.books) {
+            const QString& bookId = bookResult.bookId;
+            if (bookResult.success
+                && !write([&]() { return wordRepo_.compressDetails(bookId); })) {
+                qWarning() << "Failed to compress details of book" << bookResult.bookId;
+            }
+        }
+    }
+
+    result.elapsedMs = timer.elapsed();
+    return result;
+}
+
+} // namespace Application
+} // namespace WordMaster
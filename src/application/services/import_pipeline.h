@@ -0,0 +1,126 @@
+#ifndef WORDMASTER_APPLICATION_IMPORT_PIPELINE_H
+#define WORDMASTER_APPLICATION_IMPORT_PIPELINE_H
+
+#include "domain/repositories.h"
+#include "domain/entities.h"
+#include <QString>
+#include <QList>
+#include <functional>
+
+namespace WordMaster {
+namespace Application {
+
+/**
+ * @brief 多词库并行导入流水线
+ *
+ * 三个阶段：
+ * - 切分：读取线程按块读文件（.gz/.zst 边读边解压），切出数组元素，每 batchSize 个元素组成一批
+ * - 解析：解析线程池把一批元素解析为 Word（不同词库、同一词库的不同批次并行）
+ * - 写入：调用 run() 的线程（持有写连接）按批次顺序写库
+ *
+ * 已切分但尚未写入的批次数不超过 maxInFlightBatches，
+ * 写入跟不上时读取线程阻塞（背压），内存占用与词库数量和大小无关。
+ *
+ * 同一词库的批次按原顺序写入（词库内重复的单词仍以后出现的为准）。
+ * 默认整个导入在一个事务中完成；某个词库失败时删除该词库已写入的数据，
+ * 写库出错或进度回调要求取消时整体回滚。
+ *
+ * 与界面共用写连接时（见 setWriteExecutor()）应开启 commitEachBatch：
+ * 每批一个短事务，写锁不会被整个词库占住；失败或取消时删除已开始写入的词库。
+ */
+class ImportPipeline {
+public:
+    /**
+     * @brief 待导入的词库
+     */
+    struct Source {
+        Domain::Book book;
+        QString jsonPath;           // 可为 .json.gz / .json.zst / .wmpack
+    };
+
+    struct Options {
+        int readerThreads;          // 同时读取的词库数
+        int parserThreads;          // 解析线程数
+        int batchSize;              // 每批单词数
+        int maxInFlightBatches;     // 未写入批次上限（背压）
+        bool validateJson;          // 校验嵌套字段（默认信任词库文件）
+        bool bulkLoad;              // 批量导入模式：暂停索引维护，结束时重建（见 IWordRepository）
+        bool compressDetails;       // 提交后按词库训练字典压缩 JSON 字段（见 IWordRepository）
+        bool commitEachBatch;       // 每批单独提交（与 bulkLoad 互斥，开启时忽略 bulkLoad）
+
+        Options();
+    };
+
+    /**
+     * @brief 写入进度（每写完一批报告一次）
+     */
+    struct Progress {
+        int book;                   // Source 下标
+        QString bookId;
+        int bookWords;              // 该词库已写入的单词数
+        int totalWords;             // 所有词库已写入的单词数
+        qint64 elapsedMs;
+    };
+    
+    // 在写入线程上调用；返回false时取消导入（整体回滚）
+    using ProgressHandler = std::function<bool(const Progress&)>;
+    
+    // 在写连接所属线程上执行一次数据库操作并返回其结果（阻塞直到执行完）
+    using WriteExecutor = std::function<bool(const std::function<bool()>&)>;
+    
+    struct BookResult {
+        QString bookId;
+        bool success;
+        int importedWords;
+        QString error;
+
+        BookResult() : success(false), importedWords(0) {}
+    };
+
+    struct Result {
+        bool success;               // 事务已提交（个别词库失败不影响）
+        bool cancelled;             // 被进度回调取消（已回滚）
+        int importedBooks;
+        int importedWords;
+        qint64 elapsedMs;
+        QList<BookResult> books;    // 与 run() 参数顺序一致
+
+        Result() : success(false), cancelled(false), importedBooks(0),
+                   importedWords(0), elapsedMs(0) {}
+    };
+
+    ImportPipeline(Domain::IBookRepository& bookRepo,
+                   Domain::IWordRepository& wordRepo,
+                   const Options& options = Options());
+
+    void setProgressHandler(const ProgressHandler& handler);
+    
+    /**
+     * @brief 把所有数据库访问交给执行器
+     *
+     * 设置后 run() 可以在其他线程上调用，由执行器把每次写入转到写连接的线程。
+     * 写连接同时服务其他写入时，必须同时开启 commitEachBatch，
+     * 否则事务会跨越两次写入之间的其他操作。
+     */
+    void setWriteExecutor(const WriteExecutor& executor);
+    
+    /**
+     * @brief 导入词库（阻塞直到完成）
+     *
+     * 未设置写入执行器时必须在仓储所用写连接的线程上调用；
+     * 工作线程只读文件和解析 JSON，不访问数据库。
+     */
+    Result run(const QList<Source>& sources);
+
+private:
+    Domain::IBookRepository& bookRepo_;
+    Domain::IWordRepository& wordRepo_;
+    Options options_;
+    ProgressHandler progressHandler_;
+    WriteExecutor writeExecutor_;
+};
+
+} // namespace Application
+} // namespace WordMaster
+
+#endif // WORDMASTER_APPLICATION_IMPORT_PIPELINE_H
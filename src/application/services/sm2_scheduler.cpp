@@ -11,10 +11,10 @@ SM2Scheduler::SM2Scheduler(Domain::IReviewScheduleRepository& repo)
 {
 }
 
-void SM2Scheduler::initializeSchedule(int wordId, const QString& bookId) {
+bool SM2Scheduler::initializeSchedule(int wordId, const QString& bookId) {
     // 如果已存在，不重复初始化
     if (repo_.exists(wordId)) {
-        return;
+        return true;
     }
     
     Domain::ReviewPlan plan;
@@ -27,19 +27,23 @@ void SM2Scheduler::initializeSchedule(int wordId, const QString& bookId) {
     plan.easinessFactor = 2.5;  // 默认难度系数
     plan.masteryLevel = Domain::ReviewPlan::MasteryLevel::Learning;
     
-    repo_.save(plan);
+    if (!repo_.save(plan)) {
+        qWarning() << "Failed to initialize schedule for word" << wordId;
+        return false;
+    }
     
     qDebug() << "Initialized schedule for word" << wordId 
              << "next review:" << plan.nextReviewDate.toString();
+    return true;
 }
 
-void SM2Scheduler::updateSchedule(int wordId, Domain::ReviewQuality quality) {
+bool SM2Scheduler::updateSchedule(int wordId, Domain::ReviewQuality quality) {
     Domain::ReviewPlan plan = repo_.get(wordId);
     
     // 如果不存在，先初始化（不应该发生）
     if (plan.wordId == 0) {
         qWarning() << "Review plan not found for word:" << wordId;
-        return;
+        return false;
     }
     
     // 应用 SM-2 算法
@@ -61,13 +65,17 @@ void SM2Scheduler::updateSchedule(int wordId, Domain::ReviewQuality quality) {
     updateMasteryLevel(plan);
     
     // 保存
-    repo_.save(plan);
+    if (!repo_.save(plan)) {
+        qWarning() << "Failed to save schedule for word" << wordId;
+        return false;
+    }
     
     qDebug() << "Updated schedule for word" << wordId 
              << ": interval=" << plan.reviewInterval
              << ", EF=" << plan.easinessFactor
              << ", reps=" << plan.repetitionCount
              << ", next=" << plan.nextReviewDate.toString();
+    return true;
 }
 
 QList<int> SM2Scheduler::getTodayReviewWords(const QString& bookId) {
@@ -42,15 +42,17 @@ public:
      * @brief 初始化新单词的复习计划
      * @param wordId 单词ID
      * @param bookId 词库ID
+     * @return 已存在或保存成功返回true
      */
-    void initializeSchedule(int wordId, const QString& bookId);
+    bool initializeSchedule(int wordId, const QString& bookId);
     
     /**
      * @brief 更新复习计划
      * @param wordId 单词ID
      * @param quality 复习质量
+     * @return 保存成功返回true；复习计划不存在时返回false
      */
-    void updateSchedule(int wordId, Domain::ReviewQuality quality);
+    bool updateSchedule(int wordId, Domain::ReviewQuality quality);
     
     /**
      * @brief 获取今日待复习单词
@@ -1,24 +1,77 @@
 #include "study_service.h"
 #include <QUuid>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QDebug>
 
 namespace WordMaster {
 namespace Application {
 
+/**
+ * @brief 预取的卡片（后台任务写入，界面线程读取）
+ *
+ * 开始新会话时 generation 加一，之前会话的任务完成后不再写入。
+ */
+struct StudyService::PrefetchStore {
+    QMutex mutex;
+    quint64 generation = 0;
+    QHash<int, WordCard> cards;
+};
+
 StudyService::StudyService(Domain::IWordRepository& wordRepo,
                            Domain::IStudyRecordRepository& recordRepo,
                            SM2Scheduler& scheduler)
     : wordRepo_(wordRepo)
     , recordRepo_(recordRepo)
     , scheduler_(scheduler)
+    , prefetchWindow_(kDefaultPrefetchWindow)
+    , prefetchStore_(std::make_shared<PrefetchStore>())
+    , prefetchedUpTo_(0)
 {
 }
 
+StudyService::~StudyService() {
+    // 先提交队列，再让仓储随所有者销毁
+    writeQueue_.reset();
+}
+
+void StudyService::enableWriteBehind(int maxPending, int flushIntervalMs) {
+    flushPendingWrites();
+    
+    writeQueue_ = std::make_unique<StudyWriteQueue>(
+        [this](const QList<StudyWriteQueue::PendingAnswer>& answers) {
+            return commitPendingAnswers(answers);
+        },
+        maxPending,
+        flushIntervalMs
+    );
+}
+
+bool StudyService::flushPendingWrites() {
+    if (!writeQueue_) {
+        return true;
+    }
+    return writeQueue_->flush();
+}
+
+int StudyService::pendingWriteCount() const {
+    return writeQueue_ ? writeQueue_->pendingCount() : 0;
+}
+
+void StudyService::enablePrefetch(const ReadExecutor& executor, int window) {
+    prefetchExecutor_ = executor;
+    prefetchWindow_ = qMax(1, window);
+}
+
 StudyService::StudySession StudyService::startSession(
     const QString& bookId,
     StudySession::Type type,
     int maxWords)
 {
+    // 选词依赖复习计划，先落盘排队中的结果
+    flushPendingWrites();
+    
     StudySession session;
     session.sessionId = QUuid::createUuid().toString();
     session.bookId = bookId;
@@ -50,6 +103,16 @@ StudyService::StudySession StudyService::startSession(
         }
     }
     
+    // 丢弃上一个会话的卡片，开始预取本会话
+    {
+        QMutexLocker locker(&prefetchStore_->mutex);
+        ++prefetchStore_->generation;
+        prefetchStore_->cards.clear();
+    }
+    prefetchSessionId_ = session.sessionId;
+    prefetchedUpTo_ = 0;
+    prefetchAhead(session);
+    
     return session;
 }
 
@@ -59,14 +122,105 @@ Domain::Word StudyService::getCurrentWord(const StudySession& session) {
     }
     
     int wordId = session.getCurrentWordId();
-    return wordRepo_.getById(wordId);
+    return wordRepo_.getById(wordId, Domain::WordProjection::Summary);
+}
+
+StudyService::WordCard StudyService::getCurrentCard(const StudySession& session) {
+    if (!session.hasNext()) {
+        return WordCard();
+    }
+    
+    prefetchAhead(session);
+    
+    int wordId = session.getCurrentWordId();
+    {
+        QMutexLocker locker(&prefetchStore_->mutex);
+        auto it = prefetchStore_->cards.constFind(wordId);
+        if (it != prefetchStore_->cards.constEnd()) {
+            return it.value();
+        }
+    }
+    
+    // 未启用预取或后台还没读到
+    Domain::Word word = wordRepo_.getById(wordId, Domain::WordProjection::Summary);
+    return word.id > 0 ? loadCard(wordRepo_, word) : WordCard();
+}
+
+void StudyService::prefetchAhead(const StudySession& session) {
+    if (!prefetchExecutor_ || session.sessionId != prefetchSessionId_) {
+        return;
+    }
+    if (prefetchedUpTo_ >= session.wordIds.size()
+            || prefetchedUpTo_ - session.currentIndex > prefetchWindow_ / 2) {
+        return;
+    }
+    
+    int begin = qMax(prefetchedUpTo_, session.currentIndex);
+    int end = qMin(session.wordIds.size(), session.currentIndex + prefetchWindow_);
+    prefetchedUpTo_ = end;
+    
+    QList<int> wordIds = session.wordIds.mid(begin, end - begin);
+    std::shared_ptr<PrefetchStore> store = prefetchStore_;
+    quint64 generation;
+    {
+        QMutexLocker locker(&store->mutex);
+        generation = store->generation;
+    }
+    
+    prefetchExecutor_([store, generation, wordIds](Domain::IWordRepository& repo) {
+        QList<WordCard> cards;
+        for (const Domain::Word& word : repo.getByIds(wordIds, Domain::WordProjection::Summary)) {
+            cards.append(loadCard(repo, word));
+        }
+        
+        QMutexLocker locker(&store->mutex);
+        if (store->generation != generation) {
+            return;
+        }
+        for (const WordCard& card : cards) {
+            store->cards.insert(card.word.id, card);
+        }
+    });
+}
+
+StudyService::WordCard StudyService::loadCard(Domain::IWordRepository& repo,
+                                              const Domain::Word& word) {
+    WordCard card;
+    card.word = word;
+    card.translations = repo.getTranslations(word.id);
+    card.sentences = repo.getSentences(word.id);
+    return card;
 }
 
 bool StudyService::recordAndNext(StudySession& session, 
                                   const StudyResult& result) 
 {
-    // 记录学习结果
+    // 写后模式：只入队，由队列批量提交
+    if (writeQueue_) {
+        StudyWriteQueue::PendingAnswer answer;
+        answer.wordId = result.wordId;
+        answer.bookId = result.bookId;
+        answer.known = result.known;
+        answer.duration = result.duration;
+        answer.newWord = (session.type == StudySession::NewWords);
+        
+        writeQueue_->enqueue(answer);
+        session.moveNext();
+        return true;
+    }
+    
+    // 记录学习结果：学习记录与复习计划在同一个事务中提交
+    if (!wordRepo_.beginTransaction()) {
+        return false;
+    }
+    
     if (!recordStudyResult(result, session.type)) {
+        wordRepo_.rollback();
+        return false;
+    }
+    
+    if (!wordRepo_.commit()) {
+        wordRepo_.rollback();
         return false;
     }
     
@@ -81,6 +235,9 @@ StudyService::SessionSummary StudyService::endSession(
 {
     SessionSummary summary;
     
+    // 读自己的写：统计前先提交排队中的结果
+    flushPendingWrites();
+    
     // 获取本次会话的所有记录
     QList<Domain::StudyRecord> records = recordRepo_.getByBookId(session.bookId);
     
@@ -126,6 +283,8 @@ StudyService::SessionSummary StudyService::endSession(
 StudyService::TodayStats StudyService::getTodayStats(const QString& bookId) {
     TodayStats stats;
     
+    flushPendingWrites();
+    
     stats.newWordsLearned = recordRepo_.getTodayLearnCount(bookId);
     stats.wordsReviewed = recordRepo_.getTodayReviewCount(bookId);
     stats.totalDuration = recordRepo_.getTotalStudyDuration(QDate::currentDate());
@@ -157,13 +316,17 @@ bool StudyService::recordStudyResult(const StudyResult& result,
     // 2. 更新复习计划
     if (sessionType == StudySession::NewWords) {
         // 学习新词：初始化复习计划
-        scheduler_.initializeSchedule(result.wordId, result.bookId);
+        if (!scheduler_.initializeSchedule(result.wordId, result.bookId)) {
+            return false;
+        }
         
         // 根据结果更新复习计划
         Domain::ReviewQuality quality = result.known
             ? Domain::ReviewQuality::Good
             : Domain::ReviewQuality::Again;
-        scheduler_.updateSchedule(result.wordId, quality);
+        if (!scheduler_.updateSchedule(result.wordId, quality)) {
+            return false;
+        }
     } else {
         // 复习：更新复习计划
         // 根据结果确定复习质量
@@ -181,7 +344,9 @@ bool StudyService::recordStudyResult(const StudyResult& result,
             quality = Domain::ReviewQuality::Again;  // 不认识，重新开始
         }
         
-        scheduler_.updateSchedule(result.wordId, quality);
+        if (!scheduler_.updateSchedule(result.wordId, quality)) {
+            return false;
+        }
     }
     
     qDebug() << "Recorded study result for word" << result.wordId 
@@ -190,5 +355,39 @@ bool StudyService::recordStudyResult(const StudyResult& result,
     return true;
 }
 
+bool StudyService::commitPendingAnswers(
+    const QList<StudyWriteQueue::PendingAnswer>& answers)
+{
+    // 所有仓储共享同一个连接，单词仓储的事务覆盖记录和复习计划的写入；
+    // 已在外层事务中时嵌套为保存点，随外层一起提交
+    if (!wordRepo_.beginTransaction()) {
+        return false;
+    }
+    
+    for (const StudyWriteQueue::PendingAnswer& answer : answers) {
+        StudyResult result;
+        result.wordId = answer.wordId;
+        result.bookId = answer.bookId;
+        result.known = answer.known;
+        result.duration = answer.duration;
+        
+        StudySession::Type type = answer.newWord
+            ? StudySession::NewWords
+            : StudySession::Review;
+        
+        if (!recordStudyResult(result, type)) {
+            wordRepo_.rollback();
+            return false;
+        }
+    }
+    
+    // 提交失败时事务仍然打开，必须回滚，否则队列重试时会嵌套成保存点
+    if (!wordRepo_.commit()) {
+        wordRepo_.rollback();
+        return false;
+    }
+    return true;
+}
+
 } // namespace Application
 } // namespace WordMaster
\ No newline at end of file
@@ -4,7 +4,10 @@
 #include "domain/repositories.h"
 #include "domain/entities.h"
 #include "sm2_scheduler.h"
+#include "study_write_queue.h"
 #include <QDateTime>
+#include <functional>
+#include <memory>
 
 namespace WordMaster {
 namespace Application {
@@ -17,6 +20,8 @@ namespace Application {
  * - 单词展示流程
  * - 学习结果记录
  * - 复习调度集成
+ * - 可选的写后批量提交（见 enableWriteBehind）
+ * - 可选的单词卡片后台预取（见 enablePrefetch）
  */
 class StudyService {
 public:
@@ -99,10 +104,68 @@ public:
                           unknownWords(0), totalDuration(0) {}
     };
     
+    /**
+     * @brief 单词卡片：展示一个单词所需的全部数据（已解码）
+     */
+    struct WordCard {
+        Domain::Word word;                              // Summary 投影
+        QList<Domain::WordTranslation> translations;
+        QList<Domain::WordSentence> sentences;
+    };
+    
+    // 在后台线程上执行的读任务，参数为该线程连接上的单词仓储（只在任务内有效）
+    using ReadTask = std::function<void(Domain::IWordRepository&)>;
+    // 把读任务交给后台线程执行（如 ConnectionManager::submitRead）
+    using ReadExecutor = std::function<void(const ReadTask&)>;
+    
+    // 默认预取窗口（张）
+    static const int kDefaultPrefetchWindow = 20;
+    
     explicit StudyService(Domain::IWordRepository& wordRepo,
                          Domain::IStudyRecordRepository& recordRepo,
                          SM2Scheduler& scheduler);
     
+    /**
+     * @brief 析构函数 - 提交尚未写入的学习结果
+     */
+    ~StudyService();
+    
+    /**
+     * @brief 启用写后批量提交
+     * 
+     * 启用后 recordAndNext() 只把结果放入队列（同一单词的多次作答合并为一条），
+     * 累积 maxPending 个单词或等待 flushIntervalMs 毫秒后在一个事务中提交。
+     * 依赖这些数据的查询（开始/结束会话、今日统计）会先提交队列，保证读到自己的写入。
+     * 
+     * 提交在调用线程上执行：写连接只能在创建它的线程中使用。
+     * 
+     * @param maxPending 累积多少个单词后提交
+     * @param flushIntervalMs 最长等待时间（毫秒），需要事件循环
+     */
+    void enableWriteBehind(int maxPending, int flushIntervalMs);
+    
+    /**
+     * @brief 立即提交队列中的学习结果
+     * @return 成功或未启用写后队列时返回true
+     */
+    bool flushPendingWrites();
+    
+    /**
+     * @brief 队列中尚未提交的学习结果数
+     */
+    int pendingWriteCount() const;
+    
+    /**
+     * @brief 启用单词卡片预取
+     * 
+     * 启用后开始会话时在后台读取前 window 张卡片，之后每翻过半个窗口
+     * 再读取下一段，getCurrentCard() 只查内存；还没读到的卡片在当前线程同步读取。
+     * 
+     * @param executor 后台执行读任务（必须用独立的只读连接）
+     * @param window 预取窗口（张）
+     */
+    void enablePrefetch(const ReadExecutor& executor, int window = kDefaultPrefetchWindow);
+    
     /**
      * @brief 开始学习会话
      * @param bookId 词库ID
@@ -117,10 +180,17 @@ public:
     /**
      * @brief 获取当前单词
      * @param session 学习会话
-     * @return 单词对象
+     * @return 单词对象（Summary 投影；释义、例句用 IWordRepository::getTranslations() 等按需读取）
      */
     Domain::Word getCurrentWord(const StudySession& session);
     
+    /**
+     * @brief 获取当前单词卡片（含释义、例句），并按需预取后续卡片
+     * @param session 学习会话
+     * @return 单词卡片；会话已结束时 word 为空
+     */
+    WordCard getCurrentCard(const StudySession& session);
+    
     /**
      * @brief 记录学习结果并移动到下一个
      * @param session 学习会话
@@ -153,10 +223,29 @@ private:
     Domain::IWordRepository& wordRepo_;
     Domain::IStudyRecordRepository& recordRepo_;
     SM2Scheduler& scheduler_;
+    std::unique_ptr<StudyWriteQueue> writeQueue_;
+    
+    // 预取：卡片由后台线程写入，与读线程共享
+    struct PrefetchStore;
+    ReadExecutor prefetchExecutor_;
+    int prefetchWindow_;
+    std::shared_ptr<PrefetchStore> prefetchStore_;
+    QString prefetchSessionId_;     // 当前预取的会话
+    int prefetchedUpTo_;            // 已提交预取的卡片下标上界（不含）
     
-    // 记录学习结果的内部实现
+    // 从 session.currentIndex 起不足半个窗口时提交下一段预取
+    void prefetchAhead(const StudySession& session);
+    
+    // 读取一张卡片（在任意线程上调用，使用该线程的仓储）
+    static WordCard loadCard(Domain::IWordRepository& repo, const Domain::Word& word);
+    
+    // 记录学习结果的内部实现；学习记录或复习计划写入失败时返回false，
+    // 由调用方回滚所在的事务
     bool recordStudyResult(const StudyResult& result, 
                           StudySession::Type sessionType);
+    
+    // 在一个事务中提交一批排队的学习结果
+    bool commitPendingAnswers(const QList<StudyWriteQueue::PendingAnswer>& answers);
 };
 
 } // namespace Application
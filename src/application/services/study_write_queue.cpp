@@ -0,0 +1,93 @@
+#include "study_write_queue.h"
+#include <QDebug>
+
+namespace WordMaster {
+namespace Application {
+
+StudyWriteQueue::StudyWriteQueue(CommitFunction commit,
+                                 int maxPending,
+                                 int flushIntervalMs)
+    : commit_(std::move(commit))
+    , maxPending_(qMax(1, maxPending))
+{
+    timer_.setSingleShot(true);
+    timer_.setInterval(qMax(0, flushIntervalMs));
+    QObject::connect(&timer_, &QTimer::timeout, [this]() {
+        flush();
+    });
+}
+
+StudyWriteQueue::~StudyWriteQueue() {
+    timer_.stop();
+    
+    if (!flush()) {
+        qWarning() << "Dropped" << pending_.size() << "pending study results on exit";
+    }
+}
+
+void StudyWriteQueue::enqueue(const PendingAnswer& answer) {
+    merge(pending_, answer);
+    
+    if (pending_.size() >= maxPending_) {
+        flush();
+        return;
+    }
+    
+    // 从第一条事件开始计时，后续事件不延长等待
+    if (!timer_.isActive()) {
+        timer_.start();
+    }
+}
+
+bool StudyWriteQueue::flush() {
+    timer_.stop();
+    
+    if (pending_.isEmpty()) {
+        return true;
+    }
+    
+    QList<PendingAnswer> batch;
+    batch.swap(pending_);
+    
+    if (!commit_(batch)) {
+        qWarning() << "Failed to commit" << batch.size() << "study results, will retry";
+        
+        // 保留失败的事件，排在新事件之前
+        for (const PendingAnswer& answer : pending_) {
+            merge(batch, answer);
+        }
+        pending_.swap(batch);
+        timer_.start();
+        return false;
+    }
+    
+    qDebug() << "Committed" << batch.size() << "study results in one transaction";
+    return true;
+}
+
+void StudyWriteQueue::merge(QList<PendingAnswer>& pending, const PendingAnswer& answer) {
+    for (PendingAnswer& existing : pending) {
+        if (existing.wordId == answer.wordId) {
+            existing.known = answer.known;
+            existing.duration += answer.duration;
+            return;
+        }
+    }
+    pending.append(answer);
+}
+
+int StudyWriteQueue::pendingCount() const {
+    return pending_.size();
+}
+
+bool StudyWriteQueue::hasPending(int wordId) const {
+    for (const PendingAnswer& answer : pending_) {
+        if (answer.wordId == wordId) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace Application
+} // namespace WordMaster
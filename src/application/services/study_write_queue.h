@@ -0,0 +1,96 @@
+#ifndef WORDMASTER_APPLICATION_STUDY_WRITE_QUEUE_H
+#define WORDMASTER_APPLICATION_STUDY_WRITE_QUEUE_H
+
+#include <QString>
+#include <QList>
+#include <QTimer>
+#include <functional>
+
+namespace WordMaster {
+namespace Application {
+
+/**
+ * @brief 学习结果写后队列（write-behind）
+ * 
+ * 职责：
+ * - 接收答题事件，立即返回，不在点击路径上写库
+ * - 同一单词的多次作答合并为一条待写事件
+ * - 累积到 N 个单词或等待 M 毫秒后，在一个事务中批量提交
+ * - 析构时提交剩余事件（退出前不丢数据）
+ * 
+ * 队列不直接访问数据库，提交动作由所有者通过 CommitFunction 提供，
+ * 并在所有者的线程（持有写连接的线程）上执行。
+ */
+class StudyWriteQueue {
+public:
+    /**
+     * @brief 待提交的答题事件
+     */
+    struct PendingAnswer {
+        int wordId;
+        QString bookId;
+        bool known;                // true=认识, false=不认识
+        int duration;              // 学习时长（秒）
+        bool newWord;              // true=新词学习, false=复习
+        
+        PendingAnswer() : wordId(0), known(false), duration(0), newWord(true) {}
+    };
+    
+    // 在一个事务中提交一批事件，成功返回true
+    using CommitFunction = std::function<bool(const QList<PendingAnswer>&)>;
+    
+    /**
+     * @brief 构造函数
+     * @param commit 批量提交函数
+     * @param maxPending 累积多少条后立即提交
+     * @param flushIntervalMs 第一条事件入队后最多等待多少毫秒提交
+     */
+    StudyWriteQueue(CommitFunction commit, int maxPending, int flushIntervalMs);
+    
+    /**
+     * @brief 析构函数 - 提交剩余事件
+     */
+    ~StudyWriteQueue();
+    
+    // 禁用拷贝
+    StudyWriteQueue(const StudyWriteQueue&) = delete;
+    StudyWriteQueue& operator=(const StudyWriteQueue&) = delete;
+    
+    /**
+     * @brief 入队一个答题事件
+     * 
+     * 该单词已有待写事件时合并：保留首次的学习类型（新词仍会初始化复习计划），
+     * 结果取最后一次，时长累加。
+     */
+    void enqueue(const PendingAnswer& answer);
+    
+    /**
+     * @brief 立即提交所有待写事件
+     * @return 没有待写事件或提交成功返回true；失败时事件保留待下次重试
+     */
+    bool flush();
+    
+    /**
+     * @brief 待提交事件数
+     */
+    int pendingCount() const;
+    
+    /**
+     * @brief 是否有某个单词的待提交事件
+     */
+    bool hasPending(int wordId) const;
+
+private:
+    // 把事件合并进列表（同一单词只保留一条）
+    static void merge(QList<PendingAnswer>& pending, const PendingAnswer& answer);
+    
+    CommitFunction commit_;
+    QList<PendingAnswer> pending_;
+    int maxPending_;
+    QTimer timer_;
+};
+
+} // namespace Application
+} // namespace WordMaster
+
+#endif // WORDMASTER_APPLICATION_STUDY_WRITE_QUEUE_H
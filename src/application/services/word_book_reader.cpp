@@ -0,0 +1,505 @@
+#include "word_book_reader.h"
+#include "decompressing_device.h"
+#include <QJsonDocument>
+#include <QJsonParseError>
+#include <QDebug>
+#include <cstring>
+
+namespace WordMaster {
+namespace Application {
+
+namespace {
+
+bool isWhitespace(char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+bool isUtf8Bom(char c) {
+    unsigned char byte = static_cast<unsigned char>(c);
+    return byte == 0xEF || byte == 0xBB || byte == 0xBF;
+}
+
+// 单词对象中用到的字段
+enum Field {
+    FieldId,
+    FieldWord,
+    FieldPhonetic0,
+    FieldPhonetic1,
+    FieldTrans,         // 以下为嵌套字段，顺序与 parseItem 中的 nested 一致
+    FieldSentences,
+    FieldPhrases,
+    FieldSynos,
+    FieldRelWords,
+    FieldEtymology,
+    kFieldCount
+};
+
+const char* const kFieldNames[kFieldCount] = {
+    "id", "word", "phonetic0", "phonetic1",
+    "trans", "sentences", "phrases", "synos", "relWords", "etymology"
+};
+
+// 值在元素字节中的范围 [begin, end)
+struct Span {
+    int begin = -1;
+    int end = -1;
+
+    bool isValid() const { return begin >= 0; }
+};
+
+int skipWhitespace(const char* data, int pos, int size) {
+    while (pos < size && isWhitespace(data[pos])) {
+        ++pos;
+    }
+    return pos;
+}
+
+// pos 指向开头的引号，返回结尾引号之后的位置；未闭合返回-1
+int skipString(const char* data, int pos, int size) {
+    for (++pos; pos < size; ++pos) {
+        if (data[pos] == '\\') {
+            ++pos;
+        } else if (data[pos] == '"') {
+            return pos + 1;
+        }
+    }
+    return -1;
+}
+
+// 返回值结束的位置；格式错误返回-1
+int skipValue(const char* data, int pos, int size) {
+    if (pos >= size) {
+        return -1;
+    }
+
+    if (data[pos] == '"') {
+        return skipString(data, pos, size);
+    }
+
+    if (data[pos] == '{' || data[pos] == '[') {
+        int depth = 0;
+        while (pos < size) {
+            const char c = data[pos];
+            if (c == '"') {
+                pos = skipString(data, pos, size);
+                if (pos < 0) {
+                    return -1;
+                }
+                continue;
+            }
+            if (c == '{' || c == '[') {
+                ++depth;
+            } else if ((c == '}' || c == ']') && --depth == 0) {
+                return pos + 1;
+            }
+            ++pos;
+        }
+        return -1;
+    }
+
+    // 数字、true/false/null
+    int start = pos;
+    while (pos < size && data[pos] != ',' && data[pos] != '}' && data[pos] != ']'
+           && !isWhitespace(data[pos])) {
+        ++pos;
+    }
+    return pos > start ? pos : -1;
+}
+
+/**
+ * 只扫描对象的第一层：记录所需字段的值范围，不解析嵌套内容。
+ * 重复的键以后出现的为准（与 QJsonObject 一致）。
+ */
+bool scanObjectFields(const QByteArray& item, Span spans[kFieldCount]) {
+    const char* data = item.constData();
+    const int size = item.size();
+
+    int pos = skipWhitespace(data, 0, size);
+    if (pos >= size || data[pos] != '{') {
+        return false;
+    }
+    pos = skipWhitespace(data, pos + 1, size);
+    if (pos < size && data[pos] == '}') {
+        return true;
+    }
+
+    while (pos < size) {
+        if (data[pos] != '"') {
+            return false;
+        }
+        int keyEnd = skipString(data, pos, size);
+        if (keyEnd < 0) {
+            return false;
+        }
+        const char* key = data + pos + 1;
+        const int keyLength = keyEnd - pos - 2;
+
+        pos = skipWhitespace(data, keyEnd, size);
+        if (pos >= size || data[pos] != ':') {
+            return false;
+        }
+        pos = skipWhitespace(data, pos + 1, size);
+
+        int valueEnd = skipValue(data, pos, size);
+        if (valueEnd < 0) {
+            return false;
+        }
+
+        for (int field = 0; field < kFieldCount; ++field) {
+            if (qstrlen(kFieldNames[field]) == static_cast<uint>(keyLength)
+                && qstrncmp(key, kFieldNames[field], keyLength) == 0) {
+                spans[field].begin = pos;
+                spans[field].end = valueEnd;
+                break;
+            }
+        }
+
+        pos = skipWhitespace(data, valueEnd, size);
+        if (pos < size && data[pos] == ',') {
+            pos = skipWhitespace(data, pos + 1, size);
+            continue;
+        }
+        return pos < size && data[pos] == '}';
+    }
+
+    return false;
+}
+
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// 字符串值解码；不是字符串时返回空（与 QJsonValue::toString() 一致）
+QString spanToString(const char* data, const Span& span) {
+    if (!span.isValid() || data[span.begin] != '"') {
+        return QString();
+    }
+
+    const int begin = span.begin + 1;
+    const int end = span.end - 1;
+
+    // 常见情况：没有转义，直接按 UTF-8 解码
+    if (!memchr(data + begin, '\\', end - begin)) {
+        return QString::fromUtf8(data + begin, end - begin);
+    }
+
+    QString result;
+    int runStart = begin;
+    for (int pos = begin; pos < end; ++pos) {
+        if (data[pos] != '\\') {
+            continue;
+        }
+        result += QString::fromUtf8(data + runStart, pos - runStart);
+
+        if (++pos >= end) {
+            break;
+        }
+        switch (data[pos]) {
+        case 'b': result += QChar('\b'); break;
+        case 'f': result += QChar('\f'); break;
+        case 'n': result += QChar('\n'); break;
+        case 'r': result += QChar('\r'); break;
+        case 't': result += QChar('\t'); break;
+        case 'u': {
+            // \uXXXX 是 UTF-16 码元，代理对逐个追加即可组成完整字符
+            ushort unit = 0;
+            int digits = 0;
+            for (; digits < 4 && pos + 1 < end; ++digits) {
+                int value = hexValue(data[pos + 1]);
+                if (value < 0) {
+                    break;
+                }
+                unit = static_cast<ushort>(unit * 16 + value);
+                ++pos;
+            }
+            result += QChar(unit);
+            break;
+        }
+        default:
+            result += QChar::fromLatin1(data[pos]);   // \" \\ \/
+            break;
+        }
+        runStart = pos + 1;
+    }
+    result += QString::fromUtf8(data + runStart, end - runStart);
+    return result;
+}
+
+// 整数值；不是数字时返回 0（与 QJsonValue::toInt() 一致）
+int spanToInt(const char* data, const Span& span) {
+    if (!span.isValid()) {
+        return 0;
+    }
+
+    QByteArray text = QByteArray::fromRawData(data + span.begin, span.end - span.begin);
+    bool ok = false;
+    int value = text.toInt(&ok);
+    if (!ok) {
+        double number = text.toDouble(&ok);
+        value = ok ? static_cast<int>(number) : 0;
+    }
+    return value;
+}
+
+bool isValidJson(const char* data, const Span& span) {
+    QJsonParseError error;
+    QJsonDocument::fromJson(QByteArray::fromRawData(data + span.begin, span.end - span.begin),
+                            &error);
+    return error.error == QJsonParseError::NoError;
+}
+
+} // namespace
+
+WordBookReader::WordBookReader(const QString& bookId)
+    : bookId_(bookId)
+    , chunkSize_(kDefaultChunkSize)
+    , validate_(false)
+    , state_(State::BeforeArray)
+    , depth_(0)
+    , inString_(false)
+    , escaped_(false)
+    , offset_(0)
+    , wordCount_(0)
+    , skippedCount_(0)
+{
+}
+
+void WordBookReader::setChunkSize(int bytes) {
+    chunkSize_ = qMax(1, bytes);
+}
+
+void WordBookReader::setValidation(bool validate) {
+    validate_ = validate;
+}
+
+bool WordBookReader::readFile(const QString& path, const WordHandler& handler) {
+    QString error;
+    std::unique_ptr<QIODevice> device = DecompressingDevice::openFile(path, &error);
+    if (!device) {
+        return fail(error);
+    }
+
+    return read(*device, handler);
+}
+
+bool WordBookReader::read(QIODevice& device, const WordHandler& handler) {
+    int words = 0;
+    int skipped = 0;
+
+    bool ok = readItems(device, [&](const QByteArray& item) {
+        Domain::Word word;
+        if (!parseItem(bookId_, item, word, validate_)) {
+            ++skipped;
+            return true;
+        }
+        ++words;
+        return handler(word);
+    });
+
+    wordCount_ = words;
+    skippedCount_ = skipped;
+    return ok;
+}
+
+bool WordBookReader::readItems(QIODevice& device, const ItemHandler& handler) {
+    state_ = State::BeforeArray;
+    item_.clear();
+    depth_ = 0;
+    inString_ = false;
+    escaped_ = false;
+    offset_ = 0;
+    wordCount_ = 0;
+    skippedCount_ = 0;
+    error_.clear();
+
+    for (;;) {
+        QByteArray chunk = device.read(chunkSize_);
+        if (chunk.isEmpty()) {
+            break;
+        }
+        if (!scan(chunk, handler)) {
+            return false;
+        }
+        offset_ += chunk.size();
+    }
+
+    // 解压出错时 read() 返回空，与文件结束区分开
+    auto* decompressing = qobject_cast<DecompressingDevice*>(&device);
+    if (decompressing && decompressing->hasError()) {
+        return fail(decompressing->errorString());
+    }
+
+    if (state_ != State::Done) {
+        return fail(QString("Unexpected end of JSON at byte %1").arg(offset_));
+    }
+
+    return true;
+}
+
+int WordBookReader::wordCount() const {
+    return wordCount_;
+}
+
+int WordBookReader::skippedCount() const {
+    return skippedCount_;
+}
+
+QString WordBookReader::errorString() const {
+    return error_;
+}
+
+bool WordBookReader::scan(const QByteArray& chunk, const ItemHandler& handler) {
+    const char* data = chunk.constData();
+    const int size = chunk.size();
+
+    // 元素可能跨块，块末尾把未结束的部分追加到 item_
+    int itemStart = 0;
+
+    for (int i = 0; i < size; ++i) {
+        const char c = data[i];
+
+        if (state_ == State::BeforeArray) {
+            if (isWhitespace(c) || (offset_ + i < 3 && isUtf8Bom(c))) {
+                continue;
+            }
+            if (c != '[') {
+                return fail(QString("Invalid JSON format: expected array at byte %1")
+                                .arg(offset_ + i));
+            }
+            state_ = State::BetweenItems;
+            continue;
+        }
+
+        if (state_ == State::Done) {
+            if (!isWhitespace(c)) {
+                return fail(QString("Unexpected data after array at byte %1")
+                                .arg(offset_ + i));
+            }
+            continue;
+        }
+
+        if (state_ == State::BetweenItems) {
+            if (isWhitespace(c) || c == ',') {
+                continue;
+            }
+            if (c == ']') {
+                state_ = State::Done;
+                continue;
+            }
+            state_ = State::InItem;
+            itemStart = i;
+            depth_ = 0;
+            inString_ = false;
+            escaped_ = false;
+        }
+
+        // State::InItem：只需跟踪字符串与括号深度，找到元素结尾
+        if (inString_) {
+            if (escaped_) {
+                escaped_ = false;
+            } else if (c == '\\') {
+                escaped_ = true;
+            } else if (c == '"') {
+                inString_ = false;
+            }
+            continue;
+        }
+
+        if (c == '"') {
+            inString_ = true;
+        } else if (c == '{' || c == '[') {
+            ++depth_;
+        } else if ((c == '}' || c == ']') && depth_ > 0) {
+            if (--depth_ == 0) {
+                item_.append(data + itemStart, i + 1 - itemStart);
+                state_ = State::BetweenItems;
+                if (!finishItem(handler)) {
+                    return false;
+                }
+            }
+        } else if ((c == ',' || c == ']') && depth_ == 0) {
+            // 标量元素以 ',' 或数组结尾的 ']' 结束
+            item_.append(data + itemStart, i - itemStart);
+            state_ = c == ']' ? State::Done : State::BetweenItems;
+            if (!finishItem(handler)) {
+                return false;
+            }
+        }
+    }
+
+    if (state_ == State::InItem) {
+        item_.append(data + itemStart, size - itemStart);
+    }
+
+    return true;
+}
+
+bool WordBookReader::finishItem(const ItemHandler& handler) {
+    QByteArray item;
+    item.swap(item_);
+
+    if (!handler(item)) {
+        return fail("Import aborted");
+    }
+
+    return true;
+}
+
+bool WordBookReader::fail(const QString& message) {
+    error_ = message;
+    qWarning() << message;
+    return false;
+}
+
+bool WordBookReader::parseItem(const QString& bookId, const QByteArray& item,
+                               Domain::Word& word, bool validate) {
+    Span spans[kFieldCount];
+    if (!scanObjectFields(item, spans)) {
+        return false;
+    }
+
+    const char* data = item.constData();
+
+    word = Domain::Word();
+    word.bookId = bookId;
+    word.wordId = spanToInt(data, spans[FieldId]);
+    word.word = spanToString(data, spans[FieldWord]);
+    word.phoneticUk = spanToString(data, spans[FieldPhonetic0]);
+    word.phoneticUs = spanToString(data, spans[FieldPhonetic1]);
+
+    // 嵌套字段直接保存源文件中的原始 JSON 文本，不经过 DOM 往返
+    QString* nested[] = {
+        &word.translations, &word.sentences, &word.phrases,
+        &word.synonyms, &word.relatedWords, &word.etymology
+    };
+    for (int field = FieldTrans; field < kFieldCount; ++field) {
+        const Span& span = spans[field];
+        if (!span.isValid()) {
+            continue;
+        }
+
+        const char open = field == FieldRelWords ? '{' : '[';
+        QString& target = *nested[field - FieldTrans];
+
+        // 类型不符（如 null）时与 DOM 解析的结果一致：空数组/空对象
+        if (data[span.begin] != open) {
+            target = field == FieldRelWords ? "{}" : "[]";
+            continue;
+        }
+
+        if (validate && !isValidJson(data, span)) {
+            return false;
+        }
+        target = QString::fromUtf8(data + span.begin, span.end - span.begin);
+    }
+
+    // 简释与结构化字段在解析线程上生成，写入线程不再解析 JSON
+    word.parseStructuredFields();
+    return word.isValid();
+}
+
+} // namespace Application
+} // namespace WordMaster
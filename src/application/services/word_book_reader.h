@@ -0,0 +1,129 @@
+#ifndef WORDMASTER_APPLICATION_WORD_BOOK_READER_H
+#define WORDMASTER_APPLICATION_WORD_BOOK_READER_H
+
+#include "domain/entities.h"
+#include <QString>
+#include <QByteArray>
+#include <QIODevice>
+#include <functional>
+
+namespace WordMaster {
+namespace Application {
+
+/**
+ * @brief 单词 JSON 流式读取器
+ *
+ * 词库文件是一个顶层数组，每个元素是一个单词对象。
+ * 读取器按块读取文件，逐字节找出每个数组元素的边界，
+ * 解析出一个 Word 就交给回调。内存占用取决于单个单词的大小，与词库大小无关。
+ *
+ * 单词对象只扫描第一层字段：释义、例句等嵌套字段直接截取源文件中的
+ * 原始 JSON 文本保存，不构建 DOM 再序列化。是否校验嵌套 JSON 可选。
+ *
+ *     WordBookReader reader("cet4");
+ *     reader.readFile(path, [&](const Domain::Word& word) {
+ *         chunk.append(word);
+ *         return chunk.size() < 1000 || flushChunk();
+ *     });
+ *
+ * readItems() 只切分不解析，交出每个元素的原始字节，
+ * 解析（parseItem）可以放到其他线程进行。
+ */
+class WordBookReader {
+public:
+    // 返回false时停止读取（如写库失败）
+    using WordHandler = std::function<bool(const Domain::Word&)>;
+    using ItemHandler = std::function<bool(const QByteArray&)>;
+
+    // 默认每次从设备读取的字节数
+    static const int kDefaultChunkSize = 64 * 1024;
+
+    explicit WordBookReader(const QString& bookId);
+
+    /**
+     * @brief 设置每次读取的字节数（测试中用很小的块覆盖跨块边界）
+     */
+    void setChunkSize(int bytes);
+
+    /**
+     * @brief 是否校验嵌套字段是合法 JSON（默认不校验；校验失败的单词被跳过）
+     */
+    void setValidation(bool validate);
+
+    /**
+     * @brief 读取词库文件（.json.gz / .json.zst 流式解压，见 DecompressingDevice）
+     * @return 完整读完且回调未中止返回true
+     */
+    bool readFile(const QString& path, const WordHandler& handler);
+
+    /**
+     * @brief 从已打开的设备读取
+     */
+    bool read(QIODevice& device, const WordHandler& handler);
+
+    /**
+     * @brief 只切分数组元素，把每个元素的原始字节交给回调
+     *
+     * 不更新 wordCount()/skippedCount()。
+     */
+    bool readItems(QIODevice& device, const ItemHandler& handler);
+
+    /**
+     * @brief 已交给回调的单词数
+     */
+    int wordCount() const;
+
+    /**
+     * @brief 跳过的元素数（不是对象、JSON 错误或缺少必要字段）
+     */
+    int skippedCount() const;
+
+    /**
+     * @brief 失败原因
+     */
+    QString errorString() const;
+
+    /**
+     * @brief 解析 readItems() 交出的一个元素（可在任意线程调用）
+     * @param validate 是否校验嵌套字段
+     * @return 元素是有效的单词对象返回true
+     */
+    static bool parseItem(const QString& bookId, const QByteArray& item,
+                          Domain::Word& word, bool validate = false);
+
+private:
+    enum class State {
+        BeforeArray,    // 等待顶层 '['
+        BetweenItems,   // 数组内，等待下一个元素或 ']'
+        InItem,         // 正在读取一个元素
+        Done            // 已读到顶层 ']'
+    };
+
+    // 扫描一块数据；回调中止或格式错误时返回false
+    bool scan(const QByteArray& chunk, const ItemHandler& handler);
+
+    // 一个元素读取完毕
+    bool finishItem(const ItemHandler& handler);
+
+    bool fail(const QString& message);
+
+    QString bookId_;
+    int chunkSize_;
+    bool validate_;
+
+    State state_;
+    QByteArray item_;       // 当前元素的字节
+    int depth_;             // 当前元素内的括号深度
+    bool inString_;
+    bool escaped_;
+    qint64 offset_;         // 已扫描的字节数（用于错误信息）
+
+    int wordCount_;
+    int skippedCount_;
+    QString error_;
+};
+
+} // namespace Application
+} // namespace WordMaster
+
+#endif // WORDMASTER_APPLICATION_WORD_BOOK_READER_H
@@ -0,0 +1,401 @@
+#include "word_pack.h"
+#include "word_book_reader.h"
+#include <QSaveFile>
+#include <QHash>
+#include <QVector>
+#include <QPair>
+#include <QtEndian>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace WordMaster {
+namespace Application {
+
+namespace {
+
+const char kMagic[8] = { 'W', 'M', 'P', 'A', 'C', 'K', '\0', '\0' };
+
+// 头部字段偏移
+const int kVersionOffset = 8;
+const int kCountOffset = 12;
+const int kRecordSizeOffset = 16;
+const int kRecordsOffset = 24;
+const int kIndexOffset = 32;
+const int kStringsOffset = 40;
+const int kStringsSizeOffset = 48;
+const int kFileSizeOffset = 56;
+
+// 记录字段偏移
+const int kHashOffset = 4;
+const int kHashSize = 20;
+const int kFieldsOffset = kHashOffset + kHashSize;
+
+// 不超过该长度的字符串去重（长字符串几乎不重复，不值得占用哈希表）
+const int kInternMaxLength = 64;
+
+quint32 readU32(const uchar* p) {
+    return qFromLittleEndian<quint32>(p);
+}
+
+quint64 readU64(const uchar* p) {
+    return qFromLittleEndian<quint64>(p);
+}
+
+void writeU32(uchar* p, quint32 value) {
+    qToLittleEndian(value, p);
+}
+
+void writeU64(uchar* p, quint64 value) {
+    qToLittleEndian(value, p);
+}
+
+/**
+ * @brief 编译过程中的字符串表
+ */
+class StringTable {
+public:
+    // 返回false表示超出 32 位偏移
+    bool add(const QString& text, quint32& offset, quint32& length) {
+        QByteArray utf8 = text.toUtf8();
+        length = static_cast<quint32>(utf8.size());
+        offset = 0;
+        if (utf8.isEmpty()) {
+            return true;
+        }
+
+        const bool intern = utf8.size() <= kInternMaxLength;
+        if (intern) {
+            auto it = offsets_.constFind(utf8);
+            if (it != offsets_.constEnd()) {
+                offset = it.value();
+                return true;
+            }
+        }
+
+        if (static_cast<quint64>(data_.size()) + utf8.size() > 0xFFFFFFFFu) {
+            return false;
+        }
+        offset = static_cast<quint32>(data_.size());
+        data_.append(utf8);
+        if (intern) {
+            offsets_.insert(utf8, offset);
+        }
+        return true;
+    }
+
+    const QByteArray& data() const { return data_; }
+
+private:
+    QByteArray data_;
+    QHash<QByteArray, quint32> offsets_;
+};
+
+} // namespace
+
+bool WordPack::isPackPath(const QString& path) {
+    return path.endsWith(".wmpack", Qt::CaseInsensitive);
+}
+
+WordPack::WordPack()
+    : data_(nullptr)
+    , size_(0)
+    , count_(0)
+    , records_(nullptr)
+    , index_(nullptr)
+    , strings_(nullptr)
+    , stringsSize_(0)
+{
+}
+
+WordPack::~WordPack() {
+    close();
+}
+
+bool WordPack::open(const QString& path) {
+    close();
+    error_.clear();
+
+    file_.reset(new QFile(path));
+    if (!file_->open(QIODevice::ReadOnly)) {
+        return fail(QString("Failed to open file: %1").arg(path));
+    }
+
+    size_ = file_->size();
+    if (size_ < kHeaderSize) {
+        return fail("Truncated word pack header");
+    }
+
+    data_ = file_->map(0, size_);
+    if (!data_) {
+        return fail(QString("Failed to map word pack: %1").arg(file_->errorString()));
+    }
+
+    if (memcmp(data_, kMagic, sizeof(kMagic)) != 0) {
+        return fail("Not a word pack");
+    }
+    if (readU32(data_ + kVersionOffset) != kVersion) {
+        return fail(QString("Unsupported word pack version %1").arg(readU32(data_ + kVersionOffset)));
+    }
+    if (readU32(data_ + kRecordSizeOffset) != static_cast<quint32>(kRecordSize)) {
+        return fail("Unexpected word pack record size");
+    }
+
+    const quint64 size = static_cast<quint64>(size_);
+    const quint64 count = readU32(data_ + kCountOffset);
+    const quint64 recordsOffset = readU64(data_ + kRecordsOffset);
+    const quint64 indexOffset = readU64(data_ + kIndexOffset);
+    const quint64 stringsOffset = readU64(data_ + kStringsOffset);
+    const quint64 stringsSize = readU64(data_ + kStringsSizeOffset);
+
+    // 各区都必须完整落在文件内（先比较再相加，避免溢出）
+    auto fits = [size](quint64 offset, quint64 length) {
+        return offset <= size && length <= size - offset;
+    };
+    if (readU64(data_ + kFileSizeOffset) != size
+        || count > static_cast<quint64>(std::numeric_limits<int>::max())
+        || !fits(recordsOffset, count * kRecordSize)
+        || !fits(indexOffset, count * kIndexEntrySize)
+        || !fits(stringsOffset, stringsSize)) {
+        return fail("Corrupt word pack layout");
+    }
+
+    count_ = static_cast<int>(count);
+    records_ = data_ + recordsOffset;
+    index_ = data_ + indexOffset;
+    strings_ = data_ + stringsOffset;
+    stringsSize_ = stringsSize;
+
+    // 一次性校验所有引用，之后的读取无需再检查边界
+    for (int i = 0; i < count_; ++i) {
+        const uchar* entry = record(i);
+        for (int field = 0; field < kFieldCount; ++field) {
+            quint64 offset = readU32(entry + kFieldsOffset + field * 8);
+            quint64 length = readU32(entry + kFieldsOffset + field * 8 + 4);
+            if (offset + length > stringsSize_) {
+                return fail(QString("Corrupt string reference in record %1").arg(i));
+            }
+        }
+
+        const uchar* indexEntry = index_ + static_cast<qint64>(i) * kIndexEntrySize;
+        if (readU32(indexEntry + 4) >= count
+            || (i > 0 && static_cast<qint32>(readU32(indexEntry))
+                         <= static_cast<qint32>(readU32(indexEntry - kIndexEntrySize)))) {
+            return fail(QString("Corrupt index entry %1").arg(i));
+        }
+    }
+
+    return true;
+}
+
+void WordPack::close() {
+    if (file_) {
+        if (data_) {
+            file_->unmap(const_cast<uchar*>(data_));
+        }
+        file_.reset();
+    }
+
+    data_ = nullptr;
+    size_ = 0;
+    count_ = 0;
+    records_ = nullptr;
+    index_ = nullptr;
+    strings_ = nullptr;
+    stringsSize_ = 0;
+}
+
+bool WordPack::isOpen() const {
+    return records_ != nullptr;
+}
+
+QString WordPack::errorString() const {
+    return error_;
+}
+
+int WordPack::count() const {
+    return count_;
+}
+
+int WordPack::wordIdAt(int index) const {
+    return static_cast<qint32>(readU32(record(index)));
+}
+
+QByteArray WordPack::contentHashAt(int index) const {
+    return QByteArray(reinterpret_cast<const char*>(record(index) + kHashOffset), kHashSize);
+}
+
+Domain::Word WordPack::wordAt(int index, const QString& bookId) const {
+    const uchar* entry = record(index);
+
+    Domain::Word word;
+    word.bookId = bookId;
+    word.wordId = static_cast<qint32>(readU32(entry));
+    word.word = text(entry, FieldWord);
+    word.phoneticUk = text(entry, FieldPhoneticUk);
+    word.phoneticUs = text(entry, FieldPhoneticUs);
+    word.translations = text(entry, FieldTranslations);
+    word.sentences = text(entry, FieldSentences);
+    word.phrases = text(entry, FieldPhrases);
+    word.synonyms = text(entry, FieldSynonyms);
+    word.relatedWords = text(entry, FieldRelatedWords);
+    word.etymology = text(entry, FieldEtymology);
+    return word;
+}
+
+int WordPack::indexOf(int wordId) const {
+    int low = 0;
+    int high = count_ - 1;
+
+    while (low <= high) {
+        int mid = low + (high - low) / 2;
+        const uchar* entry = index_ + static_cast<qint64>(mid) * kIndexEntrySize;
+        qint32 id = static_cast<qint32>(readU32(entry));
+        if (id == wordId) {
+            return static_cast<int>(readU32(entry + 4));
+        }
+        if (id < wordId) {
+            low = mid + 1;
+        } else {
+            high = mid - 1;
+        }
+    }
+
+    return -1;
+}
+
+const uchar* WordPack::record(int index) const {
+    return records_ + static_cast<qint64>(index) * kRecordSize;
+}
+
+QString WordPack::text(const uchar* record, Field field) const {
+    quint32 offset = readU32(record + kFieldsOffset + field * 8);
+    quint32 length = readU32(record + kFieldsOffset + field * 8 + 4);
+    return QString::fromUtf8(reinterpret_cast<const char*>(strings_ + offset),
+                             static_cast<int>(length));
+}
+
+bool WordPack::fail(const QString& message) {
+    error_ = message;
+    close();
+    return false;
+}
+
+bool WordPack::compile(const QString& jsonPath, const QString& packPath,
+                       QString* error, int* wordCount) {
+    auto failWith = [error](const QString& message) {
+        if (error) {
+            *error = message;
+        }
+        return false;
+    };
+
+    QVector<QByteArray> records;
+    QHash<int, int> recordByWordId;
+    StringTable strings;
+    bool overflow = false;
+
+    // 包内不保存词库ID，读取器只需要一个非空ID使单词有效
+    WordBookReader reader("pack");
+    bool ok = reader.readFile(jsonPath, [&](const Domain::Word& word) {
+        QByteArray entry(kRecordSize, '\0');
+        uchar* p = reinterpret_cast<uchar*>(entry.data());
+
+        writeU32(p, static_cast<quint32>(word.wordId));
+        QByteArray hash = word.contentHash();
+        memcpy(p + kHashOffset, hash.constData(), kHashSize);
+
+        const QString* fields[kFieldCount] = {
+            &word.word, &word.phoneticUk, &word.phoneticUs, &word.translations,
+            &word.sentences, &word.phrases, &word.synonyms, &word.relatedWords,
+            &word.etymology
+        };
+        for (int field = 0; field < kFieldCount; ++field) {
+            quint32 offset = 0;
+            quint32 length = 0;
+            if (!strings.add(*fields[field], offset, length)) {
+                overflow = true;
+                return false;
+            }
+            writeU32(p + kFieldsOffset + field * 8, offset);
+            writeU32(p + kFieldsOffset + field * 8 + 4, length);
+        }
+
+        // 重复的 word_id 以后出现的为准（与导入一致）
+        auto it = recordByWordId.constFind(word.wordId);
+        if (it != recordByWordId.constEnd()) {
+            records[it.value()] = entry;
+        } else {
+            recordByWordId.insert(word.wordId, records.size());
+            records.append(entry);
+        }
+        return true;
+    });
+
+    if (overflow) {
+        return failWith("Word pack string table exceeds 4 GB");
+    }
+    if (!ok) {
+        return failWith(reader.errorString());
+    }
+    if (records.isEmpty()) {
+        return failWith("No words found");
+    }
+
+    // 偏移索引按 word_id 升序
+    QVector<QPair<qint32, quint32>> index;
+    index.reserve(records.size());
+    for (auto it = recordByWordId.constBegin(); it != recordByWordId.constEnd(); ++it) {
+        index.append(qMakePair(static_cast<qint32>(it.key()), static_cast<quint32>(it.value())));
+    }
+    std::sort(index.begin(), index.end());
+
+    const quint64 count = static_cast<quint64>(records.size());
+    const quint64 recordsOffset = kHeaderSize;
+    const quint64 indexOffset = recordsOffset + count * kRecordSize;
+    const quint64 stringsOffset = indexOffset + count * kIndexEntrySize;
+    const quint64 fileSize = stringsOffset + static_cast<quint64>(strings.data().size());
+
+    uchar header[kHeaderSize] = {};
+    memcpy(header, kMagic, sizeof(kMagic));
+    writeU32(header + kVersionOffset, kVersion);
+    writeU32(header + kCountOffset, static_cast<quint32>(count));
+    writeU32(header + kRecordSizeOffset, kRecordSize);
+    writeU64(header + kRecordsOffset, recordsOffset);
+    writeU64(header + kIndexOffset, indexOffset);
+    writeU64(header + kStringsOffset, stringsOffset);
+    writeU64(header + kStringsSizeOffset, static_cast<quint64>(strings.data().size()));
+    writeU64(header + kFileSizeOffset, fileSize);
+
+    QByteArray indexData(static_cast<int>(count * kIndexEntrySize), '\0');
+    uchar* indexPtr = reinterpret_cast<uchar*>(indexData.data());
+    for (const auto& entry : index) {
+        writeU32(indexPtr, static_cast<quint32>(entry.first));
+        writeU32(indexPtr + 4, entry.second);
+        indexPtr += kIndexEntrySize;
+    }
+
+    QSaveFile file(packPath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return failWith(QString("Failed to create file: %1").arg(packPath));
+    }
+
+    file.write(reinterpret_cast<const char*>(header), kHeaderSize);
+    for (const QByteArray& entry : records) {
+        file.write(entry);
+    }
+    file.write(indexData);
+    file.write(strings.data());
+
+    if (!file.commit()) {
+        return failWith(QString("Failed to write word pack: %1").arg(file.errorString()));
+    }
+
+    if (wordCount) {
+        *wordCount = records.size();
+    }
+    return true;
+}
+
+} // namespace Application
+} // namespace WordMaster
@@ -0,0 +1,118 @@
+#ifndef WORDMASTER_APPLICATION_WORD_PACK_H
+#define WORDMASTER_APPLICATION_WORD_PACK_H
+
+#include "domain/entities.h"
+#include <QString>
+#include <QByteArray>
+#include <QFile>
+#include <memory>
+
+namespace WordMaster {
+namespace Application {
+
+/**
+ * @brief 预编译的二进制词库包（.wmpack）
+ *
+ * 由 wordmaster_cli --compile-pack 从词库 JSON 生成，导入时不再解析 JSON。
+ * 所有整数均为小端序：
+ *
+ *     头部（64 字节）   magic "WMPACK\0\0"、版本、单词数、各区偏移
+ *     单词记录          每条 96 字节：word_id、内容哈希（SHA-1）、9 个字符串引用
+ *     偏移索引          (word_id, 记录下标)，按 word_id 升序，用于二分查找
+ *     字符串表          UTF-8，相同的字符串只存一份（大量 "[]"）
+ *
+ * 内容哈希与 Word::contentHash() 一致，增量导入可直接比较而不解码字符串。
+ * 打开时整个文件以只读 mmap 映射，读取单词只是定位和 UTF-8 解码。
+ */
+class WordPack {
+public:
+    static const quint32 kVersion = 1;
+    static const int kHeaderSize = 64;
+    static const int kRecordSize = 96;
+    static const int kIndexEntrySize = 8;
+
+    /**
+     * @brief 按扩展名判断是否为词库包
+     */
+    static bool isPackPath(const QString& path);
+
+    WordPack();
+    ~WordPack();
+
+    WordPack(const WordPack&) = delete;
+    WordPack& operator=(const WordPack&) = delete;
+
+    /**
+     * @brief 映射并校验词库包（版本、各区范围、所有字符串引用）
+     */
+    bool open(const QString& path);
+    void close();
+
+    bool isOpen() const;
+    QString errorString() const;
+
+    int count() const;
+
+    /**
+     * @brief 第 index 条记录的原始ID
+     */
+    int wordIdAt(int index) const;
+
+    /**
+     * @brief 第 index 条记录的内容哈希（20 字节）
+     */
+    QByteArray contentHashAt(int index) const;
+
+    /**
+     * @brief 解码第 index 条记录
+     */
+    Domain::Word wordAt(int index, const QString& bookId) const;
+
+    /**
+     * @brief 按原始ID查找记录下标，不存在返回-1
+     */
+    int indexOf(int wordId) const;
+
+    /**
+     * @brief 把词库 JSON（可为 .gz/.zst）编译为词库包
+     *
+     * 同一 word_id 重复出现时以后出现的为准；写入临时文件后原子替换。
+     * @param wordCount 输出：写入的单词数
+     */
+    static bool compile(const QString& jsonPath, const QString& packPath,
+                        QString* error = nullptr, int* wordCount = nullptr);
+
+private:
+    // 9 个字符串字段在记录中的顺序
+    enum Field {
+        FieldWord,
+        FieldPhoneticUk,
+        FieldPhoneticUs,
+        FieldTranslations,
+        FieldSentences,
+        FieldPhrases,
+        FieldSynonyms,
+        FieldRelatedWords,
+        FieldEtymology,
+        kFieldCount
+    };
+
+    const uchar* record(int index) const;
+    QString text(const uchar* record, Field field) const;
+    bool fail(const QString& message);
+
+    std::unique_ptr<QFile> file_;
+    const uchar* data_;
+    qint64 size_;
+    int count_;
+    const uchar* records_;
+    const uchar* index_;
+    const uchar* strings_;
+    quint64 stringsSize_;
+    QString error_;
+};
+
+} // namespace Application
+} // namespace WordMaster
+
+#endif // WORDMASTER_APPLICATION_WORD_PACK_H
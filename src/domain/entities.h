@@ -3,8 +3,14 @@
 
 #include <QString>
 #include <QStringList>
+#include <QList>
 #include <QDateTime>
 #include <QDate>
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QJsonObject>
 
 namespace WordMaster {
 namespace Domain {
@@ -32,6 +38,81 @@ struct Book {
     }
 };
 
+// ============================================
+// 单词结构化字段 - 由 JSON 字段解析，存于子表
+// ============================================
+struct WordTranslation {
+    QString pos;                    // 词性，如 "v."
+    QString meaning;                // 中文释义
+    
+    /**
+     * @brief 解析 trans 数组：{"pos", "cn"}（部分词库为 "tranCn"）
+     */
+    static QList<WordTranslation> listFromJson(const QString& json) {
+        QList<WordTranslation> items;
+        if (json.size() <= 2) {             // 空或 "[]"
+            return items;
+        }
+        for (const QJsonValue& value : QJsonDocument::fromJson(json.toUtf8()).array()) {
+            QJsonObject object = value.toObject();
+            WordTranslation item;
+            item.pos = object.value("pos").toString();
+            item.meaning = object.value("cn").toString();
+            if (item.meaning.isEmpty()) {
+                item.meaning = object.value("tranCn").toString();
+            }
+            items.append(item);
+        }
+        return items;
+    }
+};
+
+struct WordSentence {
+    QString english;                // 例句原文
+    QString chinese;                // 例句译文
+    
+    /**
+     * @brief 解析 sentences 数组：{"c", "cn"}
+     */
+    static QList<WordSentence> listFromJson(const QString& json) {
+        QList<WordSentence> items;
+        if (json.size() <= 2) {
+            return items;
+        }
+        for (const QJsonValue& value : QJsonDocument::fromJson(json.toUtf8()).array()) {
+            QJsonObject object = value.toObject();
+            WordSentence item;
+            item.english = object.value("c").toString();
+            item.chinese = object.value("cn").toString();
+            items.append(item);
+        }
+        return items;
+    }
+};
+
+struct WordPhrase {
+    QString phrase;                 // 短语
+    QString meaning;                // 短语释义
+    
+    /**
+     * @brief 解析 phrases 数组：{"c", "cn"}
+     */
+    static QList<WordPhrase> listFromJson(const QString& json) {
+        QList<WordPhrase> items;
+        if (json.size() <= 2) {
+            return items;
+        }
+        for (const QJsonValue& value : QJsonDocument::fromJson(json.toUtf8()).array()) {
+            QJsonObject object = value.toObject();
+            WordPhrase item;
+            item.phrase = object.value("c").toString();
+            item.meaning = object.value("cn").toString();
+            items.append(item);
+        }
+        return items;
+    }
+};
+
 // ============================================
 // Word Entity - 单词实体
 // ============================================
@@ -42,6 +123,7 @@ struct Word {
     QString word;                   // 单词
     QString phoneticUk;             // 英式音标
     QString phoneticUs;             // 美式音标
+    QString gloss;                  // 简释：首条中文释义（列表视图用，存于 words 热数据）
     QString translations;           // JSON字符串：trans数组
     QString sentences;              // JSON字符串：sentences数组
     QString phrases;                // JSON字符串：phrases数组
@@ -50,13 +132,100 @@ struct Word {
     QString etymology;              // JSON字符串：etymology数组
     QDateTime createdAt;            // 创建时间
     
+    // 以上 JSON 字段存于 word_details，按 WordProjection::Summary 查询时为空
+    
+    // 结构化字段：导入时由 JSON 字段解析，写入 word_translations 等子表；
+    // 查询单词时不填充，按需用 IWordRepository::getTranslations() 等读取
+    QList<WordTranslation> translationItems;
+    QList<WordSentence> sentenceItems;
+    QList<WordPhrase> phraseItems;
+    
+    // 简释的最大长度（字符）
+    static const int kGlossMaxLength = 40;
+    
     Word() : id(0), wordId(0) {}
     
     bool isValid() const {
         return !word.isEmpty() && !bookId.isEmpty();
     }
+    
+    /**
+     * @brief 从 trans 数组提取简释：第一条的中文释义，最多 kGlossMaxLength 个字符
+     */
+    static QString glossFromTranslations(const QString& translations) {
+        return glossOf(WordTranslation::listFromJson(translations));
+    }
+    
+    static QString glossOf(const QList<WordTranslation>& items) {
+        return items.isEmpty() ? QString() : items.first().meaning.trimmed().left(kGlossMaxLength);
+    }
+    
+    /**
+     * @brief 解析 JSON 字段，填充结构化字段与简释（导入时在解析线程上调用）
+     */
+    void parseStructuredFields() {
+        translationItems = WordTranslation::listFromJson(translations);
+        sentenceItems = WordSentence::listFromJson(sentences);
+        phraseItems = WordPhrase::listFromJson(phrases);
+        gloss = glossOf(translationItems);
+    }
+    
+    /**
+     * @brief 内容哈希（SHA-1），增量导入时比较单词是否变化
+     * 
+     * 覆盖来自词库文件的全部内容字段，不含 id/bookId/wordId/createdAt。
+     * 每个字段带长度前缀，字段边界不会混淆。
+     */
+    QByteArray contentHash() const {
+        QCryptographicHash hash(QCryptographicHash::Sha1);
+        for (const QString* field : {&word, &phoneticUk, &phoneticUs, &translations,
+                                     &sentences, &phrases, &synonyms, &relatedWords,
+                                     &etymology}) {
+            QByteArray utf8 = field->toUtf8();
+            hash.addData(QByteArray::number(utf8.size()) + ':');
+            hash.addData(utf8);
+        }
+        return hash.result();
+    }
+};
+
+// ============================================
+// WordFingerprint - 已导入单词的标识与内容哈希
+// ============================================
+struct WordFingerprint {
+    int id;                         // 数据库自增ID
+    int wordId;                     // JSON中的原始ID
+    QByteArray contentHash;         // 为空表示导入时尚未记录哈希
+    
+    WordFingerprint() : id(0), wordId(0) {}
+};
+
+// ============================================
+// WordSearchHit - 全文搜索结果
+// ============================================
+struct WordSearchHit {
+    // snippet 中命中词的起止标记（控制字符，不会出现在词库文本中）
+    static const QChar kMatchBegin;
+    static const QChar kMatchEnd;
+    
+    Word word;                      // Summary 投影
+    QString snippet;                // 命中片段（单词、释义、例句或短语），命中词由标记包围
+    double score;                   // 相关度，越小越相关（bm25）
+    
+    WordSearchHit() : score(0.0) {}
+    
+    // 把命中标记替换为 open / close（如 "<b>"、"</b>"；显示为 HTML 时先转义 snippet）
+    static QString highlight(const QString& snippet, const QString& open, const QString& close) {
+        QString text = snippet;
+        text.replace(kMatchBegin, open);
+        text.replace(kMatchEnd, close);
+        return text;
+    }
 };
 
+inline const QChar WordSearchHit::kMatchBegin = QChar(0x02);
+inline const QChar WordSearchHit::kMatchEnd = QChar(0x03);
+
 // ============================================
 // StudyRecord Entity - 学习记录实体
 // ============================================
@@ -4,7 +4,7 @@
 #include "entities.h"
 #include <QList>
 #include <QDate>
-#include <QMAP>
+#include <QMap>
 #include <QString>
 #include <memory>
 
@@ -25,6 +25,9 @@ public:
     virtual bool remove(const QString& id) = 0;
     virtual bool exists(const QString& id) = 0;
     
+    // 原地更新元数据（save 是 INSERT OR REPLACE，会级联删除已有单词）
+    virtual bool update(const Book& book) = 0;
+    
     // 查询
     virtual QList<Book> getByCategory(const QString& category) = 0;
     virtual Book getActiveBook() = 0;
@@ -39,30 +42,71 @@ public:
 // ============================================
 // IWordRepository - 单词仓储接口
 // ============================================
+/**
+ * @brief 单词查询读取的字段
+ */
+enum class WordProjection {
+    Summary,    // 热数据：id、词库、原始ID、单词、音标、简释（列表视图）
+    Full        // 另外读取 word_details 中的释义、例句等 JSON 字段
+};
+
 class IWordRepository {
 public:
     virtual ~IWordRepository() = default;
     
     // 基本CRUD
     virtual bool save(const Word& word) = 0;
-    virtual Word getById(int id) = 0;
-    virtual QList<Word> getByIds(const QList<int>& ids) = 0;
+    virtual Word getById(int id, WordProjection projection = WordProjection::Full) = 0;
+    // 按 ids 的顺序返回；重复的 id 只返回一次，不存在的 id 跳过；不限 id 数量
+    virtual QList<Word> getByIds(const QList<int>& ids,
+                                 WordProjection projection = WordProjection::Full) = 0;
     virtual bool remove(int id) = 0;
     virtual bool exists(int id) = 0;
     
+    // 按 id 原地更新内容（id 不变，学习记录、复习计划、标签随之保留）
+    virtual bool update(const Word& word) = 0;
+    
+    // 补读 Summary 查询未包含的 JSON 字段（按 word.id）
+    virtual bool loadDetails(Word& word) = 0;
+    
+    // 结构化字段（按 word.id，保持词库文件中的顺序）
+    virtual QList<WordTranslation> getTranslations(int wordId) = 0;
+    virtual QList<WordSentence> getSentences(int wordId) = 0;
+    virtual QList<WordPhrase> getPhrases(int wordId) = 0;
+    
     // 查询
-    virtual QList<Word> getByBookId(const QString& bookId, int limit = -1, int offset = 0) = 0;
-    virtual QList<Word> searchByWord(const QString& word) = 0;
+    virtual QList<Word> getByBookId(const QString& bookId, int limit = -1, int offset = 0,
+                                    WordProjection projection = WordProjection::Full) = 0;
+    // 按前缀搜索（ASCII 不区分大小写），最多返回 50 条
+    virtual QList<Word> searchByWord(const QString& word,
+                                     WordProjection projection = WordProjection::Full) = 0;
+    // 全文搜索单词、释义、例句与短语（中文按字匹配），按相关度排序；bookId 为空时搜索全部词库。
+    // 不支持全文索引时回退为只匹配单词与简释
+    virtual QList<WordSearchHit> search(const QString& text, const QString& bookId = QString(),
+                                        int limit = 50) = 0;
     virtual Word getByBookAndWord(const QString& bookId, const QString& word) = 0;
+    // 词库内全部单词的 id、原始ID与内容哈希（增量导入用，不读取内容）
+    virtual QList<WordFingerprint> getFingerprints(const QString& bookId) = 0;
+    // 词库中有任一释义属于 posList 中词性的单词 id（升序），如 {"v.", "vt.", "vi."}
+    virtual QList<int> getWordIdsByPos(const QString& bookId, const QStringList& posList) = 0;
     
     // 批量操作
     virtual bool saveBatch(const QList<Word>& words) = 0;
     virtual bool removeByBookId(const QString& bookId) = 0;
-    
+    // 压缩词库的 JSON 字段（按词库训练字典），读取时透明解压；之后写入的单词保持未压缩，
+    // 可再次调用。实现不支持压缩时返回false
+    virtual bool compressDetails(const QString& bookId) = 0;
+
     // 事务支持
     virtual bool beginTransaction() = 0;
     virtual bool commit() = 0;
     virtual bool rollback() = 0;
+    
+    // 批量导入模式：代替 beginTransaction/commit/rollback 包裹一次大批量写入。
+    // 期间暂停二级索引维护，提交时一次性去重并重建；提交失败或回滚后恢复原状
+    virtual bool beginBulkLoad() = 0;
+    virtual bool commitBulkLoad() = 0;
+    virtual bool rollbackBulkLoad() = 0;
 };
 
 // ============================================
@@ -0,0 +1,228 @@
+#include "connection_manager.h"
+#include <QThread>
+#include <QSemaphore>
+#include <QMutexLocker>
+#include <QDebug>
+
+namespace WordMaster {
+namespace Infrastructure {
+
+// ============================================
+// ReaderThread - 持有一个只读连接的读线程
+// ============================================
+class ConnectionManager::ReaderThread : public QThread {
+public:
+    ReaderThread(ConnectionManager& manager, QSemaphore& ready)
+        : manager_(manager)
+        , ready_(ready)
+        , opened_(false)
+    {
+    }
+
+    bool isOpened() const {
+        return opened_;
+    }
+
+protected:
+    void run() override {
+        // 连接必须在本线程中创建和销毁
+        SQLiteAdapter adapter(manager_.dbPath_);
+        adapter.setReadOnly(true);
+        adapter.setStorageProfile(manager_.profile_);
+        opened_ = adapter.open();
+        ready_.release();
+
+        if (!opened_) {
+            qWarning() << "Failed to open reader connection:" << manager_.dbPath_;
+            return;
+        }
+
+        ReadJob job;
+        while (manager_.takeJob(job)) {
+            job(adapter);
+            job = nullptr;
+
+            // 释放读快照，下一个任务能看到最新提交
+            adapter.resetStatements();
+            manager_.finishJob();
+        }
+
+        adapter.close();
+    }
+
+private:
+    ConnectionManager& manager_;
+    QSemaphore& ready_;
+    bool opened_;
+};
+
+// ============================================
+// ConnectionManager
+// ============================================
+ConnectionManager::ConnectionManager(const QString& dbPath, int readerCount)
+    : dbPath_(dbPath)
+    , requestedReaders_(qMax(0, readerCount))
+    , profile_(StorageProfile::desktop())
+    , writer_(std::make_unique<SQLiteAdapter>(dbPath))
+    , runningJobs_(0)
+    , stopping_(false)
+{
+}
+
+ConnectionManager::~ConnectionManager() {
+    close();
+}
+
+bool ConnectionManager::open() {
+    if (isOpen()) {
+        return true;
+    }
+
+    // 先打开写连接：创建数据库文件并切换到 WAL 模式
+    if (!writer_->open()) {
+        return false;
+    }
+
+    startReaders();
+    return true;
+}
+
+bool ConnectionManager::setStorageProfile(const StorageProfile& profile) {
+    profile_ = profile;
+
+    if (!isOpen()) {
+        return writer_->setStorageProfile(profile);
+    }
+
+    // 读连接的 PRAGMA 只能在读线程中执行，直接重建读线程
+    bool ok = writer_->setStorageProfile(profile);
+    stopReaders();
+    startReaders();
+    return ok;
+}
+
+StorageProfile ConnectionManager::storageProfile() const {
+    return profile_;
+}
+
+void ConnectionManager::close() {
+    stopReaders();
+
+    if (writer_->isOpen()) {
+        writer_->close();
+    }
+}
+
+bool ConnectionManager::isOpen() const {
+    return writer_->isOpen();
+}
+
+SQLiteAdapter& ConnectionManager::writer() {
+    return *writer_;
+}
+
+int ConnectionManager::readerCount() const {
+    return readers_.size();
+}
+
+void ConnectionManager::submitRead(ReadJob job) {
+    if (!job) {
+        return;
+    }
+
+    if (readers_.isEmpty()) {
+        job(*writer_);
+        return;
+    }
+
+    QMutexLocker locker(&mutex_);
+    jobs_.enqueue(std::move(job));
+    jobAvailable_.wakeOne();
+}
+
+void ConnectionManager::waitForReads() {
+    QMutexLocker locker(&mutex_);
+    while (!jobs_.isEmpty() || runningJobs_ > 0) {
+        jobsDone_.wait(&mutex_);
+    }
+}
+
+bool ConnectionManager::takeJob(ReadJob& job) {
+    QMutexLocker locker(&mutex_);
+    while (jobs_.isEmpty() && !stopping_) {
+        jobAvailable_.wait(&mutex_);
+    }
+
+    // 关闭时仍会先执行完队列中剩余的任务
+    if (jobs_.isEmpty()) {
+        return false;
+    }
+
+    job = jobs_.dequeue();
+    ++runningJobs_;
+    return true;
+}
+
+void ConnectionManager::finishJob() {
+    QMutexLocker locker(&mutex_);
+    --runningJobs_;
+    if (jobs_.isEmpty() && runningJobs_ == 0) {
+        jobsDone_.wakeAll();
+    }
+}
+
+void ConnectionManager::startReaders() {
+    // 内存数据库每个连接都是独立的库，不能共享
+    if (dbPath_ == ":memory:" || requestedReaders_ == 0) {
+        return;
+    }
+
+    QSemaphore ready;
+    QList<ReaderThread*> started;
+    for (int i = 0; i < requestedReaders_; ++i) {
+        auto* reader = new ReaderThread(*this, ready);
+        reader->start();
+        started.append(reader);
+    }
+
+    // 等待所有读连接完成打开
+    ready.acquire(started.size());
+
+    for (ReaderThread* reader : started) {
+        if (reader->isOpened()) {
+            readers_.append(reader);
+        } else {
+            reader->wait();
+            delete reader;
+        }
+    }
+
+    qDebug() << "Connection manager opened:" << dbPath_
+             << "readers:" << readers_.size()
+             << "profile:" << profile_.name;
+}
+
+void ConnectionManager::stopReaders() {
+    if (readers_.isEmpty()) {
+        return;
+    }
+
+    {
+        QMutexLocker locker(&mutex_);
+        stopping_ = true;
+        jobAvailable_.wakeAll();
+    }
+
+    for (ReaderThread* reader : readers_) {
+        reader->wait();
+        delete reader;
+    }
+    readers_.clear();
+
+    QMutexLocker locker(&mutex_);
+    stopping_ = false;
+    jobsDone_.wakeAll();
+}
+
+} // namespace Infrastructure
+} // namespace WordMaster
@@ -0,0 +1,132 @@
+#ifndef WORDMASTER_INFRASTRUCTURE_CONNECTION_MANAGER_H
+#define WORDMASTER_INFRASTRUCTURE_CONNECTION_MANAGER_H
+
+#include "infrastructure/sqlite_adapter.h"
+#include <QString>
+#include <QList>
+#include <QQueue>
+#include <QMutex>
+#include <QWaitCondition>
+#include <functional>
+#include <memory>
+
+namespace WordMaster {
+namespace Infrastructure {
+
+/**
+ * @brief 数据库连接管理器
+ *
+ * 职责：
+ * - 持有唯一的写连接（属于创建管理器的线程，通常是 UI 线程）
+ * - 持有 N 个只读连接，每个连接固定在自己的读线程上
+ * - 将只读任务分发到读线程并行执行（依赖 WAL 模式的并发读）
+ *
+ * QSqlDatabase 连接只能在创建它的线程中使用，所以读任务以
+ * ReadJob 的形式提交，由读线程把自己的连接传给任务。
+ */
+class ConnectionManager {
+public:
+    using ReadJob = std::function<void(SQLiteAdapter&)>;
+
+    // 默认读连接数
+    static const int kDefaultReaderCount = 2;
+
+    /**
+     * @brief 构造函数
+     * @param dbPath 数据库文件路径；":memory:" 无法跨连接共享，不创建读连接
+     * @param readerCount 读连接数量
+     */
+    explicit ConnectionManager(const QString& dbPath,
+                               int readerCount = kDefaultReaderCount);
+
+    /**
+     * @brief 析构函数 - 执行完剩余读任务后关闭所有连接
+     */
+    ~ConnectionManager();
+
+    // 禁用拷贝
+    ConnectionManager(const ConnectionManager&) = delete;
+    ConnectionManager& operator=(const ConnectionManager&) = delete;
+
+    /**
+     * @brief 打开写连接并启动读线程
+     * @return 写连接打开成功返回true（读连接失败时退化为无读连接）
+     */
+    bool open();
+
+    /**
+     * @brief 等待剩余读任务完成，关闭所有连接
+     */
+    void close();
+
+    /**
+     * @brief 设置所有连接的存储参数配置
+     *
+     * 已打开时立即应用到写连接，并用新配置重建读连接（会等待读任务完成）。
+     */
+    bool setStorageProfile(const StorageProfile& profile);
+
+    /**
+     * @brief 当前存储参数配置
+     */
+    StorageProfile storageProfile() const;
+
+    /**
+     * @brief 写连接是否打开
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief 获取写连接（只能在创建管理器的线程中使用）
+     */
+    SQLiteAdapter& writer();
+
+    /**
+     * @brief 已成功打开的读连接数量
+     */
+    int readerCount() const;
+
+    /**
+     * @brief 提交只读任务
+     *
+     * 任务在某个读线程上执行，参数为该线程的只读连接。
+     * 没有可用读连接时（如内存数据库）在调用线程上用写连接同步执行，
+     * 因此只应从写连接所属的线程提交任务。
+     */
+    void submitRead(ReadJob job);
+
+    /**
+     * @brief 阻塞等待所有已提交的读任务完成
+     */
+    void waitForReads();
+
+private:
+    class ReaderThread;
+
+    // 读线程取任务；管理器关闭且队列为空时返回false
+    bool takeJob(ReadJob& job);
+
+    // 读线程完成一个任务
+    void finishJob();
+
+    void startReaders();
+    void stopReaders();
+
+    QString dbPath_;
+    int requestedReaders_;
+    StorageProfile profile_;
+    std::unique_ptr<SQLiteAdapter> writer_;
+    QList<ReaderThread*> readers_;
+
+    QMutex mutex_;
+    QWaitCondition jobAvailable_;
+    QWaitCondition jobsDone_;
+    QQueue<ReadJob> jobs_;
+    int runningJobs_;
+    bool stopping_;
+};
+
+} // namespace Infrastructure
+} // namespace WordMaster
+
+#endif // WORDMASTER_INFRASTRUCTURE_CONNECTION_MANAGER_H
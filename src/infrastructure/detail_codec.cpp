@@ -0,0 +1,225 @@
+#include "detail_codec.h"
+#include <QHash>
+#include <QVector>
+#include <QtEndian>
+#include <QDebug>
+
+#ifdef WORDMASTER_ZSTD
+#include <zstd.h>
+#include <zdict.h>
+#endif
+
+namespace WordMaster {
+namespace Infrastructure {
+
+namespace {
+
+const int kHeaderBytes = 4;
+
+// 在导入时压缩一次；解压速度与级别基本无关
+const int kCompressionLevel = 9;
+
+// 单个字段解压后的大小上限，防止损坏的数据导致超大分配
+const unsigned long long kMaxFieldBytes = 16 * 1024 * 1024;
+
+void setError(QString* error, const QString& message) {
+    if (error) {
+        *error = message;
+    }
+}
+
+} // namespace
+
+#ifdef WORDMASTER_ZSTD
+class DetailCodec::Contexts {
+public:
+    Contexts()
+        : cctx(ZSTD_createCCtx())
+        , dctx(ZSTD_createDCtx())
+    {
+    }
+
+    ~Contexts() {
+        for (ZSTD_CDict* cdict : cdicts) {
+            ZSTD_freeCDict(cdict);
+        }
+        for (ZSTD_DDict* ddict : ddicts) {
+            ZSTD_freeDDict(ddict);
+        }
+        ZSTD_freeCCtx(cctx);
+        ZSTD_freeDCtx(dctx);
+    }
+
+    ZSTD_CCtx* cctx;
+    ZSTD_DCtx* dctx;
+    QHash<int, QByteArray> dictionaries;
+    QHash<int, ZSTD_CDict*> cdicts;     // 首次压缩时创建，只读连接不需要
+    QHash<int, ZSTD_DDict*> ddicts;
+};
+#else
+class DetailCodec::Contexts {
+public:
+    QHash<int, QByteArray> dictionaries;
+};
+#endif
+
+bool DetailCodec::isAvailable() {
+#ifdef WORDMASTER_ZSTD
+    return true;
+#else
+    return false;
+#endif
+}
+
+QByteArray DetailCodec::train(const QList<QByteArray>& samples, int dictionarySize,
+                              QString* error) {
+#ifdef WORDMASTER_ZSTD
+    QByteArray buffer;
+    QVector<size_t> sizes;
+    sizes.reserve(samples.size());
+    for (const QByteArray& sample : samples) {
+        buffer.append(sample);
+        sizes.append(static_cast<size_t>(sample.size()));
+    }
+
+    QByteArray dictionary(dictionarySize, Qt::Uninitialized);
+    size_t size = ZDICT_trainFromBuffer(dictionary.data(), dictionary.size(),
+                                        buffer.constData(), sizes.constData(),
+                                        static_cast<unsigned>(sizes.size()));
+    if (ZDICT_isError(size)) {
+        setError(error, QString("Failed to train dictionary: %1").arg(ZDICT_getErrorName(size)));
+        return QByteArray();
+    }
+
+    dictionary.resize(static_cast<int>(size));
+    return dictionary;
+#else
+    Q_UNUSED(samples);
+    Q_UNUSED(dictionarySize);
+    setError(error, "Dictionary compression requires a build with WORDMASTER_ZSTD");
+    return QByteArray();
+#endif
+}
+
+int DetailCodec::dictionaryIdOf(const QByteArray& blob) {
+    if (blob.size() <= kHeaderBytes) {
+        return -1;
+    }
+    return static_cast<int>(qFromLittleEndian<quint32>(
+        reinterpret_cast<const uchar*>(blob.constData())));
+}
+
+DetailCodec::DetailCodec()
+    : contexts_(new Contexts)
+{
+}
+
+DetailCodec::~DetailCodec() = default;
+
+bool DetailCodec::hasDictionary(int id) const {
+    return contexts_->dictionaries.contains(id);
+}
+
+bool DetailCodec::addDictionary(int id, const QByteArray& dictionary) {
+#ifdef WORDMASTER_ZSTD
+    if (id < 0 || dictionary.isEmpty()) {
+        return false;
+    }
+    if (hasDictionary(id)) {
+        return true;
+    }
+
+    ZSTD_DDict* ddict = ZSTD_createDDict(dictionary.constData(), dictionary.size());
+    if (!ddict) {
+        qWarning() << "Failed to load detail dictionary" << id;
+        return false;
+    }
+
+    contexts_->dictionaries.insert(id, dictionary);
+    contexts_->ddicts.insert(id, ddict);
+    return true;
+#else
+    Q_UNUSED(id);
+    Q_UNUSED(dictionary);
+    return false;
+#endif
+}
+
+QByteArray DetailCodec::compress(const QByteArray& text, int dictionaryId) {
+#ifdef WORDMASTER_ZSTD
+    auto dictionary = contexts_->dictionaries.constFind(dictionaryId);
+    if (dictionary == contexts_->dictionaries.constEnd()) {
+        return QByteArray();
+    }
+
+    ZSTD_CDict* cdict = contexts_->cdicts.value(dictionaryId);
+    if (!cdict) {
+        cdict = ZSTD_createCDict(dictionary->constData(), dictionary->size(),
+                                 kCompressionLevel);
+        if (!cdict) {
+            qWarning() << "Failed to prepare detail dictionary" << dictionaryId;
+            return QByteArray();
+        }
+        contexts_->cdicts.insert(dictionaryId, cdict);
+    }
+
+    // 字典 id 已在头部，帧内不再重复
+    ZSTD_CCtx* cctx = contexts_->cctx;
+    ZSTD_CCtx_reset(cctx, ZSTD_reset_session_and_parameters);
+    ZSTD_CCtx_setParameter(cctx, ZSTD_c_dictIDFlag, 0);
+    ZSTD_CCtx_refCDict(cctx, cdict);
+
+    QByteArray blob(kHeaderBytes + static_cast<int>(ZSTD_compressBound(text.size())),
+                    Qt::Uninitialized);
+    qToLittleEndian<quint32>(static_cast<quint32>(dictionaryId),
+                             reinterpret_cast<uchar*>(blob.data()));
+
+    size_t size = ZSTD_compress2(cctx, blob.data() + kHeaderBytes, blob.size() - kHeaderBytes,
+                                 text.constData(), text.size());
+    if (ZSTD_isError(size)) {
+        qWarning() << "Failed to compress word details:" << ZSTD_getErrorName(size);
+        return QByteArray();
+    }
+
+    blob.resize(kHeaderBytes + static_cast<int>(size));
+    return blob;
+#else
+    Q_UNUSED(text);
+    Q_UNUSED(dictionaryId);
+    return QByteArray();
+#endif
+}
+
+bool DetailCodec::decompress(const QByteArray& blob, QByteArray* text) {
+#ifdef WORDMASTER_ZSTD
+    ZSTD_DDict* ddict = contexts_->ddicts.value(dictionaryIdOf(blob));
+    if (!ddict) {
+        return false;
+    }
+
+    const char* frame = blob.constData() + kHeaderBytes;
+    const size_t frameSize = static_cast<size_t>(blob.size() - kHeaderBytes);
+    unsigned long long size = ZSTD_getFrameContentSize(frame, frameSize);
+    if (size == ZSTD_CONTENTSIZE_ERROR || size == ZSTD_CONTENTSIZE_UNKNOWN
+            || size > kMaxFieldBytes) {
+        return false;
+    }
+
+    QByteArray out(static_cast<int>(size), Qt::Uninitialized);
+    size_t written = ZSTD_decompress_usingDDict(contexts_->dctx, out.data(), out.size(),
+                                                frame, frameSize, ddict);
+    if (ZSTD_isError(written) || written != size) {
+        return false;
+    }
+
+    *text = out;
+    return true;
+#else
+    Q_UNUSED(blob);
+    Q_UNUSED(text);
+    return false;
+#endif
+}
+
+} // namespace Infrastructure
+} // namespace WordMaster
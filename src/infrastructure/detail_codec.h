@@ -0,0 +1,78 @@
+#ifndef WORDMASTER_INFRASTRUCTURE_DETAIL_CODEC_H
+#define WORDMASTER_INFRASTRUCTURE_DETAIL_CODEC_H
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+#include <memory>
+
+namespace WordMaster {
+namespace Infrastructure {
+
+/**
+ * @brief word_details 字段的字典压缩（zstd）
+ *
+ * 单个字段只有几百字节，单独压缩几乎没有收益；同一词库的字段结构和用词高度重复，
+ * 用该词库的样本训练一个字典后逐字段压缩，每个字段仍可单独解压。
+ *
+ * 压缩值格式：4 字节小端字典 id（detail_dictionaries.id）+ zstd 帧（不含字典 id 与校验和）。
+ * 字典由调用方按 id 加入（addDictionary），编解码上下文按字典缓存。
+ *
+ * 需以 WORDMASTER_ZSTD 构建；否则 isAvailable() 为 false，所有操作失败。
+ * 不加锁，每个连接（仓储）各持一个。
+ */
+class DetailCodec {
+public:
+    // 默认字典大小
+    static const int kDefaultDictionarySize = 64 * 1024;
+    // 更短的字段压缩后反而可能变大，保持原样
+    static const int kMinCompressBytes = 48;
+
+    /**
+     * @brief 当前构建是否支持压缩
+     */
+    static bool isAvailable();
+
+    /**
+     * @brief 用样本训练字典
+     * @param dictionarySize 字典容量上限
+     * @return 失败（如样本过少）返回空并设置 error
+     */
+    static QByteArray train(const QList<QByteArray>& samples, int dictionarySize,
+                            QString* error = nullptr);
+
+    /**
+     * @brief 压缩值引用的字典 id；不是压缩值时返回 -1
+     */
+    static int dictionaryIdOf(const QByteArray& blob);
+
+    DetailCodec();
+    ~DetailCodec();
+
+    bool hasDictionary(int id) const;
+    bool addDictionary(int id, const QByteArray& dictionary);
+
+    /**
+     * @brief 用字典压缩 UTF-8 文本
+     * @return 失败返回空
+     */
+    QByteArray compress(const QByteArray& text, int dictionaryId);
+
+    /**
+     * @brief 解压 compress() 的结果（字典需已加入）
+     */
+    bool decompress(const QByteArray& blob, QByteArray* text);
+
+private:
+    class Contexts;
+
+    std::unique_ptr<Contexts> contexts_;
+
+    DetailCodec(const DetailCodec&) = delete;
+    DetailCodec& operator=(const DetailCodec&) = delete;
+};
+
+} // namespace Infrastructure
+} // namespace WordMaster
+
+#endif // WORDMASTER_INFRASTRUCTURE_DETAIL_CODEC_H
@@ -0,0 +1,165 @@
+#include "native_statement.h"
+
+#ifdef WORDMASTER_NATIVE_SQLITE
+
+#include <QElapsedTimer>
+
+namespace WordMaster {
+namespace Infrastructure {
+
+NativeStatement::NativeStatement()
+    : stmt_(nullptr)
+    , lastResult_(SQLITE_OK)
+    , timed_(false)
+    , elapsedNs_(0)
+    , rowsReturned_(0)
+{
+}
+
+NativeStatement::NativeStatement(std::shared_ptr<sqlite3_stmt> stmt, bool timed)
+    : statement_(std::move(stmt))
+    , stmt_(statement_.get())
+    , lastResult_(SQLITE_OK)
+    , timed_(timed)
+    , elapsedNs_(0)
+    , rowsReturned_(0)
+{
+}
+
+bool NativeStatement::isValid() const {
+    return stmt_ != nullptr;
+}
+
+bool NativeStatement::bind(int index, const QVariant& value) {
+    int position = index + 1;
+
+    if (value.isNull()) {
+        lastResult_ = sqlite3_bind_null(stmt_, position);
+    } else {
+        switch (value.type()) {
+        case QVariant::Bool:
+        case QVariant::Int:
+        case QVariant::UInt:
+        case QVariant::LongLong:
+        case QVariant::ULongLong:
+            lastResult_ = sqlite3_bind_int64(stmt_, position, value.toLongLong());
+            break;
+        case QVariant::Double:
+            lastResult_ = sqlite3_bind_double(stmt_, position, value.toDouble());
+            break;
+        default: {
+            QString text = value.toString();
+            lastResult_ = sqlite3_bind_text16(stmt_, position, text.utf16(),
+                                              text.size() * int(sizeof(QChar)),
+                                              SQLITE_TRANSIENT);
+            break;
+        }
+        }
+    }
+
+    return lastResult_ == SQLITE_OK;
+}
+
+bool NativeStatement::bindValues(const QVariantList& values) {
+    for (int i = 0; i < values.size(); ++i) {
+        if (!bind(i, values[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int NativeStatement::step() {
+    if (!timed_) {
+        return sqlite3_step(stmt_);
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    int rc = sqlite3_step(stmt_);
+    elapsedNs_ += timer.nsecsElapsed();
+    return rc;
+}
+
+bool NativeStatement::next() {
+    lastResult_ = step();
+    if (lastResult_ != SQLITE_ROW) {
+        return false;
+    }
+    ++rowsReturned_;
+    return true;
+}
+
+bool NativeStatement::exec() {
+    lastResult_ = step();
+    return lastResult_ == SQLITE_DONE || lastResult_ == SQLITE_ROW;
+}
+
+bool NativeStatement::hasError() const {
+    return lastResult_ != SQLITE_OK
+        && lastResult_ != SQLITE_ROW
+        && lastResult_ != SQLITE_DONE;
+}
+
+QString NativeStatement::lastError() const {
+    return QString::fromUtf8(sqlite3_errmsg(sqlite3_db_handle(stmt_)));
+}
+
+qint64 NativeStatement::elapsedNs() const {
+    return elapsedNs_;
+}
+
+int NativeStatement::rowsReturned() const {
+    return rowsReturned_;
+}
+
+bool NativeStatement::isNull(int column) const {
+    return sqlite3_column_type(stmt_, column) == SQLITE_NULL;
+}
+
+int NativeStatement::columnInt(int column) const {
+    return sqlite3_column_int(stmt_, column);
+}
+
+qint64 NativeStatement::columnInt64(int column) const {
+    return sqlite3_column_int64(stmt_, column);
+}
+
+double NativeStatement::columnDouble(int column) const {
+    return sqlite3_column_double(stmt_, column);
+}
+
+QString NativeStatement::columnText(int column) const {
+    // 库中文本为 UTF-8：直接取原始字节解码，只复制一次（text16 会先在 SQLite 内转换一次）。
+    // 先取指针再取长度
+    const unsigned char* data = sqlite3_column_text(stmt_, column);
+    if (!data) {
+        return QString();
+    }
+    int bytes = sqlite3_column_bytes(stmt_, column);
+    return QString::fromUtf8(reinterpret_cast<const char*>(data), bytes);
+}
+
+QDateTime NativeStatement::columnDateTime(int column) const {
+    // 与 QVariant(QString).toDateTime() 一致，按 ISO 格式解析
+    return QDateTime::fromString(columnText(column), Qt::ISODate);
+}
+
+bool NativeStatement::isBlob(int column) const {
+    return sqlite3_column_type(stmt_, column) == SQLITE_BLOB;
+}
+
+QByteArray NativeStatement::columnBlob(int column) const {
+    // 同样先取指针再取长度
+    const void* data = sqlite3_column_blob(stmt_, column);
+    if (!data) {
+        return QByteArray();
+    }
+    int bytes = sqlite3_column_bytes(stmt_, column);
+    return QByteArray(static_cast<const char*>(data), bytes);
+}
+
+} // namespace Infrastructure
+} // namespace WordMaster
+
+#endif // WORDMASTER_NATIVE_SQLITE
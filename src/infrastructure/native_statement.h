@@ -0,0 +1,99 @@
+#ifndef WORDMASTER_INFRASTRUCTURE_NATIVE_STATEMENT_H
+#define WORDMASTER_INFRASTRUCTURE_NATIVE_STATEMENT_H
+
+#ifdef WORDMASTER_NATIVE_SQLITE
+
+#include <sqlite3.h>
+#include <QByteArray>
+#include <QString>
+#include <QVariant>
+#include <QDateTime>
+#include <memory>
+
+namespace WordMaster {
+namespace Infrastructure {
+
+/**
+ * @brief 原生 sqlite3 语句句柄（热路径专用）
+ *
+ * 直接调用 sqlite3 C API：按列序号读取，文本列用 UTF-16 指针
+ * 直接构造 QString，不经过 QSqlQuery 的按名查找和 QVariant 装箱。
+ *
+ * 语句由 SQLiteAdapter::prepareNative() 缓存，句柄与缓存共享所有权，
+ * 缓存淘汰时跳过仍被句柄持有的语句；与 QSqlQuery 一样，持有期间不要再次
+ * prepareNative() 同一 SQL。读完后调用 SQLiteAdapter::recordNative()
+ * 把单步耗时与返回行数计入统计。
+ * 仅在构建时开启 WORDMASTER_NATIVE_SQLITE 时可用。
+ */
+class NativeStatement {
+public:
+    NativeStatement();
+
+    /**
+     * @param stmt 共享的语句
+     * @param timed 是否累计 sqlite3_step 的耗时（统计关闭时不计时）
+     */
+    NativeStatement(std::shared_ptr<sqlite3_stmt> stmt, bool timed);
+
+    /**
+     * @brief 语句是否可用（原生后端不可用时为无效句柄）
+     */
+    bool isValid() const;
+
+    /**
+     * @brief 按位置绑定参数（从 0 开始，与 QSqlQuery 一致）
+     */
+    bool bind(int index, const QVariant& value);
+    bool bindValues(const QVariantList& values);
+
+    /**
+     * @brief 取下一行
+     * @return 有数据返回true；结束或出错返回false（用 hasError() 区分）
+     */
+    bool next();
+
+    /**
+     * @brief 执行不返回数据的语句
+     */
+    bool exec();
+
+    bool hasError() const;
+    QString lastError() const;
+
+    /**
+     * @brief 累计单步耗时（纳秒，未计时时为 0）
+     */
+    qint64 elapsedNs() const;
+
+    /**
+     * @brief 已读取的行数
+     */
+    int rowsReturned() const;
+
+    bool isNull(int column) const;
+    int columnInt(int column) const;
+    qint64 columnInt64(int column) const;
+    double columnDouble(int column) const;
+    QString columnText(int column) const;
+    QDateTime columnDateTime(int column) const;
+
+    bool isBlob(int column) const;
+    QByteArray columnBlob(int column) const;
+
+private:
+    int step();
+
+    std::shared_ptr<sqlite3_stmt> statement_;
+    sqlite3_stmt* stmt_;
+    int lastResult_;
+    bool timed_;
+    qint64 elapsedNs_;
+    int rowsReturned_;
+};
+
+} // namespace Infrastructure
+} // namespace WordMaster
+
+#endif // WORDMASTER_NATIVE_SQLITE
+
+#endif // WORDMASTER_INFRASTRUCTURE_NATIVE_STATEMENT_H
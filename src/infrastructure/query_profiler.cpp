@@ -0,0 +1,235 @@
+#include "query_profiler.h"
+#include <QFile>
+#include <QTextStream>
+#include <QRegularExpression>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+
+namespace WordMaster {
+namespace Infrastructure {
+
+QueryProfiler::QueryProfiler()
+    : enabled_(true)
+    , slowQueryThresholdMs_(kDefaultSlowQueryThresholdMs)
+{
+}
+
+void QueryProfiler::setEnabled(bool enabled) {
+    enabled_ = enabled;
+}
+
+bool QueryProfiler::isEnabled() const {
+    return enabled_;
+}
+
+void QueryProfiler::setSlowQueryThreshold(int ms) {
+    slowQueryThresholdMs_ = ms;
+}
+
+int QueryProfiler::slowQueryThreshold() const {
+    return slowQueryThresholdMs_;
+}
+
+void QueryProfiler::setSlowQueryLogFile(const QString& path) {
+    slowQueryLogFile_ = path;
+}
+
+QString QueryProfiler::slowQueryLogFile() const {
+    return slowQueryLogFile_;
+}
+
+bool QueryProfiler::record(const QString& sql, const QVariantList& boundValues,
+                           qint64 elapsedNs, bool ok, int rowsAffected, int rowsReturned) {
+    Entry& entry = entries_[entryFor(sql)];
+
+    if (entry.count == 0) {
+        entry.sampleSql = sql;
+        entry.sampleValues = boundValues;
+    }
+    ++entry.count;
+    if (!ok) {
+        ++entry.failures;
+    }
+    if (rowsAffected > 0) {
+        entry.rowsAffected += rowsAffected;
+    }
+    if (rowsReturned > 0) {
+        entry.rowsReturned += rowsReturned;
+    }
+    entry.totalNs += elapsedNs;
+    entry.maxNs = qMax(entry.maxNs, elapsedNs);
+    ++entry.histogram[bucketFor(elapsedNs)];
+
+    return isSlow(elapsedNs);
+}
+
+void QueryProfiler::recordRowsReturned(const QString& sql, int rows) {
+    if (rows > 0) {
+        entries_[entryFor(sql)].rowsReturned += rows;
+    }
+}
+
+bool QueryProfiler::needsBoundValues(const QString& sql, qint64 elapsedNs) const {
+    // 原始 SQL 映射被清空后会多取几次参数，不影响结果
+    return isSlow(elapsedNs) || !indexByRawSql_.contains(sql);
+}
+
+bool QueryProfiler::isSlow(qint64 elapsedNs) const {
+    return slowQueryThresholdMs_ >= 0
+        && elapsedNs >= static_cast<qint64>(slowQueryThresholdMs_) * 1000000;
+}
+
+void QueryProfiler::addSlowQuery(const SlowQuery& slowQuery) {
+    slowQueries_.append(slowQuery);
+    while (slowQueries_.size() > kMaxSlowQueries) {
+        slowQueries_.removeFirst();
+    }
+
+    QStringList params;
+    for (const QVariant& value : slowQuery.boundValues) {
+        params << (value.isNull() ? QString("NULL") : value.toString());
+    }
+
+    qWarning() << "Slow query:" << slowQuery.elapsedUs / 1000.0 << "ms"
+               << "\nSQL:" << normalizeSql(slowQuery.sql)
+               << "\nParams:" << params
+               << "\nPlan:" << slowQuery.plan;
+
+    if (slowQueryLogFile_.isEmpty()) {
+        return;
+    }
+
+    QFile file(slowQueryLogFile_);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+        qWarning() << "Failed to open slow query log:" << slowQueryLogFile_;
+        return;
+    }
+
+    QTextStream out(&file);
+    out.setCodec("UTF-8");
+    out << "[" << slowQuery.executedAt.toString(Qt::ISODate) << "] "
+        << QString::number(slowQuery.elapsedUs / 1000.0, 'f', 2) << " ms\n"
+        << "  sql: " << normalizeSql(slowQuery.sql) << "\n"
+        << "  params: [" << params.join(", ") << "]\n";
+    for (const QString& step : slowQuery.plan) {
+        out << "  plan: " << step << "\n";
+    }
+}
+
+QList<QueryProfiler::StatementStats> QueryProfiler::statementStats() const {
+    QList<StatementStats> result;
+
+    for (const Entry& entry : entries_) {
+        if (entry.count == 0) {
+            continue;
+        }
+
+        StatementStats stats;
+        stats.sql = entry.sql;
+        stats.sampleSql = entry.sampleSql;
+        stats.sampleValues = entry.sampleValues;
+        stats.count = entry.count;
+        stats.failures = entry.failures;
+        stats.rowsAffected = entry.rowsAffected;
+        stats.rowsReturned = entry.rowsReturned;
+        stats.totalUs = entry.totalNs / 1000;
+        stats.maxUs = entry.maxNs / 1000;
+        stats.p50Us = qMin(percentileUs(entry, 0.50), stats.maxUs);
+        stats.p95Us = qMin(percentileUs(entry, 0.95), stats.maxUs);
+        stats.p99Us = qMin(percentileUs(entry, 0.99), stats.maxUs);
+        result.append(stats);
+    }
+
+    std::sort(result.begin(), result.end(),
+              [](const StatementStats& a, const StatementStats& b) {
+                  return a.totalUs > b.totalUs;
+              });
+    return result;
+}
+
+QList<QueryProfiler::SlowQuery> QueryProfiler::slowQueries() const {
+    return slowQueries_;
+}
+
+void QueryProfiler::reset() {
+    entries_.clear();
+    indexByNormalizedSql_.clear();
+    indexByRawSql_.clear();
+    slowQueries_.clear();
+}
+
+QString QueryProfiler::normalizeSql(const QString& sql) {
+    static const QRegularExpression stringLiteral("'(?:[^']|'')*'");
+    static const QRegularExpression numberLiteral("(?<![\\w.])-?\\d+(?:\\.\\d+)?(?![\\w.])");
+    static const QRegularExpression whitespace("\\s+");
+    static const QRegularExpression inList("\\bIN\\s*\\(\\s*\\?(?:\\s*,\\s*\\?)*\\s*\\)",
+                                           QRegularExpression::CaseInsensitiveOption);
+    static const QRegularExpression valueRows("(\\(\\?(?:, \\?)*\\))(?:, \\(\\?(?:, \\?)*\\))+");
+
+    QString normalized = sql;
+    normalized.replace(stringLiteral, "?");
+    normalized.replace(numberLiteral, "?");
+    normalized.replace(whitespace, " ");
+    normalized = normalized.trimmed();
+    if (normalized.endsWith(';')) {
+        normalized.chop(1);
+    }
+    normalized.replace(inList, "IN (...)");
+    normalized.replace(valueRows, "\\1, ...");
+    return normalized;
+}
+
+int QueryProfiler::entryFor(const QString& sql) {
+    auto raw = indexByRawSql_.constFind(sql);
+    if (raw != indexByRawSql_.constEnd()) {
+        return raw.value();
+    }
+
+    QString normalized = normalizeSql(sql);
+    int index = indexByNormalizedSql_.value(normalized, -1);
+    if (index < 0) {
+        Entry entry;
+        entry.sql = normalized;
+        entry.histogram.fill(0, kHistogramBuckets);
+        entries_.append(entry);
+        index = entries_.size() - 1;
+        indexByNormalizedSql_.insert(normalized, index);
+    }
+
+    // 拼接字面量的 SQL 文本种类无上限，超过上限时重建映射
+    if (indexByRawSql_.size() >= kMaxRawSqlCache) {
+        indexByRawSql_.clear();
+    }
+    indexByRawSql_.insert(sql, index);
+    return index;
+}
+
+int QueryProfiler::bucketFor(qint64 elapsedNs) {
+    double us = elapsedNs / 1000.0;
+    if (us <= 1.0) {
+        return 0;
+    }
+    int bucket = static_cast<int>(std::log2(us) * 4.0);
+    return qBound(0, bucket, kHistogramBuckets - 1);
+}
+
+qint64 QueryProfiler::bucketUpperUs(int bucket) {
+    return static_cast<qint64>(std::ceil(std::pow(2.0, (bucket + 1) / 4.0)));
+}
+
+qint64 QueryProfiler::percentileUs(const Entry& entry, double percentile) {
+    quint64 rank = static_cast<quint64>(std::ceil(entry.count * percentile));
+    quint64 seen = 0;
+
+    for (int i = 0; i < entry.histogram.size(); ++i) {
+        seen += entry.histogram[i];
+        if (seen >= rank) {
+            return bucketUpperUs(i);
+        }
+    }
+    return bucketUpperUs(kHistogramBuckets - 1);
+}
+
+} // namespace Infrastructure
+} // namespace WordMaster
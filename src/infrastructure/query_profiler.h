@@ -0,0 +1,166 @@
+#ifndef WORDMASTER_INFRASTRUCTURE_QUERY_PROFILER_H
+#define WORDMASTER_INFRASTRUCTURE_QUERY_PROFILER_H
+
+#include <QString>
+#include <QStringList>
+#include <QVariantList>
+#include <QDateTime>
+#include <QHash>
+#include <QList>
+#include <QVector>
+
+namespace WordMaster {
+namespace Infrastructure {
+
+/**
+ * @brief SQL 执行统计与慢查询日志
+ *
+ * 由 SQLiteAdapter 持有，每个连接一份（与连接同线程使用，不加锁）。
+ *
+ * - 按归一化 SQL 统计执行次数、总耗时、p50/p95/p99、影响行数与返回行数
+ * - 延迟直方图按 1/4 倍频程分桶，百分位取所在桶的上界（误差约 19%）
+ * - 超过阈值的执行记入慢查询日志（参数与 EXPLAIN QUERY PLAN 由适配器补充）
+ */
+class QueryProfiler {
+public:
+    struct StatementStats {
+        QString sql;                // 归一化后的 SQL
+        quint64 count = 0;          // 执行次数
+        quint64 failures = 0;       // 失败次数
+        quint64 rowsAffected = 0;   // 累计影响行数（INSERT/UPDATE/DELETE）
+        quint64 rowsReturned = 0;   // 累计返回行数（SELECT，由读取方上报）
+        qint64 totalUs = 0;         // 累计耗时（微秒）
+        qint64 maxUs = 0;
+        qint64 p50Us = 0;
+        qint64 p95Us = 0;
+        qint64 p99Us = 0;
+        QString sampleSql;          // 首次执行的原始 SQL 与参数（用于 EXPLAIN QUERY PLAN）
+        QVariantList sampleValues;
+
+        double avgUs() const {
+            return count > 0 ? static_cast<double>(totalUs) / count : 0.0;
+        }
+    };
+
+    struct SlowQuery {
+        QDateTime executedAt;
+        QString sql;                // 原始 SQL
+        QVariantList boundValues;   // 按位置排列的绑定参数
+        qint64 elapsedUs = 0;
+        QStringList plan;           // EXPLAIN QUERY PLAN 的 detail 列
+    };
+
+    // 默认慢查询阈值（毫秒）
+    static const int kDefaultSlowQueryThresholdMs = 100;
+
+    // 内存中保留的慢查询条数
+    static const int kMaxSlowQueries = 50;
+
+    QueryProfiler();
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+
+    /**
+     * @brief 设置慢查询阈值，负数表示关闭慢查询日志
+     */
+    void setSlowQueryThreshold(int ms);
+    int slowQueryThreshold() const;
+
+    /**
+     * @brief 慢查询追加写入的日志文件，空字符串表示只输出到 qWarning
+     */
+    void setSlowQueryLogFile(const QString& path);
+    QString slowQueryLogFile() const;
+
+    /**
+     * @brief 记录一次执行
+     * @param sql 原始 SQL
+     * @param boundValues 绑定参数（只保留每条语句首次执行的一份）
+     * @param elapsedNs 耗时（纳秒）
+     * @param ok 是否成功
+     * @param rowsAffected 影响行数（SELECT 传 0）
+     * @param rowsReturned 返回行数（执行时已读完结果集时传入，否则随后调用 recordRowsReturned()）
+     * @return 超过慢查询阈值返回true，调用方应随后调用 addSlowQuery()
+     */
+    bool record(const QString& sql, const QVariantList& boundValues,
+                qint64 elapsedNs, bool ok, int rowsAffected, int rowsReturned = 0);
+
+    /**
+     * @brief 累加语句的返回行数
+     * 
+     * QSqlQuery 在 exec() 之后才逐行读取，读取方读完后按原始 SQL 上报。
+     */
+    void recordRowsReturned(const QString& sql, int rows);
+
+    /**
+     * @brief 本次执行是否需要提供绑定参数
+     * 
+     * 只有语句首次执行（作为 EXPLAIN 样本）或超过慢查询阈值时需要，
+     * 调用方据此避免为每次执行复制参数（批量插入一次绑定上千个参数）。
+     */
+    bool needsBoundValues(const QString& sql, qint64 elapsedNs) const;
+    
+    /**
+     * @brief 写入慢查询日志
+     */
+    void addSlowQuery(const SlowQuery& slowQuery);
+
+    /**
+     * @brief 按累计耗时降序排列的统计
+     */
+    QList<StatementStats> statementStats() const;
+
+    /**
+     * @brief 最近的慢查询（由旧到新）
+     */
+    QList<SlowQuery> slowQueries() const;
+
+    /**
+     * @brief 清空统计与慢查询
+     */
+    void reset();
+
+    /**
+     * @brief 归一化 SQL：合并空白，字面量替换为 ?，IN 列表与多行 VALUES 折叠
+     */
+    static QString normalizeSql(const QString& sql);
+
+private:
+    static const int kHistogramBuckets = 128;
+    static const int kMaxRawSqlCache = 1024;
+
+    struct Entry {
+        QString sql;
+        QString sampleSql;
+        QVariantList sampleValues;
+        quint64 count = 0;
+        quint64 failures = 0;
+        quint64 rowsAffected = 0;
+        quint64 rowsReturned = 0;
+        qint64 totalNs = 0;
+        qint64 maxNs = 0;
+        QVector<quint32> histogram;
+    };
+
+    int entryFor(const QString& sql);
+    bool isSlow(qint64 elapsedNs) const;
+
+    static int bucketFor(qint64 elapsedNs);
+    static qint64 bucketUpperUs(int bucket);
+    static qint64 percentileUs(const Entry& entry, double percentile);
+
+    bool enabled_;
+    int slowQueryThresholdMs_;
+    QString slowQueryLogFile_;
+
+    QVector<Entry> entries_;
+    QHash<QString, int> indexByNormalizedSql_;
+    QHash<QString, int> indexByRawSql_;         // 避免重复归一化
+    QList<SlowQuery> slowQueries_;
+};
+
+} // namespace Infrastructure
+} // namespace WordMaster
+
+#endif // WORDMASTER_INFRASTRUCTURE_QUERY_PROFILER_H
@@ -37,7 +37,7 @@ bool BookRepository::save(const Domain::Book& book) {
     query.addBindValue(book.translateLanguage);
     query.addBindValue(book.isActive ? 1 : 0);
     
-    if (!query.exec()) {
+    if (!adapter_.exec(query)) {
         qWarning() << "Failed to save book:" << query.lastError().text();
         return false;
     }
@@ -51,7 +51,7 @@ Domain::Book BookRepository::getById(const QString& id) {
     auto query = adapter_.prepare(sql);
     query.addBindValue(id);
     
-    if (!query.exec()) {
+    if (!adapter_.exec(query)) {
         qWarning() << "Failed to query book:" << query.lastError().text();
         return Domain::Book();
     }
@@ -72,6 +72,7 @@ QList<Domain::Book> BookRepository::getAll() {
     while (query.next()) {
         books.append(buildBookFromQuery(query));
     }
+    adapter_.recordRowsReturned(query, books.size());
     
     return books;
 }
@@ -82,7 +83,7 @@ bool BookRepository::remove(const QString& id) {
     auto query = adapter_.prepare(sql);
     query.addBindValue(id);
     
-    if (!query.exec()) {
+    if (!adapter_.exec(query)) {
         qWarning() << "Failed to delete book:" << query.lastError().text();
         return false;
     }
@@ -96,13 +97,46 @@ bool BookRepository::exists(const QString& id) {
     auto query = adapter_.prepare(sql);
     query.addBindValue(id);
     
-    if (query.exec() && query.next()) {
+    if (adapter_.exec(query) && query.next()) {
         return query.value("cnt").toInt() > 0;
     }
     
     return false;
 }
 
+bool BookRepository::update(const Domain::Book& book) {
+    if (!book.isValid()) {
+        qWarning() << "Invalid book object";
+        return false;
+    }
+
+    // 不改动 is_active 与 imported_at
+    QString sql = R"(
+        UPDATE books
+        SET name = ?, description = ?, category = ?, tags = ?, url = ?,
+            word_count = ?, language = ?, translate_language = ?
+        WHERE id = ?
+    )";
+
+    auto query = adapter_.prepare(sql);
+    query.addBindValue(book.name);
+    query.addBindValue(book.description);
+    query.addBindValue(book.category);
+    query.addBindValue(serializeTags(book.tags));
+    query.addBindValue(book.url);
+    query.addBindValue(book.wordCount);
+    query.addBindValue(book.language);
+    query.addBindValue(book.translateLanguage);
+    query.addBindValue(book.id);
+
+    if (!adapter_.exec(query)) {
+        qWarning() << "Failed to update book:" << query.lastError().text();
+        return false;
+    }
+
+    return query.numRowsAffected() > 0;
+}
+
 QList<Domain::Book> BookRepository::getByCategory(const QString& category) {
     QList<Domain::Book> books;
     
@@ -110,7 +144,7 @@ QList<Domain::Book> BookRepository::getByCategory(const QString& category) {
     auto query = adapter_.prepare(sql);
     query.addBindValue(category);
     
-    if (!query.exec()) {
+    if (!adapter_.exec(query)) {
         qWarning() << "Failed to query books by category:" << query.lastError().text();
         return books;
     }
@@ -118,6 +152,7 @@ QList<Domain::Book> BookRepository::getByCategory(const QString& category) {
     while (query.next()) {
         books.append(buildBookFromQuery(query));
     }
+    adapter_.recordRowsReturned(query, books.size());
     
     return books;
 }
@@ -144,7 +179,7 @@ bool BookRepository::setActive(const QString& id, bool active) {
     query.addBindValue(active ? 1 : 0);
     query.addBindValue(id);
     
-    if (!query.exec()) {
+    if (!adapter_.exec(query)) {
         qWarning() << "Failed to set active status:" << query.lastError().text();
         return false;
     }
@@ -158,7 +193,7 @@ int BookRepository::getTotalWordCount(const QString& bookId) {
     auto query = adapter_.prepare(sql);
     query.addBindValue(bookId);
     
-    if (query.exec() && query.next()) {
+    if (adapter_.exec(query) && query.next()) {
         return query.value("word_count").toInt();
     }
     
@@ -175,7 +210,7 @@ int BookRepository::getLearnedWordCount(const QString& bookId) {
     auto query = adapter_.prepare(sql);
     query.addBindValue(bookId);
     
-    if (query.exec() && query.next()) {
+    if (adapter_.exec(query) && query.next()) {
         return query.value("cnt").toInt();
     }
     
@@ -192,7 +227,7 @@ int BookRepository::getMasteredWordCount(const QString& bookId) {
     auto query = adapter_.prepare(sql);
     query.addBindValue(bookId);
     
-    if (query.exec() && query.next()) {
+    if (adapter_.exec(query) && query.next()) {
         return query.value("cnt").toInt();
     }
     
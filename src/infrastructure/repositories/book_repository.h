@@ -27,6 +27,7 @@ public:
     QList<Domain::Book> getAll() override;
     bool remove(const QString& id) override;
     bool exists(const QString& id) override;
+    bool update(const Domain::Book& book) override;
     
     // 查询
     QList<Domain::Book> getByCategory(const QString& category) override;
@@ -0,0 +1,319 @@
+#include "cached_word_repository.h"
+#include <QSet>
+#include <QPair>
+
+namespace WordMaster {
+namespace Infrastructure {
+
+CachedWordRepository::CachedWordRepository(Domain::IWordRepository& inner, int byteBudget)
+    : inner_(inner)
+    , byteBudget_(qMax(0, byteBudget))
+    , cachedBytes_(0)
+{
+}
+
+bool CachedWordRepository::save(const Domain::Word& word) {
+    return saveBatch(QList<Domain::Word>() << word);
+}
+
+Domain::Word CachedWordRepository::getById(int id, Domain::WordProjection projection) {
+    if (const Entry* entry = lookup(id, projection)) {
+        return entry->word;
+    }
+
+    Domain::Word word = inner_.getById(id, projection);
+    if (word.id > 0) {
+        insert(word, projection);
+    }
+    return word;
+}
+
+QList<Domain::Word> CachedWordRepository::getByIds(const QList<int>& ids,
+                                                   Domain::WordProjection projection) {
+    QHash<int, Domain::Word> found;
+    QSet<int> seen;
+    QList<int> missing;
+    for (int id : ids) {
+        if (seen.contains(id)) {
+            continue;
+        }
+        seen.insert(id);
+        if (const Entry* entry = lookup(id, projection)) {
+            found.insert(id, entry->word);
+        } else {
+            missing.append(id);
+        }
+    }
+
+    if (!missing.isEmpty()) {
+        for (const Domain::Word& word : inner_.getByIds(missing, projection)) {
+            found.insert(word.id, word);
+            insert(word, projection);
+        }
+    }
+
+    // 按参数顺序返回，重复的 id 只返回一次，不存在的 id 跳过
+    QList<Domain::Word> words;
+    words.reserve(found.size());
+    for (int id : ids) {
+        auto it = found.find(id);
+        if (it != found.end()) {
+            words.append(it.value());
+            found.erase(it);
+        }
+    }
+    return words;
+}
+
+bool CachedWordRepository::remove(int id) {
+    invalidate(id);
+    return inner_.remove(id);
+}
+
+bool CachedWordRepository::exists(int id) {
+    if (index_.contains(id)) {
+        return true;
+    }
+    return inner_.exists(id);
+}
+
+bool CachedWordRepository::update(const Domain::Word& word) {
+    invalidate(word.id);
+    return inner_.update(word);
+}
+
+bool CachedWordRepository::loadDetails(Domain::Word& word) {
+    if (const Entry* entry = lookup(word.id, Domain::WordProjection::Full)) {
+        word.translations = entry->word.translations;
+        word.sentences = entry->word.sentences;
+        word.phrases = entry->word.phrases;
+        word.synonyms = entry->word.synonyms;
+        word.relatedWords = entry->word.relatedWords;
+        word.etymology = entry->word.etymology;
+        return true;
+    }
+
+    if (!inner_.loadDetails(word)) {
+        return false;
+    }
+
+    // 已缓存的 Summary 升级为 Full
+    if (index_.contains(word.id)) {
+        insert(word, Domain::WordProjection::Full);
+    }
+    return true;
+}
+
+QList<Domain::WordTranslation> CachedWordRepository::getTranslations(int wordId) {
+    return inner_.getTranslations(wordId);
+}
+
+QList<Domain::WordSentence> CachedWordRepository::getSentences(int wordId) {
+    return inner_.getSentences(wordId);
+}
+
+QList<Domain::WordPhrase> CachedWordRepository::getPhrases(int wordId) {
+    return inner_.getPhrases(wordId);
+}
+
+QList<Domain::Word> CachedWordRepository::getByBookId(const QString& bookId,
+                                                      int limit,
+                                                      int offset,
+                                                      Domain::WordProjection projection) {
+    return inner_.getByBookId(bookId, limit, offset, projection);
+}
+
+QList<Domain::Word> CachedWordRepository::searchByWord(const QString& word,
+                                                       Domain::WordProjection projection) {
+    return inner_.searchByWord(word, projection);
+}
+
+QList<Domain::WordSearchHit> CachedWordRepository::search(const QString& text,
+                                                          const QString& bookId, int limit) {
+    return inner_.search(text, bookId, limit);
+}
+
+Domain::Word CachedWordRepository::getByBookAndWord(const QString& bookId,
+                                                    const QString& word) {
+    return inner_.getByBookAndWord(bookId, word);
+}
+
+QList<Domain::WordFingerprint> CachedWordRepository::getFingerprints(const QString& bookId) {
+    return inner_.getFingerprints(bookId);
+}
+
+QList<int> CachedWordRepository::getWordIdsByPos(const QString& bookId,
+                                                 const QStringList& posList) {
+    return inner_.getWordIdsByPos(bookId, posList);
+}
+
+bool CachedWordRepository::saveBatch(const QList<Domain::Word>& words) {
+    // INSERT OR REPLACE 替换旧行时 id 会变：按两个唯一键找出被替换的单词
+    QSet<QPair<QString, int>> wordIds;
+    QSet<QPair<QString, QString>> spellings;
+    for (const Domain::Word& word : words) {
+        wordIds.insert(qMakePair(word.bookId, word.wordId));
+        spellings.insert(qMakePair(word.bookId, word.word));
+    }
+
+    invalidateIf([&](const Domain::Word& cached) {
+        return wordIds.contains(qMakePair(cached.bookId, cached.wordId))
+            || spellings.contains(qMakePair(cached.bookId, cached.word));
+    });
+
+    return inner_.saveBatch(words);
+}
+
+bool CachedWordRepository::removeByBookId(const QString& bookId) {
+    invalidateIf([&](const Domain::Word& cached) {
+        return cached.bookId == bookId;
+    });
+
+    return inner_.removeByBookId(bookId);
+}
+
+bool CachedWordRepository::compressDetails(const QString& bookId) {
+    // 只改变存储格式，解码后的内容不变，缓存无需失效
+    return inner_.compressDetails(bookId);
+}
+
+bool CachedWordRepository::beginTransaction() {
+    return inner_.beginTransaction();
+}
+
+bool CachedWordRepository::commit() {
+    return inner_.commit();
+}
+
+bool CachedWordRepository::rollback() {
+    // 事务内读到并缓存的数据随回滚作废
+    clear();
+    return inner_.rollback();
+}
+
+bool CachedWordRepository::beginBulkLoad() {
+    return inner_.beginBulkLoad();
+}
+
+bool CachedWordRepository::commitBulkLoad() {
+    // 提交前按 (book_id, word) 去重会删除单词
+    clear();
+    return inner_.commitBulkLoad();
+}
+
+bool CachedWordRepository::rollbackBulkLoad() {
+    clear();
+    return inner_.rollbackBulkLoad();
+}
+
+void CachedWordRepository::clear() {
+    stats_.invalidations += entries_.size();
+    entries_.clear();
+    index_.clear();
+    cachedBytes_ = 0;
+}
+
+CachedWordRepository::Stats CachedWordRepository::stats() const {
+    return stats_;
+}
+
+void CachedWordRepository::resetStats() {
+    stats_ = Stats();
+}
+
+int CachedWordRepository::byteBudget() const {
+    return byteBudget_;
+}
+
+int CachedWordRepository::cachedBytes() const {
+    return cachedBytes_;
+}
+
+int CachedWordRepository::cachedWords() const {
+    return index_.size();
+}
+
+const CachedWordRepository::Entry* CachedWordRepository::lookup(
+        int id, Domain::WordProjection projection) {
+    auto it = index_.constFind(id);
+    if (it != index_.constEnd()
+            && (it.value()->full || projection == Domain::WordProjection::Summary)) {
+        entries_.splice(entries_.begin(), entries_, it.value());
+        ++stats_.hits;
+        return &entries_.front();
+    }
+
+    ++stats_.misses;
+    return nullptr;
+}
+
+void CachedWordRepository::insert(const Domain::Word& word, Domain::WordProjection projection) {
+    auto it = index_.find(word.id);
+    if (it != index_.end()) {
+        cachedBytes_ -= it.value()->bytes;
+        entries_.erase(it.value());
+        index_.erase(it);
+    }
+
+    // 超出预算的单个单词不缓存
+    const int bytes = approximateBytes(word);
+    if (bytes > byteBudget_) {
+        return;
+    }
+
+    Entry entry;
+    entry.id = word.id;
+    entry.word = word;
+    entry.full = projection == Domain::WordProjection::Full;
+    entry.bytes = bytes;
+    entries_.push_front(entry);
+    index_.insert(word.id, entries_.begin());
+    cachedBytes_ += bytes;
+
+    // 从最久未用的一端淘汰
+    while (cachedBytes_ > byteBudget_) {
+        cachedBytes_ -= entries_.back().bytes;
+        index_.remove(entries_.back().id);
+        entries_.pop_back();
+    }
+}
+
+void CachedWordRepository::invalidate(int id) {
+    auto it = index_.find(id);
+    if (it == index_.end()) {
+        return;
+    }
+
+    cachedBytes_ -= it.value()->bytes;
+    entries_.erase(it.value());
+    index_.erase(it);
+    ++stats_.invalidations;
+}
+
+template <typename Predicate>
+void CachedWordRepository::invalidateIf(Predicate predicate) {
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        if (predicate(it->word)) {
+            cachedBytes_ -= it->bytes;
+            index_.remove(it->id);
+            it = entries_.erase(it);
+            ++stats_.invalidations;
+        } else {
+            ++it;
+        }
+    }
+}
+
+int CachedWordRepository::approximateBytes(const Domain::Word& word) {
+    int bytes = static_cast<int>(sizeof(Entry));
+    for (const QString* field : {&word.bookId, &word.word, &word.phoneticUk, &word.phoneticUs,
+                                 &word.gloss, &word.translations, &word.sentences,
+                                 &word.phrases, &word.synonyms, &word.relatedWords,
+                                 &word.etymology}) {
+        bytes += field->size() * static_cast<int>(sizeof(QChar));
+    }
+    return bytes;
+}
+
+} // namespace Infrastructure
+} // namespace WordMaster
@@ -0,0 +1,138 @@
+#ifndef WORDMASTER_INFRASTRUCTURE_CACHED_WORD_REPOSITORY_H
+#define WORDMASTER_INFRASTRUCTURE_CACHED_WORD_REPOSITORY_H
+
+#include "domain/repositories.h"
+#include <QHash>
+#include <list>
+
+namespace WordMaster {
+namespace Infrastructure {
+
+/**
+ * @brief 带 LRU 缓存的 Word 仓储（装饰器）
+ *
+ * 按 id 缓存已解码的 Word，总大小按字节预算限制，超出时淘汰最久未用的单词。
+ * 只缓存按 id 的读取（getById、getByIds、loadDetails）；
+ * 按词库、前缀等列表查询直接转发，避免整本词库挤掉常用单词。
+ *
+ * 失效：
+ * - update / remove：按 id 失效
+ * - save / saveBatch：按 (book_id, word_id) 与 (book_id, word) 失效被替换的单词
+ * - removeByBookId：失效该词库的全部单词
+ * - 回滚、批量导入结束，以及其他连接上的导入完成后（调用 clear()）：清空
+ *
+ * 与被装饰的仓储在同一线程使用，不加锁。
+ */
+class CachedWordRepository : public Domain::IWordRepository {
+public:
+    /**
+     * @brief 命中统计
+     */
+    struct Stats {
+        quint64 hits = 0;           // 按 id 读取命中的单词数
+        quint64 misses = 0;         // 未命中、转发给底层仓储的单词数
+        quint64 invalidations = 0;  // 因写入而失效的缓存项数
+
+        double hitRate() const {
+            quint64 lookups = hits + misses;
+            return lookups > 0 ? static_cast<double>(hits) / lookups : 0.0;
+        }
+    };
+
+    // 默认字节预算
+    static const int kDefaultByteBudget = 8 * 1024 * 1024;
+
+    explicit CachedWordRepository(Domain::IWordRepository& inner,
+                                  int byteBudget = kDefaultByteBudget);
+    ~CachedWordRepository() override = default;
+
+    // 基本CRUD
+    bool save(const Domain::Word& word) override;
+    Domain::Word getById(int id, Domain::WordProjection projection =
+                                     Domain::WordProjection::Full) override;
+    QList<Domain::Word> getByIds(const QList<int>& ids,
+                                 Domain::WordProjection projection =
+                                     Domain::WordProjection::Full) override;
+    bool remove(int id) override;
+    bool exists(int id) override;
+    bool update(const Domain::Word& word) override;
+    bool loadDetails(Domain::Word& word) override;
+
+    QList<Domain::WordTranslation> getTranslations(int wordId) override;
+    QList<Domain::WordSentence> getSentences(int wordId) override;
+    QList<Domain::WordPhrase> getPhrases(int wordId) override;
+
+    // 查询（不经缓存）
+    QList<Domain::Word> getByBookId(const QString& bookId,
+                                     int limit = -1,
+                                     int offset = 0,
+                                     Domain::WordProjection projection =
+                                         Domain::WordProjection::Full) override;
+    QList<Domain::Word> searchByWord(const QString& word,
+                                     Domain::WordProjection projection =
+                                         Domain::WordProjection::Full) override;
+    QList<Domain::WordSearchHit> search(const QString& text, const QString& bookId = QString(),
+                                        int limit = 50) override;
+    Domain::Word getByBookAndWord(const QString& bookId,
+                                  const QString& word) override;
+    QList<Domain::WordFingerprint> getFingerprints(const QString& bookId) override;
+    QList<int> getWordIdsByPos(const QString& bookId, const QStringList& posList) override;
+
+    // 批量操作
+    bool saveBatch(const QList<Domain::Word>& words) override;
+    bool removeByBookId(const QString& bookId) override;
+    bool compressDetails(const QString& bookId) override;
+
+    // 事务支持
+    bool beginTransaction() override;
+    bool commit() override;
+    bool rollback() override;
+    bool beginBulkLoad() override;
+    bool commitBulkLoad() override;
+    bool rollbackBulkLoad() override;
+
+    /**
+     * @brief 清空缓存（数据在其他连接上被修改后调用，如后台导入完成）
+     */
+    void clear();
+
+    Stats stats() const;
+    void resetStats();
+
+    int byteBudget() const;
+    int cachedBytes() const;
+    int cachedWords() const;
+
+private:
+    struct Entry {
+        int id;
+        Domain::Word word;
+        bool full;                  // 是否含 word_details 中的 JSON 字段
+        int bytes;                  // 估算的内存占用
+    };
+    using EntryList = std::list<Entry>;
+
+    Domain::IWordRepository& inner_;
+    int byteBudget_;
+    int cachedBytes_;
+    EntryList entries_;             // 最近使用的在前
+    QHash<int, EntryList::iterator> index_;
+    Stats stats_;
+
+    // 命中时返回缓存项并移到最前；Summary 缓存项不满足 Full 读取
+    const Entry* lookup(int id, Domain::WordProjection projection);
+    void insert(const Domain::Word& word, Domain::WordProjection projection);
+    void invalidate(int id);
+
+    // 失效满足条件的全部缓存项（不改变其余项的使用顺序）
+    template <typename Predicate>
+    void invalidateIf(Predicate predicate);
+
+    // Word 的估算内存占用（字符串按 UTF-16 计）
+    static int approximateBytes(const Domain::Word& word);
+};
+
+} // namespace Infrastructure
+} // namespace WordMaster
+
+#endif // WORDMASTER_INFRASTRUCTURE_CACHED_WORD_REPOSITORY_H
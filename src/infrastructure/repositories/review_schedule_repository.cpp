@@ -4,6 +4,14 @@
 namespace WordMaster {
 namespace Infrastructure {
 
+namespace {
+
+const char* const kPlanColumns =
+    "word_id, book_id, next_review_date, review_interval, repetition_count, "
+    "easiness_factor, last_review_date, mastery_level, created_at, updated_at";
+
+} // namespace
+
 ReviewScheduleRepository::ReviewScheduleRepository(SQLiteAdapter& adapter)
     : adapter_(adapter)
 {
@@ -30,7 +38,7 @@ bool ReviewScheduleRepository::save(const Domain::ReviewPlan& plan) {
         : QVariant());
     query.addBindValue(Domain::ReviewPlan::masteryLevelToInt(plan.masteryLevel));
     
-    if (!query.exec()) {
+    if (!adapter_.exec(query)) {
         qWarning() << "Failed to save review plan:" << query.lastError().text();
         return false;
     }
@@ -39,12 +47,13 @@ bool ReviewScheduleRepository::save(const Domain::ReviewPlan& plan) {
 }
 
 Domain::ReviewPlan ReviewScheduleRepository::get(int wordId) {
-    QString sql = "SELECT * FROM review_schedule WHERE word_id = ?";
+    QString sql = QString("SELECT %1 FROM review_schedule WHERE word_id = ?")
+                      .arg(kPlanColumns);
     
     auto query = adapter_.prepare(sql);
     query.addBindValue(wordId);
     
-    if (!query.exec()) {
+    if (!adapter_.exec(query)) {
         qWarning() << "Failed to query review plan:" << query.lastError().text();
         return Domain::ReviewPlan();
     }
@@ -62,7 +71,7 @@ bool ReviewScheduleRepository::remove(int wordId) {
     auto query = adapter_.prepare(sql);
     query.addBindValue(wordId);
     
-    if (!query.exec()) {
+    if (!adapter_.exec(query)) {
         qWarning() << "Failed to delete review plan:" << query.lastError().text();
         return false;
     }
@@ -76,7 +85,7 @@ bool ReviewScheduleRepository::exists(int wordId) {
     auto query = adapter_.prepare(sql);
     query.addBindValue(wordId);
     
-    if (query.exec() && query.next()) {
+    if (adapter_.exec(query) && query.next()) {
         return query.value("cnt").toInt() > 0;
     }
     
@@ -84,8 +93,6 @@ bool ReviewScheduleRepository::exists(int wordId) {
 }
 
 QList<int> ReviewScheduleRepository::getTodayReviewWords(const QString& bookId) {
-    QList<int> wordIds;
-    
     QString sql = R"(
         SELECT word_id FROM review_schedule
         WHERE book_id = ?
@@ -94,26 +101,10 @@ QList<int> ReviewScheduleRepository::getTodayReviewWords(const QString& bookId)
         ORDER BY next_review_date ASC, repetition_count ASC
     )";
     
-    auto query = adapter_.prepare(sql);
-    query.addBindValue(bookId);
-    
-    if (!query.exec()) {
-        qWarning() << "Failed to query today review words:" << query.lastError().text();
-        return wordIds;
-    }
-    
-    while (query.next()) {
-        wordIds.append(query.value("word_id").toInt());
-    }
-    
-    qDebug() << "Today review words for" << bookId << ":" << wordIds.size();
-    
-    return wordIds;
+    return queryWordIds(sql, bookId);
 }
 
 QList<int> ReviewScheduleRepository::getOverdueWords(const QString& bookId) {
-    QList<int> wordIds;
-    
     QString sql = R"(
         SELECT word_id FROM review_schedule
         WHERE book_id = ?
@@ -122,27 +113,13 @@ QList<int> ReviewScheduleRepository::getOverdueWords(const QString& bookId) {
         ORDER BY next_review_date ASC
     )";
     
-    auto query = adapter_.prepare(sql);
-    query.addBindValue(bookId);
-    
-    if (!query.exec()) {
-        qWarning() << "Failed to query overdue words:" << query.lastError().text();
-        return wordIds;
-    }
-    
-    while (query.next()) {
-        wordIds.append(query.value("word_id").toInt());
-    }
-    
-    return wordIds;
+    return queryWordIds(sql, bookId);
 }
 
 QList<int> ReviewScheduleRepository::getUnlearnedWords(
     const QString& bookId, 
     int limit) 
 {
-    QList<int> wordIds;
-    
     QString sql = R"(
         SELECT w.id FROM words w
         LEFT JOIN review_schedule rs ON w.id = rs.word_id
@@ -155,19 +132,7 @@ QList<int> ReviewScheduleRepository::getUnlearnedWords(
         sql += QString(" LIMIT %1").arg(limit);
     }
     
-    auto query = adapter_.prepare(sql);
-    query.addBindValue(bookId);
-    
-    if (!query.exec()) {
-        qWarning() << "Failed to query unlearned words:" << query.lastError().text();
-        return wordIds;
-    }
-    
-    while (query.next()) {
-        wordIds.append(query.value("id").toInt());
-    }
-    
-    return wordIds;
+    return queryWordIds(sql, bookId);
 }
 
 int ReviewScheduleRepository::getLearnedCount(const QString& bookId) {
@@ -179,7 +144,7 @@ int ReviewScheduleRepository::getLearnedCount(const QString& bookId) {
     auto query = adapter_.prepare(sql);
     query.addBindValue(bookId);
     
-    if (query.exec() && query.next()) {
+    if (adapter_.exec(query) && query.next()) {
         return query.value("cnt").toInt();
     }
     
@@ -195,7 +160,7 @@ int ReviewScheduleRepository::getMasteredCount(const QString& bookId) {
     auto query = adapter_.prepare(sql);
     query.addBindValue(bookId);
     
-    if (query.exec() && query.next()) {
+    if (adapter_.exec(query) && query.next()) {
         return query.value("cnt").toInt();
     }
     
@@ -206,29 +171,65 @@ int ReviewScheduleRepository::getTodayReviewCount(const QString& bookId) {
     return getTodayReviewWords(bookId).size();
 }
 
+QList<int> ReviewScheduleRepository::queryWordIds(const QString& sql,
+                                                  const QString& bookId) {
+    QList<int> wordIds;
+    
+#ifdef WORDMASTER_NATIVE_SQLITE
+    NativeStatement statement = adapter_.prepareNative(sql);
+    if (statement.isValid()) {
+        statement.bind(0, bookId);
+        while (statement.next()) {
+            wordIds.append(statement.columnInt(0));
+        }
+        if (statement.hasError()) {
+            qWarning() << "Failed to query word ids:" << statement.lastError();
+        }
+        adapter_.recordNative(statement, sql, QVariantList() << bookId);
+        return wordIds;
+    }
+#endif
+    
+    auto query = adapter_.prepare(sql);
+    query.addBindValue(bookId);
+    
+    if (!adapter_.exec(query)) {
+        qWarning() << "Failed to query word ids:" << query.lastError().text();
+        return wordIds;
+    }
+    
+    while (query.next()) {
+        wordIds.append(query.value(0).toInt());
+    }
+    adapter_.recordRowsReturned(query, wordIds.size());
+    
+    return wordIds;
+}
+
+// 列序号与 kPlanColumns 一致
 Domain::ReviewPlan ReviewScheduleRepository::buildPlanFromQuery(QSqlQuery& query) {
     Domain::ReviewPlan plan;
     
-    plan.wordId = query.value("word_id").toInt();
-    plan.bookId = query.value("book_id").toString();
+    plan.wordId = query.value(0).toInt();
+    plan.bookId = query.value(1).toString();
     plan.nextReviewDate = QDate::fromString(
-        query.value("next_review_date").toString(), 
+        query.value(2).toString(), 
         Qt::ISODate
     );
-    plan.reviewInterval = query.value("review_interval").toInt();
-    plan.repetitionCount = query.value("repetition_count").toInt();
-    plan.easinessFactor = query.value("easiness_factor").toDouble();
+    plan.reviewInterval = query.value(3).toInt();
+    plan.repetitionCount = query.value(4).toInt();
+    plan.easinessFactor = query.value(5).toDouble();
     
-    QString lastReviewStr = query.value("last_review_date").toString();
+    QString lastReviewStr = query.value(6).toString();
     if (!lastReviewStr.isEmpty()) {
         plan.lastReviewDate = QDate::fromString(lastReviewStr, Qt::ISODate);
     }
     
     plan.masteryLevel = Domain::ReviewPlan::intToMasteryLevel(
-        query.value("mastery_level").toInt()
+        query.value(7).toInt()
     );
-    plan.createdAt = query.value("created_at").toDateTime();
-    plan.updatedAt = query.value("updated_at").toDateTime();
+    plan.createdAt = query.value(8).toDateTime();
+    plan.updatedAt = query.value(9).toDateTime();
     
     return plan;
 }
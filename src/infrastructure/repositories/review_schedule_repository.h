@@ -39,6 +39,9 @@ public:
 private:
     SQLiteAdapter& adapter_;
     
+    // 执行按词库过滤、返回单词ID列表的查询（原生后端可用时绕过 QSqlQuery）
+    QList<int> queryWordIds(const QString& sql, const QString& bookId);
+    
     // 辅助方法：从 QSqlQuery 构建 ReviewPlan 对象
     Domain::ReviewPlan buildPlanFromQuery(QSqlQuery& query);
 };
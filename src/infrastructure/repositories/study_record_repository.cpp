@@ -23,7 +23,7 @@ bool StudyRecordRepository::save(const Domain::StudyRecord& record) {
     query.addBindValue(Domain::StudyRecord::resultToString(record.result));
     query.addBindValue(record.studyDuration);
     
-    if (!query.exec()) {
+    if (!adapter_.exec(query)) {
         qWarning() << "Failed to save study record:" << query.lastError().text();
         return false;
     }
@@ -37,7 +37,7 @@ Domain::StudyRecord StudyRecordRepository::getById(int id) {
     auto query = adapter_.prepare(sql);
     query.addBindValue(id);
     
-    if (!query.exec()) {
+    if (!adapter_.exec(query)) {
         qWarning() << "Failed to query study record:" << query.lastError().text();
         return Domain::StudyRecord();
     }
@@ -61,7 +61,7 @@ QList<Domain::StudyRecord> StudyRecordRepository::getByWordId(int wordId) {
     auto query = adapter_.prepare(sql);
     query.addBindValue(wordId);
     
-    if (!query.exec()) {
+    if (!adapter_.exec(query)) {
         qWarning() << "Failed to query records by word:" << query.lastError().text();
         return records;
     }
@@ -69,6 +69,7 @@ QList<Domain::StudyRecord> StudyRecordRepository::getByWordId(int wordId) {
     while (query.next()) {
         records.append(buildRecordFromQuery(query));
     }
+    adapter_.recordRowsReturned(query, records.size());
     
     return records;
 }
@@ -81,15 +82,16 @@ QList<Domain::StudyRecord> StudyRecordRepository::getByDateRange(
     
     QString sql = R"(
         SELECT * FROM study_records 
-        WHERE DATE(studied_at) BETWEEN ? AND ?
+        WHERE studied_at >= ? AND studied_at < ?
         ORDER BY studied_at DESC
     )";
     
+    // 对列套 DATE() 会使 studied_at 索引失效，改为半开区间 [start, end + 1)
     auto query = adapter_.prepare(sql);
     query.addBindValue(start.toString(Qt::ISODate));
-    query.addBindValue(end.toString(Qt::ISODate));
+    query.addBindValue(end.addDays(1).toString(Qt::ISODate));
     
-    if (!query.exec()) {
+    if (!adapter_.exec(query)) {
         qWarning() << "Failed to query records by date range:" << query.lastError().text();
         return records;
     }
@@ -97,6 +99,7 @@ QList<Domain::StudyRecord> StudyRecordRepository::getByDateRange(
     while (query.next()) {
         records.append(buildRecordFromQuery(query));
     }
+    adapter_.recordRowsReturned(query, records.size());
     
     return records;
 }
@@ -106,7 +109,7 @@ QList<Domain::StudyRecord> StudyRecordRepository::getTodayRecords() {
     
     QString sql = R"(
         SELECT * FROM study_records 
-        WHERE DATE(studied_at) = DATE('now')
+        WHERE studied_at >= DATE('now') AND studied_at < DATE('now', '+1 day')
         ORDER BY studied_at DESC
     )";
     
@@ -115,6 +118,7 @@ QList<Domain::StudyRecord> StudyRecordRepository::getTodayRecords() {
     while (query.next()) {
         records.append(buildRecordFromQuery(query));
     }
+    adapter_.recordRowsReturned(query, records.size());
     
     return records;
 }
@@ -133,7 +137,7 @@ QList<Domain::StudyRecord> StudyRecordRepository::getByBookId(
     auto query = adapter_.prepare(sql);
     query.addBindValue(bookId);
     
-    if (!query.exec()) {
+    if (!adapter_.exec(query)) {
         qWarning() << "Failed to query records by book:" << query.lastError().text();
         return records;
     }
@@ -141,6 +145,7 @@ QList<Domain::StudyRecord> StudyRecordRepository::getByBookId(
     while (query.next()) {
         records.append(buildRecordFromQuery(query));
     }
+    adapter_.recordRowsReturned(query, records.size());
     
     return records;
 }
@@ -150,13 +155,14 @@ int StudyRecordRepository::getTodayLearnCount(const QString& bookId) {
         SELECT COUNT(*) as cnt FROM study_records
         WHERE book_id = ?
           AND study_type = 'learn'
-          AND DATE(studied_at) = DATE('now')
+          AND studied_at >= DATE('now')
+          AND studied_at < DATE('now', '+1 day')
     )";
     
     auto query = adapter_.prepare(sql);
     query.addBindValue(bookId);
     
-    if (query.exec() && query.next()) {
+    if (adapter_.exec(query) && query.next()) {
         return query.value("cnt").toInt();
     }
     
@@ -168,13 +174,14 @@ int StudyRecordRepository::getTodayReviewCount(const QString& bookId) {
         SELECT COUNT(*) as cnt FROM study_records
         WHERE book_id = ?
           AND study_type = 'review'
-          AND DATE(studied_at) = DATE('now')
+          AND studied_at >= DATE('now')
+          AND studied_at < DATE('now', '+1 day')
     )";
     
     auto query = adapter_.prepare(sql);
     query.addBindValue(bookId);
     
-    if (query.exec() && query.next()) {
+    if (adapter_.exec(query) && query.next()) {
         return query.value("cnt").toInt();
     }
     
@@ -184,13 +191,14 @@ int StudyRecordRepository::getTodayReviewCount(const QString& bookId) {
 int StudyRecordRepository::getTotalStudyDuration(const QDate& date) {
     QString sql = R"(
         SELECT SUM(study_duration) as total FROM study_records
-        WHERE DATE(studied_at) = ?
+        WHERE studied_at >= ? AND studied_at < ?
     )";
     
     auto query = adapter_.prepare(sql);
     query.addBindValue(date.toString(Qt::ISODate));
+    query.addBindValue(date.addDays(1).toString(Qt::ISODate));
     
-    if (query.exec() && query.next()) {
+    if (adapter_.exec(query) && query.next()) {
         return query.value("total").toInt();
     }
     
@@ -0,0 +1,77 @@
+#include "user_preference_repository.h"
+#include <QDebug>
+
+namespace WordMaster {
+namespace Infrastructure {
+
+using namespace Domain;
+
+UserPreferenceRepository::UserPreferenceRepository(SQLiteAdapter& adapter)
+    : adapter_(adapter)
+{
+}
+
+bool UserPreferenceRepository::save(const UserPreference& pref) {
+    QString sql = R"(
+        INSERT OR REPLACE INTO user_preferences (key, value, updated_at)
+        VALUES (?, ?, CURRENT_TIMESTAMP)
+    )";
+    
+    auto query = adapter_.prepare(sql);
+    query.addBindValue(pref.key);
+    query.addBindValue(pref.value);
+    
+    if (!adapter_.exec(query)) {
+        qWarning() << "Failed to save preference:" << query.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+QString UserPreferenceRepository::get(const QString& key, const QString& defaultValue) {
+    QString sql = "SELECT value FROM user_preferences WHERE key = ?";
+    
+    auto query = adapter_.prepare(sql);
+    query.addBindValue(key);
+    
+    if (adapter_.exec(query) && query.next()) {
+        return query.value("value").toString();
+    }
+    return defaultValue;
+}
+
+bool UserPreferenceRepository::exists(const QString& key) {
+    QString sql = "SELECT COUNT(*) as cnt FROM user_preferences WHERE key = ?";
+    
+    auto query = adapter_.prepare(sql);
+    query.addBindValue(key);
+    
+    if (adapter_.exec(query) && query.next()) {
+        return query.value("cnt").toInt() > 0;
+    }
+    return false;
+}
+
+bool UserPreferenceRepository::remove(const QString& key) {
+    QString sql = "DELETE FROM user_preferences WHERE key = ?";
+    
+    auto query = adapter_.prepare(sql);
+    query.addBindValue(key);
+    
+    return adapter_.exec(query);
+}
+
+QMap<QString, QString> UserPreferenceRepository::getAll() {
+    QMap<QString, QString> prefs;
+    
+    auto query = adapter_.query("SELECT key, value FROM user_preferences");
+    while (query.next()) {
+        prefs.insert(query.value("key").toString(), query.value("value").toString());
+    }
+    adapter_.recordRowsReturned(query, prefs.size());
+    
+    return prefs;
+}
+
+} // namespace Infrastructure
+} // namespace WordMaster
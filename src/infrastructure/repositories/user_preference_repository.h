@@ -0,0 +1,29 @@
+#ifndef WORDMASTER_INFRASTRUCTURE_USER_PREFERENCE_REPOSITORY_H
+#define WORDMASTER_INFRASTRUCTURE_USER_PREFERENCE_REPOSITORY_H
+
+#include "domain/repositories.h"
+#include "infrastructure/sqlite_adapter.h"
+
+namespace WordMaster {
+namespace Infrastructure {
+
+class UserPreferenceRepository : public Domain::IUserPreferenceRepository {
+public:
+    explicit UserPreferenceRepository(SQLiteAdapter& adapter);
+    ~UserPreferenceRepository() override = default;
+    
+    bool save(const Domain::UserPreference& pref) override;
+    QString get(const QString& key, const QString& defaultValue = QString()) override;
+    bool exists(const QString& key) override;
+    bool remove(const QString& key) override;
+    
+    QMap<QString, QString> getAll() override;
+
+private:
+    SQLiteAdapter& adapter_;
+};
+
+} // namespace Infrastructure
+} // namespace WordMaster
+
+#endif
@@ -1,11 +1,428 @@
 #include "word_repository.h"
+#include <QVector>
+#include <QStringList>
+#include <QSet>
+#include <QHash>
+#include <QPair>
+#include <QElapsedTimer>
 #include <QDebug>
+#include <limits>
 
 namespace WordMaster {
 namespace Infrastructure {
 
+namespace {
+
+// 显式列清单：按序号读取，避免 SELECT * 与按列名查找
+// 前 8 列为 words 热数据（Summary），后 6 列来自 word_details（Full）
+const char* const kSummaryColumns =
+    "w.id, w.book_id, w.word_id, w.word, w.phonetic_uk, w.phonetic_us, w.gloss, w.created_at";
+const char* const kDetailColumns =
+    "d.translations, d.sentences, d.phrases, d.synonyms, d.related_words, d.etymology";
+const int kSummaryColumnCount = 8;
+const int kDetailColumnCount = 6;
+
+// 写入列（按绑定顺序）
+const char* const kInsertColumns =
+    "book_id, word_id, word, phonetic_uk, phonetic_us, gloss, content_hash";
+const int kInsertColumnCount = 7;
+
+// word_details 按 (book_id, word_id) 找到刚写入的 words.id，多行 INSERT 无需逐行取 lastInsertId
+const char* const kDetailInsertColumns =
+    "word_id, translations, sentences, phrases, synonyms, related_words, etymology";
+const char* const kDetailInsertRow =
+    "((SELECT id FROM words WHERE book_id = ? AND word_id = ?), ?, ?, ?, ?, ?, ?)";
+const int kDetailInsertParamCount = 8;
+
+// SQLite 3.32 之前 SQLITE_MAX_VARIABLE_NUMBER 默认为 999，按此上限确定每条语句的行数
+const int kMaxBoundVariables = 999;
+const int kBulkInsertRows = kMaxBoundVariables / kInsertColumnCount;
+const int kBulkDetailRows = kMaxBoundVariables / kDetailInsertParamCount;
+
+// 保证同一词库内单词唯一的索引；批量导入期间删除，提交前需先去重
+const char* const kUniqueWordIndex = "idx_words_book_word";
+
+// 结构化子表：每行的单词 id 由表达式给出（saveBatch 按 (book_id, word_id) 子查询，update 直接用 id）
+struct ChildTable {
+    const char* name;
+    const char* keyColumn;          // 单词 id 所在的列
+    const char* columns;            // 单词 id 之后的列
+    int columnCount;
+};
+
+const ChildTable kTranslationTable = {"word_translations", "word_id",
+                                      "position, book_id, pos, meaning", 4};
+const ChildTable kSentenceTable = {"word_sentences", "word_id", "position, english, chinese", 3};
+const ChildTable kPhraseTable = {"word_phrases", "word_id", "position, phrase, meaning", 3};
+
+// 全文索引（FTS5 虚表，rowid 即 words.id），由迁移 008 创建（SQLite 不含 FTS5 时不存在）。
+// 删除单词由触发器同步删除索引行；INSERT OR REPLACE 替换单词不触发，由 saveBatch 先删除
+const ChildTable kSearchTable = {"word_search", "rowid", "word, meaning, sentence, phrase", 4};
+
+// bm25 的列权重（按列顺序）：单词 > 释义 > 例句 > 短语
+const char* const kSearchWeights = "10.0, 4.0, 2.0, 1.0";
+
+// 中文没有空格分词：unicode61 会把连续的汉字当作一个词，
+// 索引与查询时在 CJK 字符之间插入零宽空格（分隔符），按字建索引，多字查询按短语匹配
+const QChar kCjkSeparator(0x200B);
+
+// 重建索引时每批读取的单词数
+const int kSearchRebuildBatch = 1000;
+
+// 删除被替换单词的索引行时每组的单词数：每个单词两条 SELECT、4 个参数，
+// 受参数上限与复合查询的 SELECT 数上限（默认 500）约束
+const int kReplacedSearchRows = qMin(kMaxBoundVariables / 4, 500 / 2);
+
+const char* const kWordIdByKey = "(SELECT id FROM words WHERE book_id = ? AND word_id = ?)";
+const char* const kWordIdParam = "?";
+
+// getByIds 每条语句查询的 id 数；不足一组时用 kPaddingId 补齐（自增 id 从 1 开始，不会命中）
+const int kIdChunkSize = 256;
+const int kPaddingId = 0;
+
+QString idListClause(int count) {
+    return QString(" WHERE w.id IN (%1?)").arg(QString("?, ").repeated(count - 1));
+}
+
+QString selectWordsSql(Domain::WordProjection projection) {
+    if (projection == Domain::WordProjection::Summary) {
+        return QString("SELECT %1 FROM words w").arg(kSummaryColumns);
+    }
+    return QString("SELECT %1, %2 FROM words w LEFT JOIN word_details d ON d.word_id = w.id")
+        .arg(kSummaryColumns, kDetailColumns);
+}
+
+// 多行 INSERT：VALUES (?, ...), (?, ...), ...
+QString insertWordsSql(int rows) {
+    QStringList placeholders;
+    for (int i = 0; i < kInsertColumnCount; ++i) {
+        placeholders << "?";
+    }
+    QString row = "(" + placeholders.join(", ") + ")";
+    
+    QStringList values;
+    values.reserve(rows);
+    for (int i = 0; i < rows; ++i) {
+        values << row;
+    }
+    
+    return QString("INSERT OR REPLACE INTO words (%1) VALUES %2")
+        .arg(kInsertColumns, values.join(", "));
+}
+
+// 将被 INSERT OR REPLACE 替换的单词：按 (book_id, word_id) 与 (book_id, word) 两个唯一键查找。
+// 批量导入期间 (book_id, word) 索引已删除，只按 word_id 查找；
+// 同词不同 word_id 的旧行在提交去重时以普通 DELETE 删除，由触发器删除索引行
+QString deleteReplacedSearchSql(int rows, bool byWord) {
+    QString key = "SELECT id FROM words WHERE book_id = ? AND word_id = ?";
+    if (byWord) {
+        key += " UNION ALL SELECT id FROM words WHERE book_id = ? AND word = ?";
+    }
+    
+    QStringList keys;
+    keys.reserve(rows);
+    for (int i = 0; i < rows; ++i) {
+        keys << key;
+    }
+    return QString("DELETE FROM word_search WHERE rowid IN (%1)").arg(keys.join(" UNION ALL "));
+}
+
+void bindWordKey(QSqlQuery& query, const Domain::Word& word) {
+    query.addBindValue(word.bookId);
+    query.addBindValue(word.wordId);
+    query.addBindValue(word.bookId);
+    query.addBindValue(word.word);
+}
+
+void bindWordIdKey(QSqlQuery& query, const Domain::Word& word) {
+    query.addBindValue(word.bookId);
+    query.addBindValue(word.wordId);
+}
+
+QString insertDetailsSql(int rows) {
+    QStringList values;
+    values.reserve(rows);
+    for (int i = 0; i < rows; ++i) {
+        values << kDetailInsertRow;
+    }
+    
+    return QString("INSERT OR REPLACE INTO word_details (%1) VALUES %2")
+        .arg(kDetailInsertColumns, values.join(", "));
+}
+
+QString insertChildSql(const ChildTable& table, const QString& wordIdExpr, int rows) {
+    QString row = "(" + wordIdExpr + QString(", ?").repeated(table.columnCount) + ")";
+    
+    QStringList values;
+    values.reserve(rows);
+    for (int i = 0; i < rows; ++i) {
+        values << row;
+    }
+    
+    return QString("INSERT OR REPLACE INTO %1 (%2, %3) VALUES %4")
+        .arg(table.name, table.keyColumn, table.columns, values.join(", "));
+}
+
+QString glossOf(const Domain::Word& word) {
+    return word.gloss.isEmpty() ? Domain::Word::glossFromTranslations(word.translations)
+                                : word.gloss;
+}
+
+void bindWord(QSqlQuery& query, const Domain::Word& word) {
+    query.addBindValue(word.bookId);
+    query.addBindValue(word.wordId);
+    query.addBindValue(word.word);
+    query.addBindValue(word.phoneticUk);
+    query.addBindValue(word.phoneticUs);
+    query.addBindValue(glossOf(word));
+    query.addBindValue(word.contentHash());
+}
+
+void bindDetailFields(QSqlQuery& query, const Domain::Word& word) {
+    query.addBindValue(word.translations);
+    query.addBindValue(word.sentences);
+    query.addBindValue(word.phrases);
+    query.addBindValue(word.synonyms);
+    query.addBindValue(word.relatedWords);
+    query.addBindValue(word.etymology);
+}
+
+void bindDetails(QSqlQuery& query, const Domain::Word& word) {
+    query.addBindValue(word.bookId);
+    query.addBindValue(word.wordId);
+    bindDetailFields(query, word);
+}
+
+void bindRow(QSqlQuery& query, const QVariantList& row) {
+    for (const QVariant& value : row) {
+        query.addBindValue(value);
+    }
+}
+
+/**
+ * @brief 分组执行多行 INSERT：整组用 rows 行的语句，余数逐行写入
+ * @return 执行的语句数，失败返回 -1
+ */
+template <typename T>
+int insertGrouped(SQLiteAdapter& adapter, const QList<T>& words, int rows,
+                  const QString& bulkSql, const QString& singleSql,
+                  void (*bind)(QSqlQuery&, const T&)) {
+    const int count = words.size();
+    int statements = 0;
+    int next = 0;
+    
+    for (; next + rows <= count; next += rows) {
+        auto query = adapter.prepare(bulkSql);
+        for (int i = next; i < next + rows; ++i) {
+            bind(query, words[i]);
+        }
+        
+        if (!adapter.exec(query)) {
+            qWarning() << "Failed to save word batch:" << query.lastError().text();
+            return -1;
+        }
+        ++statements;
+    }
+    
+    for (; next < count; ++next) {
+        auto query = adapter.prepare(singleSql);
+        bind(query, words[next]);
+        
+        if (!adapter.exec(query)) {
+            qWarning() << "Failed to save word:" << query.lastError().text();
+            return -1;
+        }
+        ++statements;
+    }
+    
+    return statements;
+}
+
+bool isCjk(QChar c) {
+    switch (c.script()) {
+    case QChar::Script_Han:
+    case QChar::Script_Hiragana:
+    case QChar::Script_Katakana:
+    case QChar::Script_Hangul:
+        return true;
+    default:
+        return false;
+    }
+}
+
+QString segmentCjk(const QString& text) {
+    QString segmented;
+    segmented.reserve(text.size() * 2);
+    for (int i = 0; i < text.size(); ++i) {
+        if (i > 0 && (isCjk(text[i]) || isCjk(text[i - 1]))) {
+            segmented += kCjkSeparator;
+        }
+        segmented += text[i];
+    }
+    return segmented;
+}
+
+/**
+ * @brief 把用户输入转换为 FTS5 查询：每个词加引号（转义语法字符），
+ *        以字母数字结尾的词按前缀匹配，各词之间为 AND
+ * @return 没有可检索的字符时返回空
+ */
+QString ftsQuery(const QString& text) {
+    QStringList terms;
+    for (const QString& term : text.simplified().split(' ')) {
+        bool searchable = false;
+        for (QChar c : term) {
+            searchable = searchable || c.isLetterOrNumber();
+        }
+        if (!searchable) {
+            continue;
+        }
+        
+        QString quoted = QString("\"%1\"").arg(segmentCjk(term).replace('"', "\"\""));
+        const QChar last = term.at(term.size() - 1);
+        if (last.isLetterOrNumber() && !isCjk(last)) {
+            quoted += '*';
+        }
+        terms << quoted;
+    }
+    return terms.join(' ');
+}
+
+// 不区分大小写地标出 text 中首次出现的 needle（全文索引不可用时的片段）
+QString markFirst(const QString& text, const QString& needle) {
+    int index = text.indexOf(needle, 0, Qt::CaseInsensitive);
+    if (index < 0) {
+        return QString();
+    }
+    return text.left(index) + Domain::WordSearchHit::kMatchBegin + text.mid(index, needle.size())
+         + Domain::WordSearchHit::kMatchEnd + text.mid(index + needle.size());
+}
+
+/**
+ * @brief 待写入的子表行：每行为单词 id 的参数（key）加 ChildTable 的各列
+ */
+struct ChildRows {
+    QList<QVariantList> translations;
+    QList<QVariantList> sentences;
+    QList<QVariantList> phrases;
+    QList<QVariantList> search;     // 全文索引行（索引存在时才写入）
+    
+    // 解析线程已填充结构化字段时直接使用，否则（如词库包、调用方自建的 Word）在此解析
+    void append(const Domain::Word& word, const QVariantList& key) {
+        QList<Domain::WordTranslation> translationItems = word.translationItems.isEmpty()
+            ? Domain::WordTranslation::listFromJson(word.translations) : word.translationItems;
+        QList<Domain::WordSentence> sentenceItems = word.sentenceItems.isEmpty()
+            ? Domain::WordSentence::listFromJson(word.sentences) : word.sentenceItems;
+        QList<Domain::WordPhrase> phraseItems = word.phraseItems.isEmpty()
+            ? Domain::WordPhrase::listFromJson(word.phrases) : word.phraseItems;
+        
+        for (int i = 0; i < translationItems.size(); ++i) {
+            translations.append(QVariantList(key) << i << word.bookId
+                                << translationItems[i].pos << translationItems[i].meaning);
+        }
+        for (int i = 0; i < sentenceItems.size(); ++i) {
+            sentences.append(QVariantList(key) << i << sentenceItems[i].english
+                             << sentenceItems[i].chinese);
+        }
+        for (int i = 0; i < phraseItems.size(); ++i) {
+            phrases.append(QVariantList(key) << i << phraseItems[i].phrase
+                           << phraseItems[i].meaning);
+        }
+        
+        QStringList meaningText;
+        for (const Domain::WordTranslation& item : translationItems) {
+            meaningText << item.meaning;
+        }
+        QStringList sentenceText;
+        for (const Domain::WordSentence& item : sentenceItems) {
+            sentenceText << item.english << item.chinese;
+        }
+        QStringList phraseText;
+        for (const Domain::WordPhrase& item : phraseItems) {
+            phraseText << item.phrase << item.meaning;
+        }
+        search.append(QVariantList(key) << word.word
+                      << segmentCjk(meaningText.join(QString::fromUtf8("；")))
+                      << segmentCjk(sentenceText.join(' '))
+                      << segmentCjk(phraseText.join(QString::fromUtf8("；"))));
+    }
+};
+
+/**
+ * @brief 写入一张子表；每条语句的行数按参数上限确定
+ * @return 执行的语句数，失败返回 -1
+ */
+int insertChildRows(SQLiteAdapter& adapter, const ChildTable& table, const QString& wordIdExpr,
+                    int keyParamCount, const QList<QVariantList>& rows) {
+    if (rows.isEmpty()) {
+        return 0;
+    }
+    
+    const int groupRows = kMaxBoundVariables / (keyParamCount + table.columnCount);
+    return insertGrouped(adapter, rows, groupRows,
+                         insertChildSql(table, wordIdExpr, groupRows),
+                         insertChildSql(table, wordIdExpr, 1), bindRow);
+}
+
+int insertChildRows(SQLiteAdapter& adapter, const QString& wordIdExpr, int keyParamCount,
+                    const ChildRows& rows, bool searchIndex) {
+    int statements = 0;
+    const QList<QVariantList> noRows;
+    const QPair<const ChildTable*, const QList<QVariantList>*> tables[] = {
+        qMakePair(&kTranslationTable, &rows.translations),
+        qMakePair(&kSentenceTable, &rows.sentences),
+        qMakePair(&kPhraseTable, &rows.phrases),
+        qMakePair(&kSearchTable, searchIndex ? &rows.search : &noRows),
+    };
+    for (const auto& table : tables) {
+        int count = insertChildRows(adapter, *table.first, wordIdExpr, keyParamCount,
+                                    *table.second);
+        if (count < 0) {
+            return -1;
+        }
+        statements += count;
+    }
+    return statements;
+}
+
+// 字典训练样本：总量不足 kMinTrainingBytes 的词库不压缩；
+// 超过 kMaxTrainingBytes 时等间隔抽样（训练耗时随样本量增长）
+const int kMinTrainingBytes = 32 * 1024;
+const int kMaxTrainingBytes = 4 * 1024 * 1024;
+
+// 按 NOCASE 规则折叠：只把 ASCII 大写字母转为小写
+QString foldNoCase(const QString& text) {
+    QString folded = text;
+    for (QChar& ch : folded) {
+        if (ch >= QLatin1Char('A') && ch <= QLatin1Char('Z')) {
+            ch = QChar(ch.unicode() + ('a' - 'A'));
+        }
+    }
+    return folded;
+}
+
+// 前缀查询（COLLATE NOCASE）的上界：折叠后最后一个码位加一（"App" -> "apq"）。
+// 必须先折叠，否则 "Z" 的上界 "[" 在 NOCASE 下小于 "z"，范围为空；
+// '@' 加一得到的 'A' 会被折叠成 'a'，跳过大写区间取 '['
+QString prefixUpperBound(const QString& prefix) {
+    QVector<uint> codePoints = foldNoCase(prefix).toUcs4();
+    uint& last = codePoints.last();
+    ++last;
+    if (last >= 'A' && last <= 'Z') {
+        last = '[';
+    }
+    return QString::fromUcs4(codePoints.constData(), codePoints.size());
+}
+
+} // namespace
+
 WordRepository::WordRepository(SQLiteAdapter& adapter)
     : adapter_(adapter)
+    , searchIndexState_(-1)
+    , searchBackfillDone_(false)
+    , structuredBackfillDone_(false)
+    , bulkLoading_(false)
+    , profileSwitched_(false)
 {
 }
 
@@ -15,84 +432,249 @@ bool WordRepository::save(const Domain::Word& word) {
         return false;
     }
     
+    return saveBatch(QList<Domain::Word>() << word);
+}
+
+Domain::Word WordRepository::getById(int id, Domain::WordProjection projection) {
+    QString sql = selectWordsSql(projection) + " WHERE w.id = ?";
+    
+    QList<Domain::Word> words = queryWords(sql, QVariantList() << id, projection);
+    return words.isEmpty() ? Domain::Word() : words.first();
+}
+
+QList<Domain::Word> WordRepository::getByIds(const QList<int>& ids,
+                                             Domain::WordProjection projection) {
+    if (ids.isEmpty()) {
+        return QList<Domain::Word>();
+    }
+    
+    // 固定长度的 IN 子句：每个投影只有一条缓存语句，参数数不超过上限
+    static const QString summarySql = selectWordsSql(Domain::WordProjection::Summary)
+                                    + idListClause(kIdChunkSize);
+    static const QString fullSql = selectWordsSql(Domain::WordProjection::Full)
+                                 + idListClause(kIdChunkSize);
+    const QString& sql = projection == Domain::WordProjection::Summary ? summarySql : fullSql;
+    
+    // 去重，保留首次出现的顺序
+    QList<int> uniqueIds;
+    uniqueIds.reserve(ids.size());
+    QSet<int> seen;
+    seen.reserve(ids.size());
+    for (int id : ids) {
+        if (!seen.contains(id)) {
+            seen.insert(id);
+            uniqueIds.append(id);
+        }
+    }
+    
+    QHash<int, Domain::Word> found;
+    found.reserve(uniqueIds.size());
+    for (int begin = 0; begin < uniqueIds.size(); begin += kIdChunkSize) {
+        QVariantList params;
+        params.reserve(kIdChunkSize);
+        for (int i = begin; i < begin + kIdChunkSize; ++i) {
+            params << (i < uniqueIds.size() ? uniqueIds[i] : kPaddingId);
+        }
+        
+        for (const Domain::Word& word : queryWords(sql, params, projection)) {
+            found.insert(word.id, word);
+        }
+    }
+    
+    // 按参数顺序返回
+    QList<Domain::Word> words;
+    words.reserve(found.size());
+    for (int id : uniqueIds) {
+        auto it = found.constFind(id);
+        if (it != found.constEnd()) {
+            words.append(it.value());
+        }
+    }
+    return words;
+}
+
+bool WordRepository::update(const Domain::Word& word) {
+    if (!word.isValid() || word.id <= 0) {
+        qWarning() << "Invalid word object";
+        return false;
+    }
+    
+    SQLiteAdapter::Transaction tx(adapter_);
+    if (!tx.isActive()) {
+        return false;
+    }
+    
     QString sql = R"(
-        INSERT OR REPLACE INTO words 
-        (book_id, word_id, word, phonetic_uk, phonetic_us, 
-         translations, sentences, phrases, synonyms, 
-         related_words, etymology)
-        VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)
+        UPDATE words
+        SET word = ?, phonetic_uk = ?, phonetic_us = ?, gloss = ?, content_hash = ?
+        WHERE id = ?
     )";
     
     auto query = adapter_.prepare(sql);
-    query.addBindValue(word.bookId);
-    query.addBindValue(word.wordId);
     query.addBindValue(word.word);
     query.addBindValue(word.phoneticUk);
     query.addBindValue(word.phoneticUs);
-    query.addBindValue(word.translations);
-    query.addBindValue(word.sentences);
-    query.addBindValue(word.phrases);
-    query.addBindValue(word.synonyms);
-    query.addBindValue(word.relatedWords);
-    query.addBindValue(word.etymology);
+    query.addBindValue(glossOf(word));
+    query.addBindValue(word.contentHash());
+    query.addBindValue(word.id);
+    
+    if (!adapter_.exec(query)) {
+        qWarning() << "Failed to update word:" << query.lastError().text();
+        return false;
+    }
+    if (query.numRowsAffected() <= 0) {
+        return false;
+    }
     
-    if (!query.exec()) {
-        qWarning() << "Failed to save word:" << query.lastError().text();
+    QString detailSql = QString("INSERT OR REPLACE INTO word_details (%1) "
+                                "VALUES (?, ?, ?, ?, ?, ?, ?)").arg(kDetailInsertColumns);
+    
+    auto details = adapter_.prepare(detailSql);
+    details.addBindValue(word.id);
+    bindDetailFields(details, word);
+    
+    if (!adapter_.exec(details)) {
+        qWarning() << "Failed to update word details:" << details.lastError().text();
         return false;
     }
     
-    return true;
+    // 子表行整体替换：条目数可能变少，先删旧行
+    for (const ChildTable* table : {&kTranslationTable, &kSentenceTable, &kPhraseTable}) {
+        auto clear = adapter_.prepare(
+            QString("DELETE FROM %1 WHERE word_id = ?").arg(table->name));
+        clear.addBindValue(word.id);
+        if (!adapter_.exec(clear)) {
+            qWarning() << "Failed to update word fields:" << clear.lastError().text();
+            return false;
+        }
+    }
+    
+    ChildRows childRows;
+    childRows.append(word, QVariantList() << word.id);
+    if (insertChildRows(adapter_, kWordIdParam, 1, childRows, hasSearchIndex()) < 0) {
+        return false;
+    }
+    
+    return tx.commit();
 }
 
-Domain::Word WordRepository::getById(int id) {
-    QString sql = "SELECT * FROM words WHERE id = ?";
+bool WordRepository::loadDetails(Domain::Word& word) {
+    if (word.id <= 0) {
+        return false;
+    }
+    
+    QString sql = QString("SELECT %1 FROM word_details d WHERE d.word_id = ?")
+                      .arg(kDetailColumns);
     
     auto query = adapter_.prepare(sql);
-    query.addBindValue(id);
+    query.addBindValue(word.id);
     
-    if (!query.exec()) {
-        qWarning() << "Failed to query word:" << query.lastError().text();
-        return Domain::Word();
+    if (!adapter_.exec(query)) {
+        qWarning() << "Failed to load word details:" << query.lastError().text();
+        return false;
     }
-    
-    if (query.next()) {
-        return buildWordFromQuery(query);
+    if (!query.next()) {
+        return false;
     }
     
-    return Domain::Word();
+    word.translations = detailText(query.value(0));
+    word.sentences = detailText(query.value(1));
+    word.phrases = detailText(query.value(2));
+    word.synonyms = detailText(query.value(3));
+    word.relatedWords = detailText(query.value(4));
+    word.etymology = detailText(query.value(5));
+    query.finish();
+    return true;
 }
 
-QList<Domain::Word> WordRepository::getByIds(const QList<int>& ids) {
-    QList<Domain::Word> words;
+QList<Domain::WordTranslation> WordRepository::getTranslations(int wordId) {
+    QList<Domain::WordTranslation> items;
     
-    if (ids.isEmpty()) {
-        return words;
+    auto query = adapter_.prepare(
+        "SELECT pos, meaning FROM word_translations WHERE word_id = ? ORDER BY position");
+    query.addBindValue(wordId);
+    
+    if (!adapter_.exec(query)) {
+        qWarning() << "Failed to query word translations:" << query.lastError().text();
+        return items;
+    }
+    while (query.next()) {
+        Domain::WordTranslation item;
+        item.pos = query.value(0).toString();
+        item.meaning = query.value(1).toString();
+        items.append(item);
     }
+    adapter_.recordRowsReturned(query, items.size());
     
-    // 构建 IN 子句
-    QStringList placeholders;
-    for (int i = 0; i < ids.size(); ++i) {
-        placeholders.append("?");
+    if (items.isEmpty() && !structuredBackfillDone_) {
+        items = Domain::WordTranslation::listFromJson(pendingDetailJson(wordId, "translations"));
     }
+    return items;
+}
+
+QList<Domain::WordSentence> WordRepository::getSentences(int wordId) {
+    QList<Domain::WordSentence> items;
     
-    QString sql = QString("SELECT * FROM words WHERE id IN (%1)")
-                      .arg(placeholders.join(","));
+    auto query = adapter_.prepare(
+        "SELECT english, chinese FROM word_sentences WHERE word_id = ? ORDER BY position");
+    query.addBindValue(wordId);
     
-    auto query = adapter_.prepare(sql);
-    for (int id : ids) {
-        query.addBindValue(id);
+    if (!adapter_.exec(query)) {
+        qWarning() << "Failed to query word sentences:" << query.lastError().text();
+        return items;
+    }
+    while (query.next()) {
+        Domain::WordSentence item;
+        item.english = query.value(0).toString();
+        item.chinese = query.value(1).toString();
+        items.append(item);
     }
+    adapter_.recordRowsReturned(query, items.size());
     
-    if (!query.exec()) {
-        qWarning() << "Failed to query words by ids:" << query.lastError().text();
-        return words;
+    if (items.isEmpty() && !structuredBackfillDone_) {
+        items = Domain::WordSentence::listFromJson(pendingDetailJson(wordId, "sentences"));
     }
+    return items;
+}
+
+QList<Domain::WordPhrase> WordRepository::getPhrases(int wordId) {
+    QList<Domain::WordPhrase> items;
     
+    auto query = adapter_.prepare(
+        "SELECT phrase, meaning FROM word_phrases WHERE word_id = ? ORDER BY position");
+    query.addBindValue(wordId);
+    
+    if (!adapter_.exec(query)) {
+        qWarning() << "Failed to query word phrases:" << query.lastError().text();
+        return items;
+    }
     while (query.next()) {
-        words.append(buildWordFromQuery(query));
+        Domain::WordPhrase item;
+        item.phrase = query.value(0).toString();
+        item.meaning = query.value(1).toString();
+        items.append(item);
     }
+    adapter_.recordRowsReturned(query, items.size());
     
-    return words;
+    if (items.isEmpty() && !structuredBackfillDone_) {
+        items = Domain::WordPhrase::listFromJson(pendingDetailJson(wordId, "phrases"));
+    }
+    return items;
+}
+
+QString WordRepository::pendingDetailJson(int wordId, const char* column) {
+    auto query = adapter_.prepare(
+        QString("SELECT d.%1 FROM structured_backfill b "
+                "JOIN word_details d ON d.word_id = b.word_id WHERE b.word_id = ?").arg(column));
+    query.addBindValue(wordId);
+    
+    if (!adapter_.exec(query) || !query.next()) {
+        return QString();
+    }
+    
+    QVariant value = query.value(0);
+    query.finish();
+    return detailText(value);
 }
 
 bool WordRepository::remove(int id) {
@@ -101,7 +683,7 @@ bool WordRepository::remove(int id) {
     auto query = adapter_.prepare(sql);
     query.addBindValue(id);
     
-    if (!query.exec()) {
+    if (!adapter_.exec(query)) {
         qWarning() << "Failed to delete word:" << query.lastError().text();
         return false;
     }
@@ -115,7 +697,7 @@ bool WordRepository::exists(int id) {
     auto query = adapter_.prepare(sql);
     query.addBindValue(id);
     
-    if (query.exec() && query.next()) {
+    if (adapter_.exec(query) && query.next()) {
         return query.value("cnt").toInt() > 0;
     }
     
@@ -124,68 +706,433 @@ bool WordRepository::exists(int id) {
 
 QList<Domain::Word> WordRepository::getByBookId(const QString& bookId, 
                                                  int limit, 
-                                                 int offset) {
-    QList<Domain::Word> words;
-    
-    QString sql = "SELECT * FROM words WHERE book_id = ? ORDER BY word_id";
+                                                 int offset,
+                                                 Domain::WordProjection projection) {
+    QString sql = selectWordsSql(projection) + " WHERE w.book_id = ? ORDER BY w.word_id";
     
     if (limit > 0) {
         sql += QString(" LIMIT %1 OFFSET %2").arg(limit).arg(offset);
     }
     
+    return queryWords(sql, QVariantList() << bookId, projection);
+}
+
+QList<Domain::Word> WordRepository::searchByWord(const QString& word,
+                                                 Domain::WordProjection projection) {
+    if (word.isEmpty()) {
+        return QList<Domain::Word>();
+    }
+    
+    // 前缀匹配写成范围条件，才能走 idx_words_word_nocase；
+    // LIKE '%x%' 只能全表扫描，LIKE 'x%' 是否走索引又取决于绑定值
+    QString sql = selectWordsSql(projection) + R"(
+        WHERE w.word COLLATE NOCASE >= ? AND w.word COLLATE NOCASE < ?
+        ORDER BY w.word COLLATE NOCASE
+        LIMIT 50
+    )";
+    
+    return queryWords(sql, QVariantList() << word << prefixUpperBound(word), projection);
+}
+
+Domain::Word WordRepository::getByBookAndWord(const QString& bookId, 
+                                               const QString& word) {
+    const Domain::WordProjection projection = Domain::WordProjection::Full;
+    QString sql = selectWordsSql(projection) + " WHERE w.book_id = ? AND w.word = ?";
+    
+    QList<Domain::Word> words = queryWords(sql, QVariantList() << bookId << word, projection);
+    return words.isEmpty() ? Domain::Word() : words.first();
+}
+
+QList<Domain::WordFingerprint> WordRepository::getFingerprints(const QString& bookId) {
+    QList<Domain::WordFingerprint> fingerprints;
+    
+    QString sql = "SELECT id, word_id, content_hash FROM words WHERE book_id = ?";
+    
     auto query = adapter_.prepare(sql);
     query.addBindValue(bookId);
     
-    if (!query.exec()) {
-        qWarning() << "Failed to query words by book:" << query.lastError().text();
-        return words;
+    if (!adapter_.exec(query)) {
+        qWarning() << "Failed to query word fingerprints:" << query.lastError().text();
+        return fingerprints;
     }
     
     while (query.next()) {
-        words.append(buildWordFromQuery(query));
+        Domain::WordFingerprint fingerprint;
+        fingerprint.id = query.value(0).toInt();
+        fingerprint.wordId = query.value(1).toInt();
+        fingerprint.contentHash = query.value(2).toByteArray();
+        fingerprints.append(fingerprint);
     }
+    adapter_.recordRowsReturned(query, fingerprints.size());
     
-    return words;
+    return fingerprints;
 }
 
-QList<Domain::Word> WordRepository::searchByWord(const QString& word) {
-    QList<Domain::Word> words;
+QList<int> WordRepository::getWordIdsByPos(const QString& bookId, const QStringList& posList) {
+    QList<int> ids;
+    if (posList.isEmpty()) {
+        return ids;
+    }
     
-    QString sql = "SELECT * FROM words WHERE word LIKE ? ORDER BY word LIMIT 50";
+    // 走 idx_word_translations_book_pos，只读索引
+    QStringList placeholders;
+    QVariantList params;
+    params << bookId;
+    for (const QString& pos : posList) {
+        placeholders << "?";
+        params << pos;
+    }
+    
+    QString sql = QString("SELECT DISTINCT word_id FROM word_translations "
+                          "WHERE book_id = ? AND pos IN (%1) ORDER BY word_id")
+                      .arg(placeholders.join(", "));
     
     auto query = adapter_.prepare(sql);
-    query.addBindValue(QString("%%1%").arg(word));
+    for (const QVariant& param : params) {
+        query.addBindValue(param);
+    }
+    
+    if (!adapter_.exec(query)) {
+        qWarning() << "Failed to query words by part of speech:" << query.lastError().text();
+        return ids;
+    }
+    
+    while (query.next()) {
+        ids.append(query.value(0).toInt());
+    }
+    adapter_.recordRowsReturned(query, ids.size());
+    return ids;
+}
+
+QList<Domain::WordSearchHit> WordRepository::search(const QString& text, const QString& bookId,
+                                                     int limit) {
+    QList<Domain::WordSearchHit> hits;
+    if (text.trimmed().isEmpty() || limit <= 0) {
+        return hits;
+    }
+    if (!isSearchIndexReady()) {
+        return searchWithoutIndex(text.trimmed(), bookId, limit);
+    }
+    
+    QString match = ftsQuery(text);
+    if (match.isEmpty()) {
+        return hits;
+    }
+    
+    // 由 MATCH 驱动：先在索引中按相关度排序，再按 rowid 回表取 Summary 列
+    QString sql = QString(
+        "SELECT %1, snippet(word_search, -1, char(2), char(3), '...', 16), "
+        "bm25(word_search, %2) AS score "
+        "FROM word_search JOIN words w ON w.id = word_search.rowid "
+        "WHERE word_search MATCH ?%3 ORDER BY score LIMIT ?")
+        .arg(kSummaryColumns, kSearchWeights,
+             bookId.isEmpty() ? QString() : QString(" AND w.book_id = ?"));
+    
+    auto query = adapter_.prepare(sql);
+    query.addBindValue(match);
+    if (!bookId.isEmpty()) {
+        query.addBindValue(bookId);
+    }
+    query.addBindValue(limit);
     
-    if (!query.exec()) {
+    if (!adapter_.exec(query)) {
         qWarning() << "Failed to search words:" << query.lastError().text();
-        return words;
+        return hits;
     }
     
     while (query.next()) {
-        words.append(buildWordFromQuery(query));
+        Domain::WordSearchHit hit;
+        hit.word = buildWordFromQuery(query, Domain::WordProjection::Summary);
+        hit.snippet = query.value(kSummaryColumnCount).toString().remove(kCjkSeparator);
+        hit.score = query.value(kSummaryColumnCount + 1).toDouble();
+        hits.append(hit);
     }
+    adapter_.recordRowsReturned(query, hits.size());
+    return hits;
+}
+
+QList<Domain::WordSearchHit> WordRepository::searchWithoutIndex(const QString& text,
+                                                                const QString& bookId,
+                                                                int limit) {
+    QString escaped = text;
+    escaped.replace("\\", "\\\\").replace("%", "\\%").replace("_", "\\_");
+    const QString pattern = "%" + escaped + "%";
     
-    return words;
+    QString sql = selectWordsSql(Domain::WordProjection::Summary)
+        + " WHERE (w.word LIKE ? ESCAPE '\\' OR w.gloss LIKE ? ESCAPE '\\')";
+    QVariantList params;
+    params << pattern << pattern;
+    if (!bookId.isEmpty()) {
+        sql += " AND w.book_id = ?";
+        params << bookId;
+    }
+    sql += " ORDER BY LENGTH(w.word), w.word LIMIT ?";
+    params << limit;
+    
+    QList<Domain::WordSearchHit> hits;
+    for (const Domain::Word& word : queryWords(sql, params, Domain::WordProjection::Summary)) {
+        Domain::WordSearchHit hit;
+        hit.word = word;
+        hit.snippet = markFirst(word.word, text);
+        if (hit.snippet.isEmpty()) {
+            hit.snippet = markFirst(word.gloss, text);
+        }
+        hits.append(hit);
+    }
+    return hits;
 }
 
-Domain::Word WordRepository::getByBookAndWord(const QString& bookId, 
-                                               const QString& word) {
-    QString sql = "SELECT * FROM words WHERE book_id = ? AND word = ?";
+bool WordRepository::hasSearchIndex() {
+    if (searchIndexState_ < 0) {
+        QSqlQuery query = adapter_.query(
+            "SELECT COUNT(*) FROM sqlite_master WHERE type = 'table' AND name = 'word_search'");
+        searchIndexState_ = query.next() && query.value(0).toInt() > 0 ? 1 : 0;
+        query.finish();
+    }
+    return searchIndexState_ > 0;
+}
+
+bool WordRepository::isSearchIndexReady() {
+    return hasSearchIndex() && searchBackfillRemaining() == 0;
+}
+
+int WordRepository::searchBackfillRemaining() {
+    if (!hasSearchIndex() || searchBackfillDone_) {
+        return 0;
+    }
     
-    auto query = adapter_.prepare(sql);
-    query.addBindValue(bookId);
-    query.addBindValue(word);
+    auto query = adapter_.prepare(
+        "SELECT COUNT(*) FROM search_backfill b, words w "
+        "WHERE w.id >= b.next_id AND w.id < b.end_id");
+    if (!adapter_.exec(query) || !query.next()) {
+        qWarning() << "Failed to read search backfill state:" << query.lastError().text();
+        return 0;
+    }
+    int remaining = query.value(0).toInt();
+    query.finish();
+    // 补建范围只由迁移写入，清空后不会再出现
+    searchBackfillDone_ = remaining == 0;
+    return remaining;
+}
+
+int WordRepository::backfillSearchIndex(int maxWords) {
+    if (!hasSearchIndex() || searchBackfillDone_) {
+        return 0;
+    }
+    maxWords = qMax(1, maxWords);
+    
+    SQLiteAdapter::Transaction tx(adapter_);
+    if (!tx.isActive()) {
+        return -1;
+    }
+    
+    auto range = adapter_.prepare("SELECT next_id, end_id FROM search_backfill");
+    if (!adapter_.exec(range)) {
+        qWarning() << "Failed to read search backfill state:" << range.lastError().text();
+        return -1;
+    }
+    if (!range.next()) {
+        range.finish();
+        if (!tx.commit()) {
+            return -1;
+        }
+        searchBackfillDone_ = true;
+        return 0;
+    }
+    const int nextId = range.value(0).toInt();
+    const int endId = range.value(1).toInt();
+    range.finish();
+    
+    int lastId = 0;
+    int indexed = indexWords(nextId, endId, maxWords, lastId);
+    if (indexed < 0) {
+        return -1;
+    }
+    
+    const bool finished = indexed < maxWords;
+    auto advance = adapter_.prepare(finished ? QString("DELETE FROM search_backfill")
+                                             : QString("UPDATE search_backfill SET next_id = ?"));
+    if (!finished) {
+        advance.addBindValue(lastId + 1);
+    }
+    if (!adapter_.exec(advance) || (finished && !optimizeSearchIndex())) {
+        qWarning() << "Failed to advance search backfill:" << advance.lastError().text();
+        return -1;
+    }
+    if (!tx.commit()) {
+        return -1;
+    }
+    
+    if (finished) {
+        searchBackfillDone_ = true;
+        qDebug() << "Search index backfill finished";
+        return 0;
+    }
+    return searchBackfillRemaining();
+}
+
+int WordRepository::structuredBackfillRemaining() {
+    if (structuredBackfillDone_) {
+        return 0;
+    }
+    
+    QSqlQuery query = adapter_.query("SELECT COUNT(*) FROM structured_backfill");
+    if (!query.next()) {
+        qWarning() << "Failed to read structured field backfill state:"
+                   << query.lastError().text();
+        return 0;
+    }
+    int remaining = query.value(0).toInt();
+    query.finish();
+    structuredBackfillDone_ = remaining == 0;
+    return remaining;
+}
+
+int WordRepository::backfillStructuredFields(int maxWords) {
+    if (structuredBackfillDone_) {
+        return 0;
+    }
+    maxWords = qMax(1, maxWords);
+    
+    SQLiteAdapter::Transaction tx(adapter_);
+    if (!tx.isActive()) {
+        return -1;
+    }
+    
+    // 列表中的单词可能已被删除或替换（LEFT JOIN 后跳过），同样从列表中删除
+    auto query = adapter_.prepare(
+        "SELECT b.word_id, w.book_id, w.word, d.translations, d.sentences, d.phrases "
+        "FROM structured_backfill b "
+        "LEFT JOIN words w ON w.id = b.word_id "
+        "LEFT JOIN word_details d ON d.word_id = b.word_id "
+        "ORDER BY b.word_id LIMIT ?");
+    query.addBindValue(maxWords);
+    if (!adapter_.exec(query)) {
+        qWarning() << "Failed to read structured field backfill:" << query.lastError().text();
+        return -1;
+    }
+    
+    ChildRows rows;
+    int lastId = 0;
+    int read = 0;
+    while (query.next()) {
+        lastId = query.value(0).toInt();
+        ++read;
+        if (query.value(1).isNull()) {
+            continue;
+        }
+        Domain::Word word;
+        word.id = lastId;
+        word.bookId = query.value(1).toString();
+        word.word = query.value(2).toString();
+        word.translations = detailText(query.value(3));
+        word.sentences = detailText(query.value(4));
+        word.phrases = detailText(query.value(5));
+        rows.append(word, QVariantList() << word.id);
+    }
+    adapter_.recordRowsReturned(query, read);
+    query.finish();
+    if (read == 0) {
+        structuredBackfillDone_ = true;
+        return 0;
+    }
+    
+    auto done = adapter_.prepare("DELETE FROM structured_backfill WHERE word_id <= ?");
+    done.addBindValue(lastId);
+    if (insertChildRows(adapter_, kWordIdParam, 1, rows, false) < 0 || !adapter_.exec(done)) {
+        qWarning() << "Failed to backfill structured fields:" << done.lastError().text();
+        return -1;
+    }
+    if (!tx.commit()) {
+        return -1;
+    }
+    
+    if (read < maxWords) {
+        structuredBackfillDone_ = true;
+        qDebug() << "Structured field backfill finished";
+        return 0;
+    }
+    return structuredBackfillRemaining();
+}
+
+bool WordRepository::rebuildSearchIndex() {
+    if (!hasSearchIndex()) {
+        return false;
+    }
+    
+    QElapsedTimer timer;
+    timer.start();
+    
+    SQLiteAdapter::Transaction tx(adapter_);
+    if (!tx.isActive()) {
+        return false;
+    }
+    
+    if (!adapter_.execute("DELETE FROM word_search")
+        || !adapter_.execute("DELETE FROM search_backfill")) {
+        qWarning() << "Failed to clear word search index";
+        return false;
+    }
+    
+    int total = 0;
+    int lastId = 0;
+    int indexed = kSearchRebuildBatch;
+    while (indexed == kSearchRebuildBatch) {
+        indexed = indexWords(lastId + 1, std::numeric_limits<int>::max(),
+                             kSearchRebuildBatch, lastId);
+        if (indexed < 0) {
+            qWarning() << "Failed to rebuild word search index";
+            return false;
+        }
+        total += indexed;
+    }
+    if (!optimizeSearchIndex() || !tx.commit()) {
+        return false;
+    }
+    
+    searchBackfillDone_ = true;
+    qDebug() << "Indexed" << total << "words for search in" << timer.elapsed() << "ms";
+    return true;
+}
+
+int WordRepository::indexWords(int fromId, int endId, int limit, int& lastId) {
+    static const QString sql = selectWordsSql(Domain::WordProjection::Full)
+        + " WHERE w.id >= ? AND w.id < ? ORDER BY w.id LIMIT ?";
     
-    if (!query.exec()) {
-        qWarning() << "Failed to query word:" << query.lastError().text();
-        return Domain::Word();
+    QList<Domain::Word> words = queryWords(sql, QVariantList() << fromId << endId << limit,
+                                           Domain::WordProjection::Full);
+    if (words.isEmpty()) {
+        return 0;
     }
     
-    if (query.next()) {
-        return buildWordFromQuery(query);
+    ChildRows rows;
+    for (const Domain::Word& word : words) {
+        rows.append(word, QVariantList() << word.id);
+    }
+    if (insertChildRows(adapter_, kSearchTable, kWordIdParam, 1, rows.search) < 0) {
+        return -1;
     }
     
-    return Domain::Word();
+    lastId = words.last().id;
+    return words.size();
+}
+
+bool WordRepository::optimizeSearchIndex() {
+    return adapter_.execute("INSERT INTO word_search(word_search) VALUES('optimize')");
+}
+
+bool WordRepository::removeReplacedSearchRows(const QList<Domain::Word>& words) {
+    static const QString bulkSql = deleteReplacedSearchSql(kReplacedSearchRows, true);
+    static const QString singleSql = deleteReplacedSearchSql(1, true);
+    static const QString bulkLoadBulkSql = deleteReplacedSearchSql(kReplacedSearchRows, false);
+    static const QString bulkLoadSingleSql = deleteReplacedSearchSql(1, false);
+    
+    if (bulkLoading_) {
+        return insertGrouped(adapter_, words, kReplacedSearchRows, bulkLoadBulkSql,
+                             bulkLoadSingleSql, bindWordIdKey) >= 0;
+    }
+    return insertGrouped(adapter_, words, kReplacedSearchRows, bulkSql, singleSql,
+                         bindWordKey) >= 0;
 }
 
 bool WordRepository::saveBatch(const QList<Domain::Word>& words) {
@@ -193,18 +1140,86 @@ bool WordRepository::saveBatch(const QList<Domain::Word>& words) {
         return true;
     }
     
-    if (!beginTransaction()) {
+    // 先校验，避免写了一半再回滚
+    for (const Domain::Word& word : words) {
+        if (!word.isValid()) {
+            qWarning() << "Invalid word object in batch";
+            return false;
+        }
+    }
+    
+    QElapsedTimer timer;
+    timer.start();
+    
+    // 在外层事务中调用时嵌套为保存点，失败只回滚本批
+    SQLiteAdapter::Transaction tx(adapter_);
+    if (!tx.isActive()) {
         return false;
     }
     
-    for (const Domain::Word& word : words) {
-        if (!save(word)) {
-            rollback();
-            return false;
+    // 整组用一条多行 INSERT（同一条缓存语句），不足一组的余数逐行插入；
+    // 先写 words，word_details 再按 (book_id, word_id) 关联刚写入的行
+    static const QString bulkSql = insertWordsSql(kBulkInsertRows);
+    static const QString singleSql = insertWordsSql(1);
+    static const QString bulkDetailSql = insertDetailsSql(kBulkDetailRows);
+    static const QString singleDetailSql = insertDetailsSql(1);
+    const int count = words.size();
+    
+    // 替换已有单词时 id 会变，旧 id 的索引行需在插入前删除
+    if (hasSearchIndex() && !removeReplacedSearchRows(words)) {
+        return false;
+    }
+    
+    int wordStatements = insertGrouped(adapter_, words, kBulkInsertRows,
+                                       bulkSql, singleSql, bindWord);
+    if (wordStatements < 0) {
+        return false;
+    }
+    int detailStatements = insertGrouped(adapter_, words, kBulkDetailRows,
+                                         bulkDetailSql, singleDetailSql, bindDetails);
+    if (detailStatements < 0) {
+        return false;
+    }
+    
+    // 同一批内重复的 (book_id, word_id) 只写最后一个的子表行，与 INSERT OR REPLACE 一致；
+    // 之前批次写入的旧行已随 words 行被替换而级联删除
+    ChildRows childRows;
+    QSet<QPair<QString, int>> seen;
+    for (int i = count - 1; i >= 0; --i) {
+        const Domain::Word& word = words[i];
+        if (!seen.contains(qMakePair(word.bookId, word.wordId))) {
+            seen.insert(qMakePair(word.bookId, word.wordId));
+            childRows.append(word, QVariantList() << word.bookId << word.wordId);
         }
     }
+    int childStatements = insertChildRows(adapter_, kWordIdByKey, 2, childRows,
+                                          hasSearchIndex());
+    if (childStatements < 0) {
+        return false;
+    }
+    int statements = wordStatements + detailStatements + childStatements;
+    
+    if (!tx.commit()) {
+        return false;
+    }
     
-    return commit();
+    if (bulkLoading_) {
+        for (const Domain::Word& word : words) {
+            bulkBookIds_.insert(word.bookId);
+        }
+    }
+    bulkStats_.rows += count;
+    bulkStats_.statements += statements;
+    bulkStats_.elapsedUs += timer.nsecsElapsed() / 1000;
+    return true;
+}
+
+WordRepository::BulkLoadStats WordRepository::bulkLoadStats() const {
+    return bulkStats_;
+}
+
+void WordRepository::resetBulkLoadStats() {
+    bulkStats_ = BulkLoadStats();
 }
 
 bool WordRepository::removeByBookId(const QString& bookId) {
@@ -213,7 +1228,7 @@ bool WordRepository::removeByBookId(const QString& bookId) {
     auto query = adapter_.prepare(sql);
     query.addBindValue(bookId);
     
-    if (!query.exec()) {
+    if (!adapter_.exec(query)) {
         qWarning() << "Failed to delete words by book:" << query.lastError().text();
         return false;
     }
@@ -222,6 +1237,157 @@ bool WordRepository::removeByBookId(const QString& bookId) {
     return true;
 }
 
+bool WordRepository::compressDetails(const QString& bookId) {
+    compressionStats_ = DetailCompressionStats();
+    if (!DetailCodec::isAvailable()) {
+        qWarning() << "Detail compression requires a build with WORDMASTER_ZSTD";
+        return false;
+    }
+    
+    QElapsedTimer timer;
+    timer.start();
+    
+    SQLiteAdapter::Transaction tx(adapter_);
+    if (!tx.isActive()) {
+        return false;
+    }
+    
+    // 找出仍为 TEXT 且足够长的字段；已压缩（BLOB）的字段原样写回
+    struct PendingRow {
+        int wordId;
+        QVariantList values;
+        QVector<QByteArray> texts;  // 待压缩字段的 UTF-8，其余为空
+    };
+    QList<PendingRow> rows;
+    qint64 sampleBytes = 0;
+    
+    auto query = adapter_.prepare(QString(
+        "SELECT d.word_id, %1 FROM word_details d JOIN words w ON w.id = d.word_id "
+        "WHERE w.book_id = ?").arg(kDetailColumns));
+    query.addBindValue(bookId);
+    
+    if (!adapter_.exec(query)) {
+        qWarning() << "Failed to read word details for compression:" << query.lastError().text();
+        return false;
+    }
+    int scanned = 0;
+    while (query.next()) {
+        ++scanned;
+        PendingRow row;
+        row.wordId = query.value(0).toInt();
+        row.texts.resize(kDetailColumnCount);
+        bool pending = false;
+        for (int i = 0; i < kDetailColumnCount; ++i) {
+            QVariant value = query.value(i + 1);
+            if (value.type() == QVariant::String) {
+                QByteArray text = value.toString().toUtf8();
+                if (text.size() >= DetailCodec::kMinCompressBytes) {
+                    sampleBytes += text.size();
+                    row.texts[i] = text;
+                    pending = true;
+                }
+            }
+            row.values << value;
+        }
+        if (pending) {
+            rows.append(row);
+        }
+    }
+    adapter_.recordRowsReturned(query, scanned);
+    query.finish();
+    
+    if (rows.isEmpty()) {
+        return tx.commit();
+    }
+    
+    int dictionaryId = bookDictionary(bookId);
+    if (dictionaryId < 0) {
+        if (sampleBytes < kMinTrainingBytes) {
+            qDebug() << "Book" << bookId << "is too small for detail compression";
+            return tx.commit();
+        }
+        
+        const int stride = static_cast<int>(sampleBytes / kMaxTrainingBytes) + 1;
+        QList<QByteArray> samples;
+        for (int i = 0; i < rows.size(); i += stride) {
+            for (const QByteArray& text : rows[i].texts) {
+                if (!text.isEmpty()) {
+                    samples.append(text);
+                }
+            }
+        }
+        
+        QString error;
+        const int dictionarySize = static_cast<int>(qMin<qint64>(
+            DetailCodec::kDefaultDictionarySize, sampleBytes / 16));
+        QByteArray dictionary = DetailCodec::train(samples, dictionarySize, &error);
+        if (dictionary.isEmpty()) {
+            qWarning() << "Failed to compress details of book" << bookId << ":" << error;
+            return false;
+        }
+        
+        auto insert = adapter_.prepare(
+            "INSERT INTO detail_dictionaries (book_id, dictionary) VALUES (?, ?)");
+        insert.addBindValue(bookId);
+        insert.addBindValue(dictionary);
+        if (!adapter_.exec(insert)) {
+            qWarning() << "Failed to save detail dictionary:" << insert.lastError().text();
+            return false;
+        }
+        
+        dictionaryId = insert.lastInsertId().toInt();
+        if (!codec_.addDictionary(dictionaryId, dictionary)) {
+            return false;
+        }
+        compressionStats_.dictionaryBytes = dictionary.size();
+    }
+    
+    for (PendingRow& row : rows) {
+        for (int i = 0; i < kDetailColumnCount; ++i) {
+            const QByteArray& text = row.texts[i];
+            if (text.isEmpty()) {
+                continue;
+            }
+            
+            QByteArray blob = codec_.compress(text, dictionaryId);
+            compressionStats_.bytesBefore += text.size();
+            if (!blob.isEmpty() && blob.size() < text.size()) {
+                row.values[i] = blob;
+                compressionStats_.bytesAfter += blob.size();
+                ++compressionStats_.fields;
+            } else {
+                compressionStats_.bytesAfter += text.size();
+            }
+        }
+        
+        auto update = adapter_.prepare(
+            "UPDATE word_details SET translations = ?, sentences = ?, phrases = ?, "
+            "synonyms = ?, related_words = ?, etymology = ? WHERE word_id = ?");
+        bindRow(update, row.values);
+        update.addBindValue(row.wordId);
+        
+        if (!adapter_.exec(update)) {
+            qWarning() << "Failed to save compressed word details:" << update.lastError().text();
+            return false;
+        }
+        ++compressionStats_.rows;
+    }
+    
+    if (!tx.commit()) {
+        return false;
+    }
+    
+    compressionStats_.elapsedMs = timer.elapsed();
+    qDebug() << "Compressed" << compressionStats_.fields << "detail fields of book" << bookId
+             << "from" << compressionStats_.bytesBefore << "to" << compressionStats_.bytesAfter
+             << "bytes in" << compressionStats_.elapsedMs << "ms";
+    return true;
+}
+
+WordRepository::DetailCompressionStats WordRepository::compressionStats() const {
+    return compressionStats_;
+}
+
 bool WordRepository::beginTransaction() {
     return adapter_.beginTransaction();
 }
@@ -234,25 +1400,289 @@ bool WordRepository::rollback() {
     return adapter_.rollback();
 }
 
-Domain::Word WordRepository::buildWordFromQuery(QSqlQuery& query) {
+bool WordRepository::beginBulkLoad() {
+    if (bulkLoading_) {
+        qWarning() << "Bulk load already in progress";
+        return false;
+    }
+    
+    StorageProfile bulk = StorageProfile::bulkImport();
+    savedProfile_ = adapter_.storageProfile();
+    profileSwitched_ = false;
+    if (adapter_.transactionDepth() == 0 && savedProfile_.name != bulk.name) {
+        profileSwitched_ = true;
+        if (!adapter_.setStorageProfile(bulk)) {
+            finishBulkLoad();
+            return false;
+        }
+    }
+    
+    if (!adapter_.beginTransaction()) {
+        finishBulkLoad();
+        return false;
+    }
+    
+    // 未读完的缓存语句会锁住表，DROP INDEX 前先复位
+    adapter_.resetStatements();
+    
+    QSqlQuery indexes = adapter_.query(
+        "SELECT name, sql FROM sqlite_master "
+        "WHERE type = 'index' AND tbl_name = 'words' AND sql IS NOT NULL");
+    while (indexes.next()) {
+        DeferredIndex index;
+        index.name = indexes.value(0).toString();
+        index.sql = indexes.value(1).toString();
+        deferredIndexes_.append(index);
+    }
+    indexes.finish();
+    
+    // DDL 在事务内：回滚时索引随之恢复
+    for (const DeferredIndex& index : deferredIndexes_) {
+        if (!adapter_.execute(QString("DROP INDEX %1").arg(index.name))) {
+            qWarning() << "Failed to drop index for bulk load:" << index.name;
+            adapter_.rollback();
+            finishBulkLoad();
+            return false;
+        }
+    }
+    
+    bulkLoading_ = true;
+    qDebug() << "Bulk load started, deferred" << deferredIndexes_.size() << "word indexes";
+    return true;
+}
+
+bool WordRepository::commitBulkLoad() {
+    if (!bulkLoading_) {
+        qWarning() << "commitBulkLoad() called without an active bulk load";
+        return false;
+    }
+    
+    QElapsedTimer timer;
+    timer.start();
+    
+    bool ok = true;
+    for (const DeferredIndex& index : deferredIndexes_) {
+        if (index.name == kUniqueWordIndex && !bulkBookIds_.isEmpty()) {
+            // 一次排序完成唯一性检查，保留最后写入的行（id 最大）；
+            // 只有本次写入的词库可能重复，其余词库的行仍受索引约束
+            QStringList placeholders;
+            QVariantList bookIds;
+            for (const QString& bookId : bulkBookIds_) {
+                placeholders << "?";
+                bookIds << bookId;
+            }
+            const QString inBooks = placeholders.join(", ");
+            auto dedup = adapter_.prepare(
+                QString("DELETE FROM words WHERE book_id IN (%1) AND id NOT IN "
+                        "(SELECT MAX(id) FROM words WHERE book_id IN (%1) GROUP BY book_id, word)")
+                    .arg(inBooks));
+            for (const QVariant& bookId : bookIds + bookIds) {
+                dedup.addBindValue(bookId);
+            }
+            ok = adapter_.exec(dedup);
+            if (!ok) {
+                qWarning() << "Failed to remove duplicate words:" << dedup.lastError().text();
+            }
+            break;
+        }
+    }
+    
+    for (int i = 0; ok && i < deferredIndexes_.size(); ++i) {
+        ok = adapter_.execute(deferredIndexes_[i].sql);
+    }
+    
+    if (ok) {
+        ok = adapter_.commit();
+    }
+    
+    if (!ok) {
+        qWarning() << "Failed to rebuild word indexes, rolling back bulk load";
+        adapter_.rollback();
+    } else {
+        qDebug() << "Rebuilt" << deferredIndexes_.size() << "word indexes in"
+                 << timer.elapsed() << "ms";
+    }
+    
+    finishBulkLoad();
+    return ok;
+}
+
+bool WordRepository::rollbackBulkLoad() {
+    if (!bulkLoading_) {
+        qWarning() << "rollbackBulkLoad() called without an active bulk load";
+        return false;
+    }
+    
+    bool ok = adapter_.rollback();
+    finishBulkLoad();
+    return ok;
+}
+
+bool WordRepository::isBulkLoading() const {
+    return bulkLoading_;
+}
+
+void WordRepository::finishBulkLoad() {
+    if (profileSwitched_) {
+        adapter_.setStorageProfile(savedProfile_);
+    }
+    
+    bulkLoading_ = false;
+    profileSwitched_ = false;
+    deferredIndexes_.clear();
+    bulkBookIds_.clear();
+}
+
+QString WordRepository::detailText(const QVariant& value) {
+    if (value.type() == QVariant::ByteArray) {
+        return decodeDetail(value.toByteArray());
+    }
+    return value.toString();
+}
+
+QString WordRepository::decodeDetail(const QByteArray& blob) {
+    const int dictionaryId = DetailCodec::dictionaryIdOf(blob);
+    if (!codec_.hasDictionary(dictionaryId)) {
+        loadDictionary(dictionaryId);
+    }
+    
+    QByteArray text;
+    if (!codec_.decompress(blob, &text)) {
+        qWarning() << "Failed to decompress word details with dictionary" << dictionaryId;
+        return QString();
+    }
+    return QString::fromUtf8(text);
+}
+
+bool WordRepository::loadDictionary(int dictionaryId) {
+    auto query = adapter_.prepare("SELECT dictionary FROM detail_dictionaries WHERE id = ?");
+    query.addBindValue(dictionaryId);
+    
+    if (!adapter_.exec(query) || !query.next()) {
+        qWarning() << "Detail dictionary not found:" << dictionaryId;
+        return false;
+    }
+    
+    QByteArray dictionary = query.value(0).toByteArray();
+    query.finish();
+    return codec_.addDictionary(dictionaryId, dictionary);
+}
+
+int WordRepository::bookDictionary(const QString& bookId) {
+    auto query = adapter_.prepare(
+        "SELECT id, dictionary FROM detail_dictionaries WHERE book_id = ? "
+        "ORDER BY id DESC LIMIT 1");
+    query.addBindValue(bookId);
+    
+    if (!adapter_.exec(query) || !query.next()) {
+        return -1;
+    }
+    
+    const int dictionaryId = query.value(0).toInt();
+    QByteArray dictionary = query.value(1).toByteArray();
+    query.finish();
+    return codec_.addDictionary(dictionaryId, dictionary) ? dictionaryId : -1;
+}
+
+QList<Domain::Word> WordRepository::queryWords(const QString& sql,
+                                               const QVariantList& params,
+                                               Domain::WordProjection projection) {
+    QList<Domain::Word> words;
+    
+#ifdef WORDMASTER_NATIVE_SQLITE
+    NativeStatement statement = adapter_.prepareNative(sql);
+    if (statement.isValid()) {
+        if (!statement.bindValues(params)) {
+            qWarning() << "Failed to bind word query:" << statement.lastError();
+            return words;
+        }
+        while (statement.next()) {
+            words.append(buildWordFromStatement(statement, projection));
+        }
+        if (statement.hasError()) {
+            qWarning() << "Failed to query words:" << statement.lastError();
+        }
+        adapter_.recordNative(statement, sql, params);
+        return words;
+    }
+#endif
+    
+    auto query = adapter_.prepare(sql);
+    for (const QVariant& param : params) {
+        query.addBindValue(param);
+    }
+    
+    if (!adapter_.exec(query)) {
+        qWarning() << "Failed to query words:" << query.lastError().text();
+        return words;
+    }
+    
+    while (query.next()) {
+        words.append(buildWordFromQuery(query, projection));
+    }
+    adapter_.recordRowsReturned(query, words.size());
+    
+    return words;
+}
+
+// 列序号与 kSummaryColumns、kDetailColumns 一致
+Domain::Word WordRepository::buildWordFromQuery(QSqlQuery& query,
+                                                Domain::WordProjection projection) {
     Domain::Word word;
     
-    word.id = query.value("id").toInt();
-    word.bookId = query.value("book_id").toString();
-    word.wordId = query.value("word_id").toInt();
-    word.word = query.value("word").toString();
-    word.phoneticUk = query.value("phonetic_uk").toString();
-    word.phoneticUs = query.value("phonetic_us").toString();
-    word.translations = query.value("translations").toString();
-    word.sentences = query.value("sentences").toString();
-    word.phrases = query.value("phrases").toString();
-    word.synonyms = query.value("synonyms").toString();
-    word.relatedWords = query.value("related_words").toString();
-    word.etymology = query.value("etymology").toString();
-    word.createdAt = query.value("created_at").toDateTime();
+    word.id = query.value(0).toInt();
+    word.bookId = query.value(1).toString();
+    word.wordId = query.value(2).toInt();
+    word.word = query.value(3).toString();
+    word.phoneticUk = query.value(4).toString();
+    word.phoneticUs = query.value(5).toString();
+    word.gloss = query.value(6).toString();
+    word.createdAt = query.value(7).toDateTime();
+    
+    if (projection == Domain::WordProjection::Full) {
+        const int d = kSummaryColumnCount;
+        word.translations = detailText(query.value(d));
+        word.sentences = detailText(query.value(d + 1));
+        word.phrases = detailText(query.value(d + 2));
+        word.synonyms = detailText(query.value(d + 3));
+        word.relatedWords = detailText(query.value(d + 4));
+        word.etymology = detailText(query.value(d + 5));
+    }
+    
+    return word;
+}
+
+#ifdef WORDMASTER_NATIVE_SQLITE
+Domain::Word WordRepository::buildWordFromStatement(const NativeStatement& statement,
+                                                    Domain::WordProjection projection) {
+    Domain::Word word;
+    
+    word.id = statement.columnInt(0);
+    word.bookId = statement.columnText(1);
+    word.wordId = statement.columnInt(2);
+    word.word = statement.columnText(3);
+    word.phoneticUk = statement.columnText(4);
+    word.phoneticUs = statement.columnText(5);
+    word.gloss = statement.columnText(6);
+    word.createdAt = statement.columnDateTime(7);
+    
+    if (projection == Domain::WordProjection::Full) {
+        const int d = kSummaryColumnCount;
+        auto detail = [&](int column) {
+            return statement.isBlob(column) ? decodeDetail(statement.columnBlob(column))
+                                            : statement.columnText(column);
+        };
+        word.translations = detail(d);
+        word.sentences = detail(d + 1);
+        word.phrases = detail(d + 2);
+        word.synonyms = detail(d + 3);
+        word.relatedWords = detail(d + 4);
+        word.etymology = detail(d + 5);
+    }
     
     return word;
 }
+#endif
 
 } // namespace Infrastructure
-} // namespace WordMaster
\ No newline at end of file
+} // namespace WordMaster
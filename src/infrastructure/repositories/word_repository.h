@@ -1,8 +1,10 @@
 #ifndef WORDMASTER_INFRASTRUCTURE_WORD_REPOSITORY_H
 #define WORDMASTER_INFRASTRUCTURE_WORD_REPOSITORY_H
 
+#include <QSet>
 #include "domain/repositories.h"
 #include "infrastructure/sqlite_adapter.h"
+#include "infrastructure/detail_codec.h"
 
 namespace WordMaster {
 namespace Infrastructure {
@@ -17,38 +19,246 @@ namespace Infrastructure {
  */
 class WordRepository : public Domain::IWordRepository {
 public:
+    /**
+     * @brief 批量写入统计（saveBatch 累计）
+     */
+    struct BulkLoadStats {
+        quint64 rows = 0;           // 写入行数
+        quint64 statements = 0;     // 执行的 INSERT 语句数
+        qint64 elapsedUs = 0;       // 累计耗时（含事务提交）
+        
+        double rowsPerSecond() const {
+            return elapsedUs > 0 ? rows * 1000000.0 / elapsedUs : 0.0;
+        }
+    };
+    
+    /**
+     * @brief 最近一次 compressDetails 的统计（只计本次压缩的字段）
+     */
+    struct DetailCompressionStats {
+        int rows = 0;               // 更新的 word_details 行数
+        int fields = 0;             // 压缩的字段数
+        qint64 bytesBefore = 0;     // 压缩前 UTF-8 字节数
+        qint64 bytesAfter = 0;      // 压缩后字节数（含 4 字节字典 id）
+        int dictionaryBytes = 0;    // 本次新训练的字典大小（复用已有字典时为 0）
+        qint64 elapsedMs = 0;
+        
+        double ratio() const {
+            return bytesAfter > 0 ? static_cast<double>(bytesBefore) / bytesAfter : 0.0;
+        }
+    };
+    
     explicit WordRepository(SQLiteAdapter& adapter);
     ~WordRepository() override = default;
     
     // 基本CRUD
     bool save(const Domain::Word& word) override;
-    Domain::Word getById(int id) override;
-    QList<Domain::Word> getByIds(const QList<int>& ids) override;
+    Domain::Word getById(int id, Domain::WordProjection projection =
+                                     Domain::WordProjection::Full) override;
+    
+    /**
+     * @brief 按 id 批量读取
+     * 
+     * 每 256 个 id 一条固定长度的 IN 查询（末组补齐），复用同一条缓存语句，
+     * 参数数不受 id 数量影响；结果按 ids 的顺序重排。
+     */
+    QList<Domain::Word> getByIds(const QList<int>& ids,
+                                 Domain::WordProjection projection =
+                                     Domain::WordProjection::Full) override;
     bool remove(int id) override;
     bool exists(int id) override;
+    bool update(const Domain::Word& word) override;
+    bool loadDetails(Domain::Word& word) override;
+    
+    // 结构化字段：读子表主键；仅对尚未补建子表的单词（见 backfillStructuredFields）解析 JSON
+    QList<Domain::WordTranslation> getTranslations(int wordId) override;
+    QList<Domain::WordSentence> getSentences(int wordId) override;
+    QList<Domain::WordPhrase> getPhrases(int wordId) override;
     
     // 查询
     QList<Domain::Word> getByBookId(const QString& bookId, 
                                      int limit = -1, 
-                                     int offset = 0) override;
-    QList<Domain::Word> searchByWord(const QString& word) override;
+                                     int offset = 0,
+                                     Domain::WordProjection projection =
+                                         Domain::WordProjection::Full) override;
+    QList<Domain::Word> searchByWord(const QString& word,
+                                     Domain::WordProjection projection =
+                                         Domain::WordProjection::Full) override;
+    
+    /**
+     * @brief 全文搜索
+     * 
+     * 每个词加引号后交给 FTS5 MATCH（语法字符不生效），以字母数字结尾的词按前缀匹配，
+     * 多个词之间为 AND；按 bm25 排序，列权重为 单词 > 释义 > 例句 > 短语。
+     * 索引不可用时（SQLite 不含 FTS5 或补建尚未完成）回退为 LIKE 匹配单词与简释。
+     */
+    QList<Domain::WordSearchHit> search(const QString& text, const QString& bookId = QString(),
+                                        int limit = 50) override;
     Domain::Word getByBookAndWord(const QString& bookId, 
                                   const QString& word) override;
+    QList<Domain::WordFingerprint> getFingerprints(const QString& bookId) override;
+    QList<int> getWordIdsByPos(const QString& bookId, const QStringList& posList) override;
     
     // 批量操作
+    
+    /**
+     * @brief 批量写入
+     * 
+     * words 每 142 行（7 列 × 142 < 999 个参数）、word_details 每 124 行一条多行 INSERT，
+     * 复用同一条缓存语句；释义、例句、短语同样按参数上限分组写入子表。
+     * 任一单词无效时不写入任何数据。
+     */
     bool saveBatch(const QList<Domain::Word>& words) override;
     bool removeByBookId(const QString& bookId) override;
     
+    /**
+     * @brief 压缩词库的 word_details 字段
+     * 
+     * 复用该词库已有的字典，没有时用该词库尚未压缩的字段训练一个（存入 detail_dictionaries）。
+     * 仍为 TEXT 的字段逐个压缩为 BLOB，过短或压缩后不变小的字段保持原样；
+     * 读取时按类型区分，BLOB 按其中的字典 id 加载字典并解压。
+     * 词库过小（样本不足以训练字典）时不做任何修改，返回true。
+     * 释放的页面需 VACUUM 后才会从文件中回收。
+     */
+    bool compressDetails(const QString& bookId) override;
+    DetailCompressionStats compressionStats() const;
+    
+    BulkLoadStats bulkLoadStats() const;
+    void resetBulkLoadStats();
+    
     // 事务支持
     bool beginTransaction() override;
     bool commit() override;
     bool rollback() override;
+    
+    /**
+     * @brief 开始批量导入
+     * 
+     * 切换到 bulk-import 存储配置（已在事务中时保持当前配置，temp_store 不能在事务内修改），
+     * 开始事务并删除 words 表的二级索引；主键与 UNIQUE(book_id, word_id) 是表约束，保留。
+     * 期间 (book_id, word) 的唯一性不再由索引保证。
+     * 导入管线只在每批内按 word_id 排序（sortByWordId），批与批之间不保证有序，
+     * UNIQUE(book_id, word_id) 的插入只在批内按键序追加。
+     */
+    bool beginBulkLoad() override;
+    
+    /**
+     * @brief 提交批量导入
+     * 
+     * 对本次 saveBatch 写入过的词库按 (book_id, word) 一次排序去重（保留最后写入的行，
+     * 与 INSERT OR REPLACE 一致），重建删除的索引后提交；任一步失败则整体回滚。两种情况都恢复原存储配置。
+     */
+    bool commitBulkLoad() override;
+    bool rollbackBulkLoad() override;
+    
+    bool isBulkLoading() const;
+    
+    /**
+     * @brief 为迁移前已有的单词补建一批全文索引
+     * 
+     * word_search 由迁移 008 创建（SQLite 不含 FTS5 时不存在），之后 save/saveBatch/update
+     * 同步写入索引；迁移时已有的单词由本方法分批补建，每次调用一个短事务，
+     * 可在界面空闲时反复调用。全部补建完成后合并索引段。
+     * 
+     * @param maxWords 本次最多补建的单词数
+     * @return 剩余待补建的单词数，失败返回 -1
+     */
+    int backfillSearchIndex(int maxWords);
+    
+    /**
+     * @brief 剩余待补建索引的单词数
+     */
+    int searchBackfillRemaining();
+    
+    /**
+     * @brief 为 006 之前导入的单词补建一批结构化子表
+     * 
+     * 待补建的单词由迁移 009 记录，本方法解析其 word_details（含压缩字段）写入子表，
+     * 每次调用一个短事务，可在界面空闲时反复调用。
+     * 
+     * @param maxWords 本次最多补建的单词数
+     * @return 剩余待补建的单词数，失败返回 -1
+     */
+    int backfillStructuredFields(int maxWords);
+    
+    /**
+     * @brief 剩余待补建子表的单词数
+     */
+    int structuredBackfillRemaining();
+    
+    /**
+     * @brief 重建全文索引（清空后为全部单词建索引，同时完成未完成的补建）
+     */
+    bool rebuildSearchIndex();
+    bool hasSearchIndex();
+    
+    /**
+     * @brief 全文索引存在且已补建完成（此时 search 才使用索引）
+     */
+    bool isSearchIndexReady();
 
 private:
+    struct DeferredIndex {
+        QString name;
+        QString sql;                // sqlite_master 中的建索引语句
+    };
+    
     SQLiteAdapter& adapter_;
+    int searchIndexState_;          // word_search 是否存在：-1 未检查，0 否，1 是
+    bool searchBackfillDone_;       // 已确认没有待补建的索引（补建范围只由迁移写入）
+    bool structuredBackfillDone_;   // 已确认没有待补建子表的单词（待补建列表只由迁移写入）
+    BulkLoadStats bulkStats_;
+    DetailCompressionStats compressionStats_;
+    
+    // 已加载的字典按需从 detail_dictionaries 读取；仓储与连接同线程使用
+    DetailCodec codec_;
+    
+    // 批量导入期间删除的索引与切换前的存储配置
+    bool bulkLoading_;
+    bool profileSwitched_;
+    StorageProfile savedProfile_;
+    QList<DeferredIndex> deferredIndexes_;
+    QSet<QString> bulkBookIds_;     // 批量导入期间写入过的词库（提交时只对这些词库去重）
+    
+    // 结束批量导入：恢复存储配置并清理状态
+    void finishBulkLoad();
+    
+    // 尚未补建子表的单词在 word_details 中单个 JSON 列的值；已补建或不在列表中返回空串
+    QString pendingDetailJson(int wordId, const char* column);
+    
+    // 详情字段的值：TEXT 原样返回，BLOB 解压（失败返回空串）
+    QString detailText(const QVariant& value);
+    QString decodeDetail(const QByteArray& blob);
+    bool loadDictionary(int dictionaryId);
+    
+    // 词库最近的字典 id（并加载到 codec_）；没有时返回 -1
+    int bookDictionary(const QString& bookId);
+    
+    // 全文索引不存在时的搜索
+    QList<Domain::WordSearchHit> searchWithoutIndex(const QString& text, const QString& bookId,
+                                                    int limit);
+    
+    // 为 id 在 [fromId, endId) 中的前 limit 个单词写入索引行（调用方开启事务）；
+    // 返回写入的单词数，lastId 为最后一个单词的 id；失败返回 -1
+    int indexWords(int fromId, int endId, int limit, int& lastId);
+    
+    // 合并索引段，查询时只需读一棵 b-tree
+    bool optimizeSearchIndex();
+    
+    // 删除 words 中将被本批 INSERT OR REPLACE 替换的行的索引行（REPLACE 不触发删除触发器）
+    bool removeReplacedSearchRows(const QList<Domain::Word>& words);
+    
+    // 执行单词查询（原生后端可用时绕过 QSqlQuery）；sql 以 selectWordsSql() 开头
+    QList<Domain::Word> queryWords(const QString& sql, const QVariantList& params,
+                                   Domain::WordProjection projection);
     
     // 辅助方法：从 QSqlQuery 构建 Word 对象
-    Domain::Word buildWordFromQuery(QSqlQuery& query);
+    Domain::Word buildWordFromQuery(QSqlQuery& query, Domain::WordProjection projection);
+    
+#ifdef WORDMASTER_NATIVE_SQLITE
+    Domain::Word buildWordFromStatement(const NativeStatement& statement,
+                                        Domain::WordProjection projection);
+#endif
 };
 
 } // namespace Infrastructure
@@ -16,7 +16,7 @@ bool WordTagRepository::add(int wordId, const QString& tagType) {
     query.addBindValue(wordId);
     query.addBindValue(tagType);
     
-    return query.exec();
+    return adapter_.exec(query);
 }
 
 bool WordTagRepository::remove(int wordId, const QString& tagType) {
@@ -26,7 +26,7 @@ bool WordTagRepository::remove(int wordId, const QString& tagType) {
     query.addBindValue(wordId);
     query.addBindValue(tagType);
     
-    return query.exec();
+    return adapter_.exec(query);
 }
 
 bool WordTagRepository::exists(int wordId, const QString& tagType) {
@@ -36,7 +36,7 @@ bool WordTagRepository::exists(int wordId, const QString& tagType) {
     query.addBindValue(wordId);
     query.addBindValue(tagType);
     
-    if (query.exec() && query.next()) {
+    if (adapter_.exec(query) && query.next()) {
         return query.value("cnt").toInt() > 0;
     }
     return false;
@@ -50,10 +50,11 @@ QList<int> WordTagRepository::getWordsByTag(const QString& tagType) {
     auto query = adapter_.prepare(sql);
     query.addBindValue(tagType);
     
-    if (query.exec()) {
+    if (adapter_.exec(query)) {
         while (query.next()) {
             wordIds.append(query.value("word_id").toInt());
         }
+        adapter_.recordRowsReturned(query, wordIds.size());
     }
     
     return wordIds;
@@ -67,10 +68,11 @@ QStringList WordTagRepository::getWordTags(int wordId) {
     auto query = adapter_.prepare(sql);
     query.addBindValue(wordId);
     
-    if (query.exec()) {
+    if (adapter_.exec(query)) {
         while (query.next()) {
             tags.append(query.value("tag_type").toString());
         }
+        adapter_.recordRowsReturned(query, tags.size());
     }
     
     return tags;
@@ -79,28 +81,35 @@ QStringList WordTagRepository::getWordTags(int wordId) {
 bool WordTagRepository::addBatch(const QList<int>& wordIds, const QString& tagType) {
     if (wordIds.isEmpty()) return true;
     
-    adapter_.beginTransaction();
+    SQLiteAdapter::Transaction tx(adapter_);
+    if (!tx.isActive()) {
+        return false;
+    }
     
     for (int wordId : wordIds) {
         if (!add(wordId, tagType)) {
-            adapter_.rollback();
             return false;
         }
     }
     
-    return adapter_.commit();
+    return tx.commit();
 }
 
 bool WordTagRepository::removeBatch(const QList<int>& wordIds, const QString& tagType) {
     if (wordIds.isEmpty()) return true;
     
-    adapter_.beginTransaction();
+    SQLiteAdapter::Transaction tx(adapter_);
+    if (!tx.isActive()) {
+        return false;
+    }
     
     for (int wordId : wordIds) {
-        remove(wordId, tagType);
+        if (!remove(wordId, tagType)) {
+            return false;
+        }
     }
     
-    return adapter_.commit();
+    return tx.commit();
 }
 
 int WordTagRepository::getTagCount(const QString& tagType) {
@@ -109,7 +118,7 @@ int WordTagRepository::getTagCount(const QString& tagType) {
     auto query = adapter_.prepare(sql);
     query.addBindValue(tagType);
     
-    if (query.exec() && query.next()) {
+    if (adapter_.exec(query) && query.next()) {
         return query.value("cnt").toInt();
     }
     
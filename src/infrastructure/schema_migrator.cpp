@@ -0,0 +1,251 @@
+#include "schema_migrator.h"
+#include <QDir>
+#include <QFile>
+#include <QCryptographicHash>
+#include <QRegularExpression>
+#include <QSqlQuery>
+#include <QDebug>
+#include <algorithm>
+
+namespace WordMaster {
+namespace Infrastructure {
+
+const char* const SchemaMigrator::kDefaultMigrationDir = ":/resources/database";
+
+SchemaMigrator::SchemaMigrator(SQLiteAdapter& adapter, const QString& migrationDir)
+    : adapter_(adapter)
+    , migrationDir_(migrationDir)
+{
+    QDir dir(migrationDir_);
+    QRegularExpression pattern("^(\\d+)_(.+)\\.sql$");
+
+    const QStringList files = dir.entryList(QStringList() << "*.sql", QDir::Files);
+    for (const QString& fileName : files) {
+        QRegularExpressionMatch match = pattern.match(fileName);
+        if (!match.hasMatch()) {
+            continue;
+        }
+
+        Migration migration;
+        migration.version = match.captured(1).toInt();
+        migration.name = match.captured(2);
+        migration.filePath = dir.filePath(fileName);
+
+        if (migration.version <= 0) {
+            qWarning() << "Ignoring migration with invalid version:" << fileName;
+            continue;
+        }
+        migrations_.append(migration);
+    }
+
+    std::sort(migrations_.begin(), migrations_.end(),
+              [](const Migration& a, const Migration& b) {
+                  return a.version < b.version;
+              });
+
+    for (int i = 1; i < migrations_.size(); ++i) {
+        if (migrations_[i].version == migrations_[i - 1].version) {
+            qWarning() << "Duplicate migration version:" << migrations_[i].filePath;
+        }
+    }
+}
+
+int SchemaMigrator::currentVersion() {
+    QSqlQuery query = adapter_.query("PRAGMA user_version");
+    if (query.next()) {
+        return query.value(0).toInt();
+    }
+    return 0;
+}
+
+int SchemaMigrator::latestVersion() const {
+    return migrations_.isEmpty() ? 0 : migrations_.last().version;
+}
+
+QList<SchemaMigrator::Migration> SchemaMigrator::migrations() const {
+    return migrations_;
+}
+
+SchemaMigrator::Result SchemaMigrator::migrate() {
+    Result result;
+
+    if (!adapter_.isOpen()) {
+        qWarning() << "Database not open";
+        return result;
+    }
+
+    result.fromVersion = currentVersion();
+    result.toVersion = result.fromVersion;
+
+    // 热启动：已是最新版本，只校验已执行的迁移，不做任何 DDL
+    if (result.fromVersion >= latestVersion()) {
+        result.checksumsMatch = verifyChecksums();
+        if (result.fromVersion > latestVersion()) {
+            qWarning() << "Database version" << result.fromVersion
+                       << "is newer than known migrations" << latestVersion();
+        }
+        result.success = true;
+        return result;
+    }
+
+    if (!ensureMigrationTable()) {
+        return result;
+    }
+    result.checksumsMatch = verifyChecksums();
+
+    for (const Migration& migration : migrations_) {
+        if (migration.version <= result.toVersion) {
+            continue;
+        }
+
+        if (!applyMigration(migration)) {
+            return result;
+        }
+
+        result.toVersion = migration.version;
+        ++result.appliedCount;
+    }
+
+    qDebug() << "Schema migrated from version" << result.fromVersion
+             << "to" << result.toVersion;
+    result.success = true;
+    return result;
+}
+
+bool SchemaMigrator::verifyChecksums() {
+    // 旧库升级前还没有迁移记录表
+    QSqlQuery table = adapter_.query(
+        "SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = 'schema_migrations'");
+    if (!table.next()) {
+        return true;
+    }
+
+    QSqlQuery query = adapter_.query(
+        "SELECT version, checksum FROM schema_migrations ORDER BY version");
+
+    bool consistent = true;
+    while (query.next()) {
+        int version = query.value(0).toInt();
+        QString stored = query.value(1).toString();
+
+        auto it = std::find_if(migrations_.begin(), migrations_.end(),
+                               [version](const Migration& m) {
+                                   return m.version == version;
+                               });
+        if (it == migrations_.end()) {
+            continue;
+        }
+
+        QString sql;
+        QString checksum;
+        if (readMigration(*it, sql, checksum) && checksum != stored) {
+            qWarning() << "Applied migration" << version << "has been modified since it ran:"
+                       << it->filePath << "(changes are not re-applied)";
+            consistent = false;
+        }
+    }
+
+    return consistent;
+}
+
+bool SchemaMigrator::ensureMigrationTable() {
+    return adapter_.execute(
+        "CREATE TABLE IF NOT EXISTS schema_migrations ("
+        "    version INTEGER PRIMARY KEY,"
+        "    name TEXT NOT NULL,"
+        "    checksum TEXT NOT NULL,"
+        "    applied_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP"
+        ")");
+}
+
+bool SchemaMigrator::applyMigration(const Migration& migration) {
+    QString sql;
+    QString checksum;
+    if (!readMigration(migration, sql, checksum)) {
+        return false;
+    }
+
+    QStringList statements = SQLiteAdapter::splitSqlStatements(sql);
+    static const QRegularExpression optionalMarker("^--\\s*@optional\\s*$",
+                                                   QRegularExpression::MultilineOption);
+    const bool optional = optionalMarker.match(sql).hasMatch();
+
+    SQLiteAdapter::Transaction tx(adapter_);
+    if (!tx.isActive()) {
+        return false;
+    }
+
+    {
+        // 迁移语句在保存点中执行：可选迁移失败时只撤销这些语句，版本照常记录
+        SQLiteAdapter::Transaction statementsTx(adapter_);
+        if (!statementsTx.isActive()) {
+            return false;
+        }
+
+        bool executed = true;
+        for (const QString& statement : statements) {
+            if (!adapter_.execute(statement)) {
+                if (!optional) {
+                    qWarning() << "Migration" << migration.version
+                               << "failed at statement:" << statement;
+                    return false;
+                }
+                executed = false;
+                break;
+            }
+        }
+
+        if (executed) {
+            if (!statementsTx.commit()) {
+                return false;
+            }
+        } else {
+            qDebug() << "Optional migration" << migration.version << migration.name
+                     << "is not supported by this SQLite build, skipped";
+            if (!statementsTx.rollback()) {
+                return false;
+            }
+        }
+    }
+
+    QSqlQuery record = adapter_.prepare(
+        "INSERT OR REPLACE INTO schema_migrations (version, name, checksum) "
+        "VALUES (?, ?, ?)");
+    record.addBindValue(migration.version);
+    record.addBindValue(migration.name);
+    record.addBindValue(checksum);
+
+    // PRAGMA 不支持参数绑定；版本号来自文件名中的数字
+    if (!adapter_.exec(record)
+        || !adapter_.execute(QString("PRAGMA user_version = %1").arg(migration.version))) {
+        qWarning() << "Failed to record migration" << migration.version;
+        return false;
+    }
+
+    if (!tx.commit()) {
+        return false;
+    }
+
+    qDebug() << "Applied migration" << migration.version << migration.name;
+    return true;
+}
+
+bool SchemaMigrator::readMigration(const Migration& migration,
+                                   QString& sql, QString& checksum) {
+    QFile file(migration.filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "Failed to open migration file:" << migration.filePath;
+        return false;
+    }
+
+    QByteArray content = file.readAll();
+    file.close();
+
+    checksum = QString::fromLatin1(
+        QCryptographicHash::hash(content, QCryptographicHash::Sha256).toHex());
+    sql = QString::fromUtf8(content);
+    return true;
+}
+
+} // namespace Infrastructure
+} // namespace WordMaster
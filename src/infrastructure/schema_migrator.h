@@ -0,0 +1,92 @@
+#ifndef WORDMASTER_INFRASTRUCTURE_SCHEMA_MIGRATOR_H
+#define WORDMASTER_INFRASTRUCTURE_SCHEMA_MIGRATOR_H
+
+#include "infrastructure/sqlite_adapter.h"
+#include <QString>
+#include <QList>
+
+namespace WordMaster {
+namespace Infrastructure {
+
+/**
+ * @brief 数据库结构迁移器
+ *
+ * 迁移文件按 NNN_描述.sql 命名，编号即版本号。
+ * 当前版本保存在 PRAGMA user_version 中，已执行的迁移及其校验和
+ * 记录在 schema_migrations 表中。
+ *
+ * - 每个迁移只执行一次，连同版本号更新在同一个事务中提交
+ * - 版本已是最新时只读取 user_version 与 schema_migrations，不执行任何 DDL
+ * - 每次 migrate() 都校验已执行迁移的校验和，文件内容被修改时给出警告（不会重新执行）
+ * - 含有 "-- @optional" 注释行的迁移依赖可选的 SQLite 功能（如 FTS5）：
+ *   语句失败时撤销本迁移的语句，仍记录版本，之后不再尝试
+ */
+class SchemaMigrator {
+public:
+    // 内置迁移脚本目录（Qt 资源）
+    static const char* const kDefaultMigrationDir;
+
+    struct Migration {
+        int version;
+        QString name;
+        QString filePath;
+    };
+
+    struct Result {
+        bool success = false;
+        int fromVersion = 0;
+        int toVersion = 0;
+        int appliedCount = 0;
+        bool checksumsMatch = true;     // 已执行迁移的文件未被修改
+    };
+
+    /**
+     * @brief 构造函数
+     * @param adapter 已打开的写连接
+     * @param migrationDir 迁移脚本目录
+     */
+    explicit SchemaMigrator(SQLiteAdapter& adapter,
+                            const QString& migrationDir = kDefaultMigrationDir);
+
+    /**
+     * @brief 校验已执行迁移的校验和，然后执行所有未执行的迁移
+     */
+    Result migrate();
+
+    /**
+     * @brief 数据库当前版本（PRAGMA user_version）
+     */
+    int currentVersion();
+
+    /**
+     * @brief 迁移目录中的最高版本
+     */
+    int latestVersion() const;
+
+    /**
+     * @brief 按版本号排序的迁移列表
+     */
+    QList<Migration> migrations() const;
+
+    /**
+     * @brief 校验已执行迁移的校验和（不一致的迁移逐个记录警告）
+     * @return 全部一致（或尚无迁移记录）返回true
+     */
+    bool verifyChecksums();
+
+private:
+    bool ensureMigrationTable();
+    bool applyMigration(const Migration& migration);
+
+    static bool readMigration(const Migration& migration,
+                              QString& sql, QString& checksum);
+
+    SQLiteAdapter& adapter_;
+    QString migrationDir_;
+    QList<Migration> migrations_;
+};
+
+} // namespace Infrastructure
+} // namespace WordMaster
+
+#endif // WORDMASTER_INFRASTRUCTURE_SCHEMA_MIGRATOR_H
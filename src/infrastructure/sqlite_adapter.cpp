@@ -4,6 +4,9 @@
 #include <QUuid>
 #include <QSqlRecord>
 #include <QRegularExpression>
+#include <QElapsedTimer>
+#include <QDateTime>
+#include <QSqlDriver>
 
 
 namespace WordMaster {
@@ -12,6 +15,15 @@ namespace Infrastructure {
 SQLiteAdapter::SQLiteAdapter(const QString& dbPath)
     : dbPath_(dbPath)
     , connectionName_(QUuid::createUuid().toString())
+    , readOnly_(false)
+    , profile_(StorageProfile::desktop())
+    , transactionDepth_(0)
+    , statementCacheCapacity_(kDefaultStatementCacheCapacity)
+    , statementClock_(0)
+#ifdef WORDMASTER_NATIVE_SQLITE
+    , nativeHandle_(nullptr)
+    , nativeEnabled_(true)
+#endif
 {
 }
 
@@ -19,6 +31,83 @@ SQLiteAdapter::~SQLiteAdapter() {
     close();
 }
 
+void SQLiteAdapter::setReadOnly(bool readOnly) {
+    if (isOpen()) {
+        qWarning() << "setReadOnly() must be called before open()";
+        return;
+    }
+    readOnly_ = readOnly;
+}
+
+bool SQLiteAdapter::isReadOnly() const {
+    return readOnly_;
+}
+
+bool SQLiteAdapter::setStorageProfile(const StorageProfile& profile) {
+    profile_ = profile;
+    
+    if (!isOpen()) {
+        return true;
+    }
+    return applyStorageProfile();
+}
+
+StorageProfile SQLiteAdapter::storageProfile() const {
+    return profile_;
+}
+
+int SQLiteAdapter::pageSize() {
+    QSqlQuery result = query("PRAGMA page_size");
+    if (result.next()) {
+        return result.value(0).toInt();
+    }
+    return 0;
+}
+
+bool SQLiteAdapter::rebuildWithPageSize() {
+    if (readOnly_) {
+        qWarning() << "Cannot rebuild a read-only connection";
+        return false;
+    }
+    
+    if (pageSize() == profile_.pageSize) {
+        return true;
+    }
+    
+    // VACUUM 不能在有未完成语句时执行
+    clearStatementCache();
+    lastQuery_ = QSqlQuery();
+    
+    bool ok = execute("PRAGMA journal_mode = DELETE")
+           && execute(QString("PRAGMA page_size = %1").arg(profile_.pageSize))
+           && execute("VACUUM");
+    
+    // 无论成功与否都恢复 WAL
+    execute("PRAGMA journal_mode = WAL");
+    
+    if (ok) {
+        qDebug() << "Database rebuilt with page size" << pageSize();
+    }
+    return ok;
+}
+
+bool SQLiteAdapter::applyStorageProfile() {
+    bool ok = execute(QString("PRAGMA cache_size = -%1").arg(profile_.cacheSizeKiB))
+           && execute(QString("PRAGMA mmap_size = %1").arg(profile_.mmapSize))
+           && execute(QString("PRAGMA temp_store = %1").arg(profile_.tempStore))
+           && execute(QString("PRAGMA busy_timeout = %1").arg(profile_.busyTimeoutMs));
+    
+    // 检查点由写连接触发
+    if (ok && !readOnly_) {
+        ok = execute(QString("PRAGMA wal_autocheckpoint = %1").arg(profile_.walAutoCheckpoint));
+    }
+    
+    if (!ok) {
+        qWarning() << "Failed to apply storage profile:" << profile_.name;
+    }
+    return ok;
+}
+
 bool SQLiteAdapter::open() {
     if (isOpen()) {
         return true;
@@ -27,6 +116,10 @@ bool SQLiteAdapter::open() {
     db_ = QSqlDatabase::addDatabase("QSQLITE", connectionName_);
     db_.setDatabaseName(dbPath_);
     
+    if (readOnly_) {
+        db_.setConnectOptions("QSQLITE_OPEN_READONLY");
+    }
+    
     if (!db_.open()) {
         qWarning() << "Failed to open database:" << db_.lastError().text();
         return false;
@@ -35,9 +128,19 @@ bool SQLiteAdapter::open() {
     // 启用外键约束
     execute("PRAGMA foreign_keys = ON");
     
-    // 优化性能
+    // 优化性能（journal_mode 由写连接设置，只读连接无权修改）
+    // page_size 必须在切换到 WAL 之前设置，且只对新建的数据库生效
     execute("PRAGMA synchronous = NORMAL");
-    execute("PRAGMA journal_mode = WAL");
+    if (!readOnly_) {
+        execute(QString("PRAGMA page_size = %1").arg(profile_.pageSize));
+        execute("PRAGMA journal_mode = WAL");
+    }
+    
+    applyStorageProfile();
+    
+#ifdef WORDMASTER_NATIVE_SQLITE
+    attachNativeHandle();
+#endif
     
     qDebug() << "Database opened successfully:" << dbPath_;
     return true;
@@ -45,6 +148,13 @@ bool SQLiteAdapter::open() {
 
 void SQLiteAdapter::close() {
     if (isOpen()) {
+        // 缓存的语句必须在连接关闭前释放
+        clearStatementCache();
+        lastQuery_ = QSqlQuery();
+        transactionDepth_ = 0;
+#ifdef WORDMASTER_NATIVE_SQLITE
+        nativeHandle_ = nullptr;
+#endif
         db_.close();
         QSqlDatabase::removeDatabase(connectionName_);
         qDebug() << "Database closed:" << dbPath_;
@@ -61,7 +171,7 @@ bool SQLiteAdapter::execute(const QString& sql) {
         return false;
     }
     
-    lastQuery_ = db_.exec(sql);
+    lastQuery_ = execRaw(sql);
     
     if (lastQuery_.lastError().isValid()) {
         qWarning() << "SQL execution failed:" 
@@ -79,7 +189,7 @@ QSqlQuery SQLiteAdapter::query(const QString& sql) {
         return QSqlQuery();
     }
     
-    lastQuery_ = db_.exec(sql);
+    lastQuery_ = execRaw(sql);
     
     if (lastQuery_.lastError().isValid()) {
         qWarning() << "SQL query failed:" 
@@ -90,34 +200,223 @@ QSqlQuery SQLiteAdapter::query(const QString& sql) {
     return lastQuery_;
 }
 
+QSqlQuery SQLiteAdapter::execRaw(const QString& sql) {
+    if (!profiler_.isEnabled()) {
+        return db_.exec(sql);
+    }
+    
+    QElapsedTimer timer;
+    timer.start();
+    QSqlQuery result = db_.exec(sql);
+    qint64 elapsed = timer.nsecsElapsed();
+    
+    bool ok = !result.lastError().isValid();
+    int rows = (ok && !result.isSelect()) ? result.numRowsAffected() : 0;
+    recordExecution(sql, QVariantList(), elapsed, ok, rows);
+    return result;
+}
+
+bool SQLiteAdapter::exec(QSqlQuery& query) {
+    if (!profiler_.isEnabled()) {
+        return query.exec();
+    }
+    
+    QElapsedTimer timer;
+    timer.start();
+    bool ok = query.exec();
+    qint64 elapsed = timer.nsecsElapsed();
+    
+    int rows = (ok && !query.isSelect()) ? query.numRowsAffected() : 0;
+    
+    QString sql = query.lastQuery();
+    QVariantList boundValues;
+    if (profiler_.needsBoundValues(sql, elapsed)) {
+        int count = query.boundValues().size();
+        for (int i = 0; i < count; ++i) {
+            boundValues.append(query.boundValue(i));
+        }
+    }
+    
+    recordExecution(sql, boundValues, elapsed, ok, rows);
+    return ok;
+}
+
+void SQLiteAdapter::recordRowsReturned(const QSqlQuery& query, int rows) {
+    if (profiler_.isEnabled()) {
+        profiler_.recordRowsReturned(query.lastQuery(), rows);
+    }
+}
+
+QueryProfiler& SQLiteAdapter::profiler() {
+    return profiler_;
+}
+
+const QueryProfiler& SQLiteAdapter::profiler() const {
+    return profiler_;
+}
+
+void SQLiteAdapter::recordExecution(const QString& sql, const QVariantList& boundValues,
+                                    qint64 elapsedNs, bool ok, int rowsAffected,
+                                    int rowsReturned) {
+    if (!profiler_.record(sql, boundValues, elapsedNs, ok, rowsAffected, rowsReturned)) {
+        return;
+    }
+    
+    QueryProfiler::SlowQuery slow;
+    slow.executedAt = QDateTime::currentDateTime();
+    slow.sql = sql;
+    slow.boundValues = boundValues;
+    slow.elapsedUs = elapsedNs / 1000;
+    slow.plan = explainQueryPlan(sql, boundValues);
+    profiler_.addSlowQuery(slow);
+}
+
+QStringList SQLiteAdapter::explainQueryPlan(const QString& sql, const QVariantList& boundValues) {
+    QStringList plan;
+    
+    // 只对 DML 取查询计划（PRAGMA/DDL/事务语句不支持或没有意义）
+    static const QRegularExpression dml("^\\s*(SELECT|INSERT|UPDATE|DELETE|REPLACE|WITH)\\b",
+                                        QRegularExpression::CaseInsensitiveOption);
+    if (!dml.match(sql).hasMatch()) {
+        return plan;
+    }
+    
+    // 不经过 exec()，避免计入统计
+    QSqlQuery explain(db_);
+    if (!explain.prepare("EXPLAIN QUERY PLAN " + sql)) {
+        return plan;
+    }
+    for (const QVariant& value : boundValues) {
+        explain.addBindValue(value);
+    }
+    
+    if (explain.exec()) {
+        while (explain.next()) {
+            plan << explain.value(3).toString();
+        }
+    }
+    return plan;
+}
+
 QSqlQuery SQLiteAdapter::prepare(const QString& sql) {
     if (!isOpen()) {
         qWarning() << "Database not open";
         return QSqlQuery();
     }
     
+    auto it = statementCache_.find(sql);
+    if (it != statementCache_.end()) {
+        ++cacheStats_.hits;
+        it->lastUsed = ++statementClock_;
+        
+        // 复位上一次执行留下的游标，保留已编译的语句
+        it->query.finish();
+        return it->query;
+    }
+    
+    ++cacheStats_.misses;
+    
     QSqlQuery q(db_);
+    q.setForwardOnly(true);
     
     if (!q.prepare(sql)) {
         qWarning() << "SQL prepare failed:" 
                    << q.lastError().text()
                    << "\nSQL:" << sql;
+        return q;
+    }
+    
+    if (statementCacheCapacity_ > 0) {
+        if (statementCache_.size() >= statementCacheCapacity_) {
+            evictLeastRecentlyUsed();
+        }
+        
+        CachedStatement entry;
+        entry.query = q;
+        entry.lastUsed = ++statementClock_;
+        statementCache_.insert(sql, entry);
     }
     
     return q;
 }
 
+void SQLiteAdapter::setStatementCacheCapacity(int capacity) {
+    statementCacheCapacity_ = qMax(0, capacity);
+    
+    while (statementCache_.size() > statementCacheCapacity_) {
+        evictLeastRecentlyUsed();
+    }
+}
+
+void SQLiteAdapter::clearStatementCache() {
+    statementCache_.clear();
+#ifdef WORDMASTER_NATIVE_SQLITE
+    finalizeNativeStatements();
+#endif
+}
+
+SQLiteAdapter::StatementCacheStats SQLiteAdapter::statementCacheStats() const {
+    StatementCacheStats stats = cacheStats_;
+    stats.size = statementCache_.size();
+    stats.capacity = statementCacheCapacity_;
+    return stats;
+}
+
+void SQLiteAdapter::resetStatements() {
+    for (auto it = statementCache_.begin(); it != statementCache_.end(); ++it) {
+        it->query.finish();
+    }
+    
+    if (lastQuery_.isActive() && lastQuery_.isSelect()) {
+        lastQuery_.finish();
+    }
+    
+#ifdef WORDMASTER_NATIVE_SQLITE
+    for (const CachedNativeStatement& entry : nativeStatements_) {
+        sqlite3_reset(entry.stmt.get());
+    }
+#endif
+}
+
+void SQLiteAdapter::evictLeastRecentlyUsed() {
+    if (statementCache_.isEmpty()) {
+        return;
+    }
+    
+    // 容量较小（默认 64），线性查找即可
+    auto oldest = statementCache_.begin();
+    for (auto it = statementCache_.begin(); it != statementCache_.end(); ++it) {
+        if (it->lastUsed < oldest->lastUsed) {
+            oldest = it;
+        }
+    }
+    
+    statementCache_.erase(oldest);
+    ++cacheStats_.evictions;
+}
+
 bool SQLiteAdapter::beginTransaction() {
     if (!isOpen()) {
         qWarning() << "Database not open";
         return false;
     }
     
+    // 已在事务中：用保存点嵌套
+    if (transactionDepth_ > 0) {
+        if (!execute(QString("SAVEPOINT sp_%1").arg(transactionDepth_))) {
+            return false;
+        }
+        ++transactionDepth_;
+        return true;
+    }
+    
     bool success = db_.transaction();
     if (!success) {
         qWarning() << "Failed to begin transaction:" << db_.lastError().text();
+        return false;
     }
-    return success;
+    transactionDepth_ = 1;
+    return true;
 }
 
 bool SQLiteAdapter::commit() {
@@ -126,11 +425,27 @@ bool SQLiteAdapter::commit() {
         return false;
     }
     
+    if (transactionDepth_ == 0) {
+        qWarning() << "commit() called without an active transaction";
+        return false;
+    }
+    
+    if (transactionDepth_ > 1) {
+        if (!execute(QString("RELEASE SAVEPOINT sp_%1").arg(transactionDepth_ - 1))) {
+            return false;
+        }
+        --transactionDepth_;
+        return true;
+    }
+    
+    // 提交失败时保持事务状态，调用方随后 rollback()
     bool success = db_.commit();
     if (!success) {
         qWarning() << "Failed to commit transaction:" << db_.lastError().text();
+        return false;
     }
-    return success;
+    transactionDepth_ = 0;
+    return true;
 }
 
 bool SQLiteAdapter::rollback() {
@@ -139,6 +454,21 @@ bool SQLiteAdapter::rollback() {
         return false;
     }
     
+    if (transactionDepth_ == 0) {
+        qWarning() << "rollback() called without an active transaction";
+        return false;
+    }
+    
+    if (transactionDepth_ > 1) {
+        QString savepoint = QString("sp_%1").arg(transactionDepth_ - 1);
+        --transactionDepth_;
+        
+        // ROLLBACK TO 保留保存点本身，需要再 RELEASE
+        return execute("ROLLBACK TO SAVEPOINT " + savepoint)
+            && execute("RELEASE SAVEPOINT " + savepoint);
+    }
+    
+    transactionDepth_ = 0;
     bool success = db_.rollback();
     if (!success) {
         qWarning() << "Failed to rollback transaction:" << db_.lastError().text();
@@ -146,6 +476,50 @@ bool SQLiteAdapter::rollback() {
     return success;
 }
 
+int SQLiteAdapter::transactionDepth() const {
+    return transactionDepth_;
+}
+
+// ============================================
+// Transaction
+// ============================================
+SQLiteAdapter::Transaction::Transaction(SQLiteAdapter& adapter)
+    : adapter_(adapter)
+    , active_(adapter.beginTransaction())
+{
+}
+
+SQLiteAdapter::Transaction::~Transaction() {
+    if (active_) {
+        adapter_.rollback();
+    }
+}
+
+bool SQLiteAdapter::Transaction::isActive() const {
+    return active_;
+}
+
+bool SQLiteAdapter::Transaction::commit() {
+    if (!active_) {
+        return false;
+    }
+    
+    // 提交失败时保持活动状态，由析构函数回滚
+    if (!adapter_.commit()) {
+        return false;
+    }
+    active_ = false;
+    return true;
+}
+
+bool SQLiteAdapter::Transaction::rollback() {
+    if (!active_) {
+        return false;
+    }
+    active_ = false;
+    return adapter_.rollback();
+}
+
 int SQLiteAdapter::lastInsertId() const {
     if (lastQuery_.isActive()) {
         return lastQuery_.lastInsertId().toInt();
@@ -167,8 +541,7 @@ QString SQLiteAdapter::lastError() const {
     return db_.lastError().text();
 }
 
-QStringList splitSqlStatements(const QString &sqlContent)
-{
+QStringList SQLiteAdapter::splitSqlStatements(const QString& sqlContent) {
     QString cleaned = sqlContent;
 
     // 1. 去除 /* ... */ 块注释
@@ -197,14 +570,35 @@ QStringList splitSqlStatements(const QString &sqlContent)
         QStringList rawStatements = joined.split(';', QString::SkipEmptyParts);
     #endif
 
-    // 4. 去空白
+    // 4. 去空白；触发器体内的语句合并回 CREATE TRIGGER，直到 END
+    static const QRegularExpression triggerStart(
+        "^CREATE\\s+(TEMP\\s+|TEMPORARY\\s+)?TRIGGER\\b",
+        QRegularExpression::CaseInsensitiveOption);
+    static const QRegularExpression triggerEnd("^END$", QRegularExpression::CaseInsensitiveOption);
+
     QStringList statements;
+    QString trigger;
     for (QString stmt : rawStatements) {
         QString trimmed = stmt.trimmed();
-        if (!trimmed.isEmpty()) {
+        if (trimmed.isEmpty()) {
+            continue;
+        }
+        if (!trigger.isEmpty()) {
+            trigger += '\n';
+            trigger += trimmed + ';';
+            if (triggerEnd.match(trimmed).hasMatch()) {
+                statements << trigger;
+                trigger.clear();
+            }
+        } else if (triggerStart.match(trimmed).hasMatch()) {
+            trigger = trimmed + ';';
+        } else {
             statements << trimmed + ';';   // 补回 ;
         }
     }
+    if (!trigger.isEmpty()) {
+        statements << trigger;             // 缺少 END，交给 SQLite 报错
+    }
     return statements;
 }
 
@@ -230,7 +624,10 @@ bool SQLiteAdapter::initializeDatabase(const QString& migrationFile) {
     
     QStringList statements = splitSqlStatements(sql);
 
-    beginTransaction();
+    Transaction tx(*this);
+    if (!tx.isActive()) {
+        return false;
+    }
     
     for (const QString& statement : statements) {
         QString trimmed = statement.trimmed();
@@ -241,19 +638,121 @@ bool SQLiteAdapter::initializeDatabase(const QString& migrationFile) {
         
         if (!execute(trimmed)) {
             qWarning() << "Migration failed at statement:" << trimmed;
-            rollback();
             return false;
         }
     }
     
-    if (!commit()) {
+    if (!tx.commit()) {
         return false;
     }
-    
     qDebug() << "Database initialized successfully from:" << migrationFile;
     return true;
 }
 
+#ifdef WORDMASTER_NATIVE_SQLITE
+void SQLiteAdapter::attachNativeHandle() {
+    nativeHandle_ = nullptr;
+    
+    QVariant handle = db_.driver()->handle();
+    if (!handle.isValid() || qstrcmp(handle.typeName(), "sqlite3*") != 0) {
+        qWarning() << "Native SQLite backend unavailable: unexpected driver handle";
+        return;
+    }
+    
+    // Qt 自带的 SQLite 与链接的系统库是两份实现，句柄不能混用
+    QSqlQuery version = db_.exec("SELECT sqlite_version()");
+    if (!version.next() || version.value(0).toString() != QLatin1String(sqlite3_libversion())) {
+        qWarning() << "Native SQLite backend disabled: Qt driver uses SQLite"
+                   << version.value(0).toString() << "but linked library is" << sqlite3_libversion();
+        return;
+    }
+    
+    nativeHandle_ = *static_cast<sqlite3* const*>(handle.constData());
+}
+
+void SQLiteAdapter::finalizeNativeStatements() {
+    // 仍被句柄持有的语句在句柄释放时 finalize
+    nativeStatements_.clear();
+}
+
+bool SQLiteAdapter::evictIdleNativeStatement() {
+    auto oldest = nativeStatements_.end();
+    for (auto it = nativeStatements_.begin(); it != nativeStatements_.end(); ++it) {
+        // 只有缓存持有的语句才能释放，调用方手里的句柄仍指向有效语句
+        if (it->stmt.use_count() > 1) {
+            continue;
+        }
+        if (oldest == nativeStatements_.end() || it->lastUsed < oldest->lastUsed) {
+            oldest = it;
+        }
+    }
+    
+    if (oldest == nativeStatements_.end()) {
+        return false;
+    }
+    nativeStatements_.erase(oldest);
+    return true;
+}
+
+NativeStatement SQLiteAdapter::prepareNative(const QString& sql) {
+    if (!nativeHandle_ || !nativeEnabled_) {
+        return NativeStatement();
+    }
+    
+    auto it = nativeStatements_.find(sql);
+    if (it != nativeStatements_.end()) {
+        it->lastUsed = ++statementClock_;
+        sqlite3_reset(it->stmt.get());
+        sqlite3_clear_bindings(it->stmt.get());
+        return NativeStatement(it->stmt, profiler_.isEnabled());
+    }
+    
+    // 拼接 IN 列表等动态 SQL 会不断产生新文本，超出容量时淘汰最久未使用的语句；
+    // 全部在用时暂时超出容量
+    if (nativeStatements_.size() >= qMax(1, statementCacheCapacity_)) {
+        evictIdleNativeStatement();
+    }
+    
+    sqlite3_stmt* raw = nullptr;
+    int rc = sqlite3_prepare16_v2(nativeHandle_, sql.utf16(),
+                                  sql.size() * int(sizeof(QChar)), &raw, nullptr);
+    if (rc != SQLITE_OK) {
+        qWarning() << "Failed to prepare native statement:"
+                   << sqlite3_errmsg(nativeHandle_) << "\nSQL:" << sql;
+        sqlite3_finalize(raw);
+        return NativeStatement();
+    }
+    
+    CachedNativeStatement entry;
+    entry.stmt = std::shared_ptr<sqlite3_stmt>(raw, sqlite3_finalize);
+    entry.lastUsed = ++statementClock_;
+    nativeStatements_.insert(sql, entry);
+    return NativeStatement(entry.stmt, profiler_.isEnabled());
+}
+
+void SQLiteAdapter::recordNative(const NativeStatement& statement, const QString& sql,
+                                 const QVariantList& boundValues) {
+    if (!profiler_.isEnabled() || !statement.isValid()) {
+        return;
+    }
+    
+    qint64 elapsed = statement.elapsedNs();
+    QVariantList values;
+    if (profiler_.needsBoundValues(sql, elapsed)) {
+        values = boundValues;
+    }
+    recordExecution(sql, values, elapsed, !statement.hasError(), 0, statement.rowsReturned());
+}
+
+bool SQLiteAdapter::isNativeBackendAvailable() const {
+    return nativeHandle_ != nullptr && nativeEnabled_;
+}
+
+void SQLiteAdapter::setNativeBackendEnabled(bool enabled) {
+    nativeEnabled_ = enabled;
+}
+#endif
+
 QSqlDatabase& SQLiteAdapter::getConnection() {
     return db_;
 }
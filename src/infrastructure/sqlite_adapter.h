@@ -2,11 +2,16 @@
 #define WORDMASTER_INFRASTRUCTURE_SQLITE_ADAPTER_H
 
 #include <QString>
+#include <QStringList>
 #include <QSqlDatabase>
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QVariant>
+#include <QHash>
 #include <QDebug>
+#include "infrastructure/storage_profile.h"
+#include "infrastructure/query_profiler.h"
+#include "infrastructure/native_statement.h"
 
 namespace WordMaster {
 namespace Infrastructure {
@@ -19,9 +24,32 @@ namespace Infrastructure {
  * - 提供查询执行接口
  * - 处理事务
  * - 错误处理
+ * - 缓存已编译的预处理语句
  */
 class SQLiteAdapter {
 public:
+    /**
+     * @brief 预处理语句缓存统计
+     */
+    struct StatementCacheStats {
+        quint64 hits;              // 命中次数
+        quint64 misses;            // 未命中次数（需重新编译）
+        quint64 evictions;         // 因容量淘汰的语句数
+        int size;                  // 当前缓存语句数
+        int capacity;              // 缓存容量
+        
+        StatementCacheStats() : hits(0), misses(0), evictions(0),
+                               size(0), capacity(0) {}
+        
+        double hitRate() const {
+            quint64 total = hits + misses;
+            return total > 0 ? static_cast<double>(hits) / total : 0.0;
+        }
+    };
+    
+    // 默认缓存容量（按不同 SQL 文本计）
+    static const int kDefaultStatementCacheCapacity = 64;
+    
     /**
      * @brief 构造函数
      * @param dbPath 数据库文件路径，":memory:" 表示内存数据库
@@ -37,6 +65,49 @@ public:
     SQLiteAdapter(const SQLiteAdapter&) = delete;
     SQLiteAdapter& operator=(const SQLiteAdapter&) = delete;
     
+    /**
+     * @brief 设置只读模式（需在 open() 之前调用）
+     * 
+     * 只读连接以 QSQLITE_OPEN_READONLY 打开，不修改 journal_mode，
+     * 用于 WAL 模式下的并发读连接。
+     */
+    void setReadOnly(bool readOnly);
+    
+    /**
+     * @brief 是否为只读连接
+     */
+    bool isReadOnly() const;
+    
+    /**
+     * @brief 设置存储参数配置（默认 desktop）
+     * 
+     * open() 之前调用时在打开连接时生效（新建数据库的 page_size 在此时确定）；
+     * 连接已打开时立即执行对应的 PRAGMA，page_size 需调用 rebuildWithPageSize()。
+     * 
+     * @return 连接已打开且 PRAGMA 执行失败时返回false
+     */
+    bool setStorageProfile(const StorageProfile& profile);
+    
+    /**
+     * @brief 当前存储参数配置
+     */
+    StorageProfile storageProfile() const;
+    
+    /**
+     * @brief 数据库实际使用的页大小
+     */
+    int pageSize();
+    
+    /**
+     * @brief 按配置的 page_size 重建数据库（VACUUM）
+     * 
+     * WAL 模式下无法修改页大小，重建期间临时切换到 DELETE 日志模式。
+     * 重建需要独占数据库，调用前应关闭其他连接。
+     * 
+     * @return 成功（或页大小已一致）返回true
+     */
+    bool rebuildWithPageSize();
+    
     /**
      * @brief 打开数据库连接
      * @return 成功返回true
@@ -69,26 +140,172 @@ public:
     
     /**
      * @brief 准备SQL语句
+     * 
+     * 相同 SQL 文本的语句只编译一次，之后复位并复用缓存中的语句，
+     * 调用方照常 addBindValue() + exec() 即可重新绑定参数。
+     * 注意：返回的查询与缓存共享，持有期间不要再次 prepare 同一 SQL。
+     * 
      * @param sql 带占位符的SQL语句
      * @return QSqlQuery对象
      */
     QSqlQuery prepare(const QString& sql);
     
+    /**
+     * @brief 执行预处理语句并记录耗时统计
+     * 
+     * 等价于 query.exec()，仓储应通过此方法执行语句，
+     * 以便统计与慢查询日志覆盖所有查询。
+     * 
+     * @param query 已绑定参数的语句（通常来自 prepare()）
+     * @return 成功返回true
+     */
+    bool exec(QSqlQuery& query);
+    
+    /**
+     * @brief 上报从语句读取的行数
+     * 
+     * QSqlQuery 在 exec() 之后逐行读取，仓储读完结果集后调用，
+     * 计入该语句的返回行数统计。
+     * 
+     * @param query 已执行的语句（通常来自 prepare()）
+     * @param rows 读取的行数
+     */
+    void recordRowsReturned(const QSqlQuery& query, int rows);
+    
+#ifdef WORDMASTER_NATIVE_SQLITE
+    /**
+     * @brief 准备原生 sqlite3 语句（热路径读取用）
+     * 
+     * 与 prepare() 一样按 SQL 文本缓存，取出时已复位并清空绑定。
+     * 缓存满时淘汰最久未使用且没有句柄持有的语句。
+     * 
+     * @return 原生后端不可用或编译失败时返回无效句柄，调用方应回退到 prepare()
+     */
+    NativeStatement prepareNative(const QString& sql);
+    
+    /**
+     * @brief 把原生语句的执行计入 profiler() 统计
+     * 
+     * 原生语句不经过 exec()，仓储读完结果集后调用，
+     * 记录累计单步耗时与返回行数（慢查询同样写入日志）。
+     * 
+     * @param statement 已读完的语句
+     * @param sql 语句的 SQL 文本（与 prepareNative() 一致）
+     * @param boundValues 绑定参数
+     */
+    void recordNative(const NativeStatement& statement, const QString& sql,
+                      const QVariantList& boundValues);
+    
+    /**
+     * @brief 原生后端是否可用
+     * 
+     * 需要 Qt 的 QSQLITE 驱动与本程序链接同一份 SQLite（Qt 以 -system-sqlite 构建），
+     * open() 时比较两边的 SQLite 版本，不一致则禁用。
+     */
+    bool isNativeBackendAvailable() const;
+    
+    /**
+     * @brief 运行时开关原生后端（默认开启，用于基准对比）
+     */
+    void setNativeBackendEnabled(bool enabled);
+#endif
+    
+    /**
+     * @brief 获取语句的查询计划（EXPLAIN QUERY PLAN 的 detail 列）
+     * 
+     * 只对 SELECT/INSERT/UPDATE/DELETE 生效，其他语句返回空列表。
+     * 带参数的语句应传入实际参数：LIKE 等优化取决于绑定值。
+     */
+    QStringList explainQueryPlan(const QString& sql,
+                                 const QVariantList& boundValues = QVariantList());
+    
+    /**
+     * @brief SQL 执行统计与慢查询日志
+     */
+    QueryProfiler& profiler();
+    const QueryProfiler& profiler() const;
+    
+    /**
+     * @brief 设置预处理语句缓存容量，0 表示禁用缓存
+     */
+    void setStatementCacheCapacity(int capacity);
+    
+    /**
+     * @brief 清空预处理语句缓存
+     */
+    void clearStatementCache();
+    
+    /**
+     * @brief 获取预处理语句缓存统计
+     */
+    StatementCacheStats statementCacheStats() const;
+    
+    /**
+     * @brief 复位所有缓存语句的游标
+     * 
+     * 未读完的 SELECT 会一直持有读快照，读连接在每个任务结束后调用，
+     * 以便下一个任务能看到写连接已提交的数据。
+     */
+    void resetStatements();
+    
     /**
      * @brief 开始事务
+     * 
+     * 可以嵌套：最外层执行 BEGIN，内层执行 SAVEPOINT。
+     * 每次 beginTransaction() 必须对应一次 commit() 或 rollback()。
      */
     bool beginTransaction();
     
     /**
      * @brief 提交事务
+     * 
+     * 内层释放保存点，只有最外层真正 COMMIT（一次 fsync）。
      */
     bool commit();
     
     /**
      * @brief 回滚事务
+     * 
+     * 内层只回滚到对应保存点，外层事务仍可继续并提交。
      */
     bool rollback();
     
+    /**
+     * @brief 当前事务嵌套深度（0 表示不在事务中）
+     */
+    int transactionDepth() const;
+    
+    /**
+     * @brief 作用域事务
+     * 
+     * 构造时开始（或嵌套为保存点），析构时若未提交则自动回滚：
+     * 
+     *     SQLiteAdapter::Transaction tx(adapter);
+     *     if (!tx.isActive()) return false;
+     *     ...写操作，失败时直接 return false...
+     *     return tx.commit();
+     */
+    class Transaction {
+    public:
+        explicit Transaction(SQLiteAdapter& adapter);
+        ~Transaction();
+        
+        Transaction(const Transaction&) = delete;
+        Transaction& operator=(const Transaction&) = delete;
+        
+        /**
+         * @brief 事务已开始且尚未提交或回滚
+         */
+        bool isActive() const;
+        
+        bool commit();
+        bool rollback();
+        
+    private:
+        SQLiteAdapter& adapter_;
+        bool active_;
+    };
+    
     /**
      * @brief 获取最后插入的行ID
      */
@@ -111,16 +328,72 @@ public:
      */
     bool initializeDatabase(const QString& migrationFile);
     
+    /**
+     * @brief 将SQL脚本拆分为单条语句（去除注释，按分号分割）
+     * 
+     * CREATE TRIGGER 的 BEGIN ... END 体内的分号不拆分（END 需单独作为语句结尾）。
+     * @param sqlContent 脚本内容
+     * @return 语句列表（每条以分号结尾）
+     */
+    static QStringList splitSqlStatements(const QString& sqlContent);
+    
     /**
      * @brief 获取数据库连接（用于直接操作）
      */
     QSqlDatabase& getConnection();
 
 private:
+    struct CachedStatement {
+        QSqlQuery query;
+        quint64 lastUsed;          // LRU 时钟
+    };
+    
+    // 淘汰最久未使用的语句
+    void evictLeastRecentlyUsed();
+    
+    // 执行存储配置中除 page_size 以外的 PRAGMA
+    bool applyStorageProfile();
+    
+    // 直接执行 SQL 文本（execute/query 共用），记录统计
+    QSqlQuery execRaw(const QString& sql);
+    
+    // 记录统计；超过阈值时补充参数与查询计划写入慢查询日志
+    void recordExecution(const QString& sql, const QVariantList& boundValues,
+                         qint64 elapsedNs, bool ok, int rowsAffected, int rowsReturned = 0);
+    
     QString dbPath_;
     QString connectionName_;
     QSqlDatabase db_;
     QSqlQuery lastQuery_;
+    bool readOnly_;
+    StorageProfile profile_;
+    int transactionDepth_;
+    
+    // 预处理语句缓存（按 SQL 文本）
+    QHash<QString, CachedStatement> statementCache_;
+    int statementCacheCapacity_;
+    quint64 statementClock_;
+    StatementCacheStats cacheStats_;
+    
+    QueryProfiler profiler_;
+    
+#ifdef WORDMASTER_NATIVE_SQLITE
+    // 从 Qt 驱动取出底层连接句柄，确认两边使用同一份 SQLite
+    void attachNativeHandle();
+    void finalizeNativeStatements();
+    
+    // 淘汰最久未使用且没有句柄持有的原生语句；全部在用时返回false
+    bool evictIdleNativeStatement();
+    
+    struct CachedNativeStatement {
+        std::shared_ptr<sqlite3_stmt> stmt;     // 释放最后一个引用时 finalize
+        quint64 lastUsed;                       // LRU 时钟（与 statementClock_ 共用）
+    };
+    
+    sqlite3* nativeHandle_;
+    bool nativeEnabled_;
+    QHash<QString, CachedNativeStatement> nativeStatements_;
+#endif
 };
 
 } // namespace Infrastructure
@@ -0,0 +1,72 @@
+#include "storage_profile.h"
+
+namespace WordMaster {
+namespace Infrastructure {
+
+const char* const StorageProfile::kPreferenceKey = "storage_profile";
+
+StorageProfile StorageProfile::desktop() {
+    StorageProfile profile;
+    profile.name = "desktop";
+    profile.mmapSize = 256LL * 1024 * 1024;
+    profile.cacheSizeKiB = 16 * 1024;
+    profile.pageSize = 4096;
+    profile.tempStore = "MEMORY";
+    profile.walAutoCheckpoint = 1000;
+    profile.busyTimeoutMs = 5000;
+    return profile;
+}
+
+StorageProfile StorageProfile::lowMemory() {
+    StorageProfile profile;
+    profile.name = "low-memory";
+    profile.mmapSize = 0;
+    profile.cacheSizeKiB = 2 * 1024;
+    profile.pageSize = 4096;
+    profile.tempStore = "FILE";
+    profile.walAutoCheckpoint = 500;
+    profile.busyTimeoutMs = 5000;
+    return profile;
+}
+
+StorageProfile StorageProfile::bulkImport() {
+    StorageProfile profile;
+    profile.name = "bulk-import";
+    profile.mmapSize = 256LL * 1024 * 1024;
+    profile.cacheSizeKiB = 64 * 1024;
+    profile.pageSize = 8192;
+    profile.tempStore = "MEMORY";
+    profile.walAutoCheckpoint = 10000;
+    profile.busyTimeoutMs = 10000;
+    return profile;
+}
+
+StorageProfile StorageProfile::byName(const QString& name, bool* ok) {
+    QString key = name.trimmed().toLower();
+
+    if (ok) {
+        *ok = true;
+    }
+
+    if (key == "desktop") {
+        return desktop();
+    }
+    if (key == "low-memory") {
+        return lowMemory();
+    }
+    if (key == "bulk-import") {
+        return bulkImport();
+    }
+
+    if (ok) {
+        *ok = false;
+    }
+    return desktop();
+}
+
+QStringList StorageProfile::presetNames() {
+    return QStringList() << "desktop" << "low-memory" << "bulk-import";
+}
+
+} // namespace Infrastructure
+} // namespace WordMaster
@@ -0,0 +1,53 @@
+#ifndef WORDMASTER_INFRASTRUCTURE_STORAGE_PROFILE_H
+#define WORDMASTER_INFRASTRUCTURE_STORAGE_PROFILE_H
+
+#include <QString>
+#include <QStringList>
+
+namespace WordMaster {
+namespace Infrastructure {
+
+/**
+ * @brief SQLite 存储参数配置
+ *
+ * 每个连接打开时按配置执行对应的 PRAGMA。
+ * page_size 只对新建的数据库生效，已有数据库需要通过
+ * SQLiteAdapter::rebuildWithPageSize() (VACUUM) 重建。
+ *
+ * 预设：
+ * - desktop     默认；较大的页缓存与 mmap，临时表放内存
+ * - low-memory  关闭 mmap，页缓存 2MB，临时表落盘
+ * - bulk-import 大页缓存，降低 WAL 检查点频率，适合一次性导入大词库
+ */
+struct StorageProfile {
+    // user_preferences 中保存配置名称的键
+    static const char* const kPreferenceKey;
+
+    QString name;
+    qint64 mmapSize = 0;            // PRAGMA mmap_size（字节，0 为关闭）
+    int cacheSizeKiB = 2000;        // PRAGMA cache_size = -N（KiB）
+    int pageSize = 4096;            // PRAGMA page_size（字节）
+    QString tempStore = "DEFAULT";  // PRAGMA temp_store: DEFAULT / FILE / MEMORY
+    int walAutoCheckpoint = 1000;   // PRAGMA wal_autocheckpoint（页）
+    int busyTimeoutMs = 5000;       // PRAGMA busy_timeout（毫秒）
+
+    static StorageProfile desktop();
+    static StorageProfile lowMemory();
+    static StorageProfile bulkImport();
+
+    /**
+     * @brief 按名称查找预设
+     * @param ok 名称无效时置为false，并返回 desktop 预设
+     */
+    static StorageProfile byName(const QString& name, bool* ok = nullptr);
+
+    /**
+     * @brief 所有预设名称
+     */
+    static QStringList presetNames();
+};
+
+} // namespace Infrastructure
+} // namespace WordMaster
+
+#endif // WORDMASTER_INFRASTRUCTURE_STORAGE_PROFILE_H
@@ -4,6 +4,7 @@
 #include "widgets/review_widget.h"
 #include "widgets/statistics_widget.h"
 #include "widgets/notebook_widget.h"
+#include "widgets/search_widget.h"
 
 #include <QApplication>
 #include <QHBoxLayout>
@@ -15,6 +16,7 @@
 #include <QStandardPaths>
 #include <QDir>
 #include <QStatusBar>
+#include <QTimer>
 
 using namespace WordMaster::Infrastructure;
 using namespace WordMaster::Application;
@@ -22,6 +24,13 @@ using namespace WordMaster::Application;
 namespace WordMaster {
 namespace Presentation {
 
+namespace {
+
+// 界面空闲时每次补建（子表、全文索引）的单词数
+const int kBackfillBatch = 500;
+
+} // namespace
+
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
     , centralWidget_(new QWidget(this))
@@ -37,7 +46,16 @@ MainWindow::MainWindow(QWidget *parent)
     loadInitialData();
 }
 
-MainWindow::~MainWindow() = default;
+MainWindow::~MainWindow() {
+    // 导入任务在写连接上写库，须在仓储销毁前结束（析构时取消并删除未完成的词库）
+    qDeleteAll(findChildren<ImportJob*>(QString(), Qt::FindDirectChildrenOnly));
+    
+    if (cachedWordRepo_) {
+        CachedWordRepository::Stats stats = cachedWordRepo_->stats();
+        qDebug() << "Word cache:" << stats.hits << "hits," << stats.misses << "misses,"
+                 << "hit rate" << stats.hitRate();
+    }
+}
 
 void MainWindow::setupUI() {
     // 主布局：左右分栏
@@ -83,6 +101,7 @@ void MainWindow::setupNavigation() {
     navigationList_->addItem("🔄 复习");
     navigationList_->addItem("📝 我的词本");
     navigationList_->addItem("📊 统计");
+    navigationList_->addItem("🔍 搜索");
     
     navigationList_->setCurrentRow(0);
 }
@@ -90,10 +109,11 @@ void MainWindow::setupNavigation() {
 void MainWindow::setupContentArea() {
     // 创建各个页面
     bookListWidget_ = new BookListWidget(bookService_.get(), this);
-    studyWidget_ = new StudyWidget(studyService_.get(), wordRepo_.get(), tagService_.get(), this);
-    reviewWidget_ = new ReviewWidget(studyService_.get(), wordRepo_.get(), this);
-    notebookWidget_ = new NotebookWidget(tagService_.get(), wordRepo_.get(), this);
+    studyWidget_ = new StudyWidget(studyService_.get(), cachedWordRepo_.get(), tagService_.get(), this);
+    reviewWidget_ = new ReviewWidget(studyService_.get(), cachedWordRepo_.get(), this);
+    notebookWidget_ = new NotebookWidget(tagService_.get(), cachedWordRepo_.get(), this);
     statsWidget_ = new StatisticsWidget(bookService_.get(), recordRepo_.get(), this);
+    searchWidget_ = new SearchWidget(cachedWordRepo_.get(), this);
     
     // 添加到堆栈
     contentStack_->addWidget(bookListWidget_);
@@ -101,6 +121,7 @@ void MainWindow::setupContentArea() {
     contentStack_->addWidget(reviewWidget_);
     contentStack_->addWidget(notebookWidget_);
     contentStack_->addWidget(statsWidget_);
+    contentStack_->addWidget(searchWidget_);
 }
 
 void MainWindow::setupConnections() {
@@ -127,35 +148,91 @@ void MainWindow::initializeDatabase() {
         QStandardPaths::AppDataLocation
     );
     QDir().mkpath(dataPath);
-    QString dbPath = dataPath + "/wordmaster.db";
+    dbPath_ = dataPath + "/wordmaster.db";
     
-    // 创建适配器
-    adapter_ = std::make_unique<SQLiteAdapter>(dbPath);
-    if (!adapter_->open()) {
+    // 创建连接管理器：UI 线程持有写连接，只读查询可分发到读线程
+    connections_ = std::make_unique<ConnectionManager>(dbPath_);
+    if (!connections_->open()) {
         QMessageBox::critical(this, "错误", "无法打开数据库");
         qApp->quit();
         return;
     }
     
-    // 初始化数据库模式
-    QString schemaPath = ":/resources/database/001_initial_schema.sql";
+    SQLiteAdapter& adapter = connections_->writer();
+    
+    // 写连接上超过阈值的语句记入慢查询日志
+    adapter.profiler().setSlowQueryLogFile(dataPath + "/slow_queries.log");
     
-    if (!adapter_->initializeDatabase(schemaPath)) {
-        qWarning() << "Database initialization may have failed";
+    // 执行未应用的结构迁移（已是最新版本时不做任何 DDL）
+    SchemaMigrator migrator(adapter);
+    if (!migrator.migrate().success) {
+        QMessageBox::critical(this, "错误", "数据库结构升级失败");
+        qApp->quit();
+        return;
+    }
+    
+    // 按用户设置切换存储参数（新库使用默认的 desktop 配置创建）
+    UserPreferenceRepository prefRepo(adapter);
+    QString profileName = prefRepo.get(StorageProfile::kPreferenceKey, "desktop");
+    bool validProfile = false;
+    StorageProfile profile = StorageProfile::byName(profileName, &validProfile);
+    if (!validProfile) {
+        qWarning() << "Unknown storage profile:" << profileName;
+    } else if (profile.name != connections_->storageProfile().name) {
+        connections_->setStorageProfile(profile);
     }
     
     // 创建仓储
-    bookRepo_ = std::make_unique<BookRepository>(*adapter_);
-    wordRepo_ = std::make_unique<WordRepository>(*adapter_);
-    recordRepo_ = std::make_unique<StudyRecordRepository>(*adapter_);
-    scheduleRepo_ = std::make_unique<ReviewScheduleRepository>(*adapter_);
-    tagRepo_ = std::make_unique<WordTagRepository>(*adapter_);
+    bookRepo_ = std::make_unique<BookRepository>(adapter);
+    wordRepo_ = std::make_unique<WordRepository>(adapter);
+    cachedWordRepo_ = std::make_unique<CachedWordRepository>(*wordRepo_);
+    recordRepo_ = std::make_unique<StudyRecordRepository>(adapter);
+    scheduleRepo_ = std::make_unique<ReviewScheduleRepository>(adapter);
+    tagRepo_ = std::make_unique<WordTagRepository>(adapter);
+    
+    // 迁移前已有的单词在界面空闲时分批补建结构化子表与全文索引（每批一个短事务）；
+    // 全文索引补建完成前搜索回退为 LIKE
+    if (wordRepo_->structuredBackfillRemaining() > 0 || wordRepo_->searchBackfillRemaining() > 0) {
+        auto* backfillTimer = new QTimer(this);
+        connect(backfillTimer, &QTimer::timeout, this, [this, backfillTimer]() {
+            int remaining = wordRepo_->backfillStructuredFields(kBackfillBatch);
+            QString progress = "正在整理单词数据，剩余 %1 个单词";
+            if (remaining == 0) {
+                remaining = wordRepo_->backfillSearchIndex(kBackfillBatch);
+                progress = "正在建立搜索索引，剩余 %1 个单词";
+            }
+            if (remaining > 0) {
+                statusBar()->showMessage(progress.arg(remaining));
+                return;
+            }
+            if (remaining < 0) {
+                statusBar()->showMessage("整理单词数据失败，部分查询与搜索结果可能不完整", 5000);
+            } else {
+                statusBar()->showMessage("单词数据与搜索索引已建立", 3000);
+            }
+            backfillTimer->stop();
+            backfillTimer->deleteLater();
+        });
+        backfillTimer->start(0);
+    }
     
     // 创建服务
-    bookService_ = std::make_unique<BookService>(*bookRepo_, *wordRepo_);
+    bookService_ = std::make_unique<BookService>(*bookRepo_, *cachedWordRepo_);
     scheduler_ = std::make_unique<SM2Scheduler>(*scheduleRepo_);
-    studyService_ = std::make_unique<StudyService>(*wordRepo_, *recordRepo_, *scheduler_);
+    studyService_ = std::make_unique<StudyService>(*cachedWordRepo_, *recordRepo_, *scheduler_);
     tagService_ = std::make_unique<TagService>(*tagRepo_);
+    
+    // 答题结果写后批量提交：每 20 条或 2 秒一个事务
+    studyService_->enableWriteBehind(20, 2000);
+    
+    // 单词卡片在读线程上预取；读连接上的仓储只在任务内使用
+    ConnectionManager* connections = connections_.get();
+    studyService_->enablePrefetch([connections](const StudyService::ReadTask& task) {
+        connections->submitRead([task](SQLiteAdapter& reader) {
+            WordRepository words(reader);
+            task(words);
+        });
+    });
 }
 
 void MainWindow::loadInitialData() {
@@ -169,6 +246,9 @@ void MainWindow::loadInitialData() {
 void MainWindow::onNavigationClicked(int index) {
     contentStack_->setCurrentIndex(index);
     
+    // 其他页面直接读库，切换前提交排队中的答题结果
+    studyService_->flushPendingWrites();
+    
     // 刷新页面数据
     switch (index) {
         case 0: // 词库管理
@@ -194,6 +274,9 @@ void MainWindow::onNavigationClicked(int index) {
         case 3: // 统计
             statsWidget_->refresh();
             break;
+        case 5: // 搜索
+            searchWidget_->setBookId(currentBookId_);
+            break;
     }
 }
 
@@ -218,23 +301,28 @@ void MainWindow::onImportBooks() {
         return;
     }
     
-    // 导入
-    auto result = bookService_->importBooksFromMeta(fileName);
-    
-    if (result.success) {
-        QMessageBox::information(
-            this,
-            "导入成功",
-            QString("成功导入 %1 个词库，共 %2 个单词")
-                .arg(result.importedBooks)
-                .arg(result.importedWords)
-        );
-        
-        // 刷新列表
-        bookListWidget_->refresh();
-    } else {
-        QMessageBox::warning(this, "导入失败", result.message);
+    // 读取和解析在后台线程进行，写入逐批回到本线程的写连接；界面可以继续学习其他词库
+    ImportJob* job = bookService_->createImportJob(fileName, this);
+    if (!job) {
+        QMessageBox::information(this, "导入", "没有需要导入的新词库");
+        return;
     }
+    
+    connect(job, &ImportJob::finished, this,
+            [this, job](bool success, bool cancelled, const QString& message) {
+        if (success) {
+            QMessageBox::information(this, "导入成功", message);
+        } else if (cancelled) {
+            statusBar()->showMessage(message, 5000);
+        } else {
+            QMessageBox::warning(this, "导入失败", message);
+        }
+        job->deleteLater();
+    });
+    
+    bookListWidget_->attachImportJob(job);
+    contentStack_->setCurrentIndex(0);
+    job->start();
 }
 
 void MainWindow::onStartStudy() {
@@ -11,11 +11,15 @@
 #include "application/services/sm2_scheduler.h"
 #include "application/services/tag_service.h"
 #include "infrastructure/sqlite_adapter.h"
+#include "infrastructure/connection_manager.h"
+#include "infrastructure/schema_migrator.h"
 #include "infrastructure/repositories/book_repository.h"
 #include "infrastructure/repositories/word_repository.h"
+#include "infrastructure/repositories/cached_word_repository.h"
 #include "infrastructure/repositories/word_tag_repository.h"
 #include "infrastructure/repositories/study_record_repository.h"
 #include "infrastructure/repositories/review_schedule_repository.h"
+#include "infrastructure/repositories/user_preference_repository.h"
 
 namespace WordMaster {
 namespace Presentation {
@@ -26,6 +30,7 @@ class StudyWidget;
 class ReviewWidget;
 class StatisticsWidget;
 class NotebookWidget;
+class SearchWidget;
 
 /**
  * @brief 主窗口
@@ -65,11 +70,13 @@ private:
     ReviewWidget* reviewWidget_;
     StatisticsWidget* statsWidget_;
     NotebookWidget* notebookWidget_;
+    SearchWidget* searchWidget_;
     
     // 数据库和服务
-    std::unique_ptr<Infrastructure::SQLiteAdapter> adapter_;
+    std::unique_ptr<Infrastructure::ConnectionManager> connections_;
     std::unique_ptr<Infrastructure::BookRepository> bookRepo_;
     std::unique_ptr<Infrastructure::WordRepository> wordRepo_;
+    std::unique_ptr<Infrastructure::CachedWordRepository> cachedWordRepo_;  // 服务与界面使用
     std::unique_ptr<Infrastructure::StudyRecordRepository> recordRepo_;
     std::unique_ptr<Infrastructure::ReviewScheduleRepository> scheduleRepo_;
     std::unique_ptr<Infrastructure::WordTagRepository> tagRepo_;
@@ -80,6 +87,7 @@ private:
     std::unique_ptr<Application::TagService> tagService_;
     
     // 状态
+    QString dbPath_;
     QString currentBookId_;
 };
 
@@ -4,6 +4,7 @@
 #include <QGroupBox>
 #include <QProgressBar>
 #include <QMessageBox>
+#include <QDebug>
 
 namespace WordMaster {
 namespace Presentation {
@@ -16,6 +17,10 @@ BookListWidget::BookListWidget(Application::BookService* service,
     , importButton_(new QPushButton("导入词库", this))
     , refreshButton_(new QPushButton("刷新", this))
     , titleLabel_(new QLabel("词库管理", this))
+    , importPanel_(new QWidget(this))
+    , importLabel_(new QLabel(importPanel_))
+    , importProgress_(new QProgressBar(importPanel_))
+    , cancelImportButton_(new QPushButton("取消导入", importPanel_))
 {
     setupUI();
     loadBooks();
@@ -34,6 +39,17 @@ void BookListWidget::setupUI() {
     
     mainLayout->addLayout(headerLayout);
     
+    // 导入进度（导入时显示）
+    auto* importLayout = new QHBoxLayout(importPanel_);
+    importLayout->setContentsMargins(0, 0, 0, 0);
+    importLabel_->setStyleSheet("color: #666; font-size: 14px;");
+    importLayout->addWidget(importLabel_, 1);
+    importLayout->addWidget(importProgress_, 1);
+    importLayout->addWidget(cancelImportButton_);
+    importPanel_->hide();
+    
+    mainLayout->addWidget(importPanel_);
+    
     // 词库列表
     bookList_->setStyleSheet(R"(
         QListWidget {
@@ -67,6 +83,8 @@ void BookListWidget::setupUI() {
             this, &BookListWidget::onImportClicked);
     connect(refreshButton_, &QPushButton::clicked,
             this, &BookListWidget::refresh);
+    connect(cancelImportButton_, &QPushButton::clicked,
+            this, &BookListWidget::onCancelImportClicked);
 }
 
 void BookListWidget::loadBooks() {
@@ -211,6 +229,86 @@ void BookListWidget::refresh() {
     loadBooks();
 }
 
+void BookListWidget::attachImportJob(Application::ImportJob* job) {
+    importJob_ = job;
+    
+    connect(job, &Application::ImportJob::bookStarted,
+            this, &BookListWidget::onImportBookStarted);
+    connect(job, &Application::ImportJob::progress,
+            this, &BookListWidget::onImportProgress);
+    connect(job, &Application::ImportJob::bookFinished,
+            this, &BookListWidget::onImportBookFinished);
+    connect(job, &Application::ImportJob::finished,
+            this, &BookListWidget::onImportFinished);
+    
+    importButton_->setEnabled(false);
+    cancelImportButton_->setEnabled(true);
+    importLabel_->setText("准备导入...");
+    importProgress_->setRange(0, 0);
+    importPanel_->show();
+}
+
+void BookListWidget::onImportBookStarted(const QString& bookId, const QString& bookName,
+                                         int index, int count) {
+    Q_UNUSED(bookId);
+    importBookTitle_ = QString("%1 (%2/%3)").arg(bookName).arg(index + 1).arg(count);
+    importLabel_->setText(QString("正在导入 %1").arg(importBookTitle_));
+    importProgress_->setRange(0, 0);
+}
+
+void BookListWidget::onImportProgress(const QString& bookId, int written, int total,
+                                      double wordsPerSecond, qint64 etaMs) {
+    Q_UNUSED(bookId);
+    
+    // 元数据中的单词数只是估计，实际可能更多
+    if (total > 0) {
+        importProgress_->setRange(0, total);
+        importProgress_->setValue(qMin(written, total));
+    }
+    
+    QString text = QString("正在导入 %1：%2 词，%3 词/秒")
+        .arg(importBookTitle_)
+        .arg(written)
+        .arg(static_cast<qint64>(wordsPerSecond));
+    if (etaMs >= 0) {
+        text += QString("，剩余约 %1 秒").arg((etaMs + 999) / 1000);
+    }
+    importLabel_->setText(text);
+}
+
+void BookListWidget::onImportBookFinished(const QString& bookId, bool success,
+                                          int importedWords, const QString& error) {
+    Q_UNUSED(importedWords);
+    
+    if (success) {
+        // 导入完成的词库立即可以学习
+        loadBooks();
+    } else {
+        qWarning() << "Import failed for book" << bookId << ":" << error;
+    }
+}
+
+void BookListWidget::onImportFinished(bool success, bool cancelled, const QString& message) {
+    Q_UNUSED(success);
+    Q_UNUSED(cancelled);
+    
+    importJob_.clear();
+    importPanel_->hide();
+    importButton_->setEnabled(true);
+    importBookTitle_.clear();
+    
+    qDebug() << "Import finished:" << message;
+    loadBooks();
+}
+
+void BookListWidget::onCancelImportClicked() {
+    if (importJob_) {
+        importJob_->cancel();
+        cancelImportButton_->setEnabled(false);
+        importLabel_->setText("正在取消，当前词库将被删除...");
+    }
+}
+
 void BookListWidget::onBookItemClicked(QListWidgetItem* item) {
     QString bookId = item->data(Qt::UserRole).toString();
     if (!bookId.isEmpty()) {
@@ -5,6 +5,8 @@
 #include <QListWidget>
 #include <QPushButton>
 #include <QLabel>
+#include <QProgressBar>
+#include <QPointer>
 #include "application/services/book_service.h"
 
 namespace WordMaster {
@@ -21,6 +23,11 @@ public:
                            QWidget* parent = nullptr);
 
     void refresh();
+    
+    /**
+     * @brief 显示后台导入任务的进度（任务结束前禁用导入按钮）
+     */
+    void attachImportJob(Application::ImportJob* job);
 
 signals:
     void bookSelected(const QString& bookId);
@@ -32,6 +39,14 @@ private slots:
     void onImportClicked();
     void onStudyClicked();
     void onDeleteClicked();
+    void onImportBookStarted(const QString& bookId, const QString& bookName,
+                             int index, int count);
+    void onImportProgress(const QString& bookId, int written, int total,
+                          double wordsPerSecond, qint64 etaMs);
+    void onImportBookFinished(const QString& bookId, bool success,
+                              int importedWords, const QString& error);
+    void onImportFinished(bool success, bool cancelled, const QString& message);
+    void onCancelImportClicked();
 
 private:
     void setupUI();
@@ -47,6 +62,14 @@ private:
     QPushButton* refreshButton_;
     QLabel* titleLabel_;
     
+    // 导入进度
+    QWidget* importPanel_;
+    QLabel* importLabel_;
+    QProgressBar* importProgress_;
+    QPushButton* cancelImportButton_;
+    QPointer<Application::ImportJob> importJob_;
+    QString importBookTitle_;   // 如 "CET-4 (1/3)"
+    
     QString selectedBookId_;
 };
 
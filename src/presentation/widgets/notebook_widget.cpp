@@ -74,10 +74,11 @@ void NotebookWidget::loadWords(const QString& tagType, QListWidget* list) {
         return;
     }
     
-    auto words = wordRepo_->getByIds(wordIds);
+    // 列表只显示单词和音标，不读取释义等 JSON 字段
+    auto words = wordRepo_->getByIds(wordIds, Domain::WordProjection::Summary);
     
     for (const auto& word : words) {
-        QString text = QString("%1  %2").arg(word.word, word.phoneticUk);
+        QString text = QString("%1  %2  %3").arg(word.word, word.phoneticUk, word.gloss);
         list->addItem(text);
     }
 }
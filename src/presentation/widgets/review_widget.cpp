@@ -6,9 +6,6 @@
 #include <QTextEdit>
 #include <QProgressBar>
 #include <QMessageBox>
-#include <QJsonDocument>
-#include <QJsonArray>
-#include <QJsonObject>
 #include <QTime>
 
 namespace WordMaster {
@@ -251,19 +248,19 @@ void ReviewWidget::loadCurrentWord() {
         return;
     }
     
-    currentWord_ = service_->getCurrentWord(session_);
+    currentCard_ = service_->getCurrentCard(session_);
     
-    if (currentWord_.word.isEmpty()) {
+    if (currentCard_.word.word.isEmpty()) {
         QMessageBox::warning(this, "错误", "加载单词失败");
         return;
     }
     
     resetCard();
-    wordLabel_->setText(currentWord_.word);
+    wordLabel_->setText(currentCard_.word.word);
     
-    QString phonetic = currentWord_.phoneticUk;
-    if (!currentWord_.phoneticUs.isEmpty()) {
-        phonetic += " / " + currentWord_.phoneticUs;
+    QString phonetic = currentCard_.word.phoneticUk;
+    if (!currentCard_.word.phoneticUs.isEmpty()) {
+        phonetic += " / " + currentCard_.word.phoneticUs;
     }
     phoneticLabel_->setText(phonetic);
     
@@ -286,20 +283,14 @@ void ReviewWidget::onShowTranslation() {
     
     translationVisible_ = true;
     
-    // 解析显示释义（与学习界面相同）
+    // 显示释义（与学习界面相同，随卡片预取）
     QString content;
     
-    QJsonDocument transDoc = QJsonDocument::fromJson(currentWord_.translations.toUtf8());
-    if (transDoc.isArray()) {
-        QJsonArray transArray = transDoc.array();
-        content += "<h3>释义：</h3><ul>";
-        for (const QJsonValue& val : transArray) {
-            QJsonObject obj = val.toObject();
-            content += QString("<li><b>%1</b> %2</li>")
-                .arg(obj["pos"].toString(), obj["cn"].toString());
-        }
-        content += "</ul>";
+    content += "<h3>释义：</h3><ul>";
+    for (const Domain::WordTranslation& item : currentCard_.translations) {
+        content += QString("<li><b>%1</b> %2</li>").arg(item.pos, item.meaning);
     }
+    content += "</ul>";
     
     translationText_->setHtml(content);
     translationText_->setVisible(true);
@@ -316,7 +307,7 @@ void ReviewWidget::onShowTranslation() {
 
 void ReviewWidget::recordResult(bool known, int duration) {
     Application::StudyService::StudyResult result;
-    result.wordId = currentWord_.id;
+    result.wordId = currentCard_.word.id;
     result.bookId = bookId_;
     result.known = known;
     result.duration = duration;
@@ -50,7 +50,7 @@ private:
     
     QString bookId_;
     Application::StudyService::StudySession session_;
-    Domain::Word currentWord_;
+    Application::StudyService::WordCard currentCard_;
     QTime wordStartTime_;
     bool translationVisible_;
     
@@ -0,0 +1,122 @@
+#include "search_widget.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QElapsedTimer>
+
+namespace WordMaster {
+namespace Presentation {
+
+namespace {
+
+// 输入停顿多久后搜索（毫秒）
+const int kSearchDelayMs = 200;
+
+} // namespace
+
+SearchWidget::SearchWidget(Domain::IWordRepository* wordRepo,
+                           QWidget* parent)
+    : QWidget(parent)
+    , wordRepo_(wordRepo)
+{
+    setupUI();
+}
+
+void SearchWidget::setupUI() {
+    auto* layout = new QVBoxLayout(this);
+
+    auto* titleLabel = new QLabel("搜索", this);
+    titleLabel->setStyleSheet("font-size: 24px; font-weight: bold; color: #2c3e50;");
+    layout->addWidget(titleLabel);
+
+    auto* inputLayout = new QHBoxLayout();
+    searchEdit_ = new QLineEdit(this);
+    searchEdit_->setPlaceholderText("输入单词、中文释义或例句中的词语");
+    searchEdit_->setClearButtonEnabled(true);
+    searchEdit_->setStyleSheet("padding: 8px; font-size: 16px;");
+    inputLayout->addWidget(searchEdit_);
+
+    currentBookCheck_ = new QCheckBox("仅当前词库", this);
+    currentBookCheck_->setEnabled(false);
+    inputLayout->addWidget(currentBookCheck_);
+    layout->addLayout(inputLayout);
+
+    summaryLabel_ = new QLabel(this);
+    summaryLabel_->setStyleSheet("color: #7f8c8d;");
+    layout->addWidget(summaryLabel_);
+
+    resultList_ = new QListWidget(this);
+    resultList_->setStyleSheet(R"(
+        QListWidget {
+            border: 1px solid #ddd;
+            background-color: #f8f9fa;
+        }
+        QListWidget::item {
+            border-bottom: 1px solid #e9ecef;
+            background-color: white;
+            margin: 5px;
+            border-radius: 5px;
+        }
+    )");
+    layout->addWidget(resultList_);
+
+    debounceTimer_ = new QTimer(this);
+    debounceTimer_->setSingleShot(true);
+    debounceTimer_->setInterval(kSearchDelayMs);
+
+    connect(searchEdit_, &QLineEdit::textChanged, debounceTimer_,
+            static_cast<void (QTimer::*)()>(&QTimer::start));
+    connect(searchEdit_, &QLineEdit::returnPressed, this, &SearchWidget::search);
+    connect(debounceTimer_, &QTimer::timeout, this, &SearchWidget::search);
+    connect(currentBookCheck_, &QCheckBox::toggled, this, &SearchWidget::search);
+}
+
+void SearchWidget::setBookId(const QString& bookId) {
+    bookId_ = bookId;
+    currentBookCheck_->setEnabled(!bookId_.isEmpty());
+    if (bookId_.isEmpty()) {
+        currentBookCheck_->setChecked(false);
+    }
+    searchEdit_->setFocus();
+}
+
+void SearchWidget::search() {
+    debounceTimer_->stop();
+    resultList_->clear();
+
+    QString text = searchEdit_->text().trimmed();
+    if (text.isEmpty()) {
+        summaryLabel_->clear();
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    QString bookId = currentBookCheck_->isChecked() ? bookId_ : QString();
+    QList<Domain::WordSearchHit> hits = wordRepo_->search(text, bookId);
+
+    summaryLabel_->setText(QString("找到 %1 个单词，耗时 %2 ms")
+                               .arg(hits.size()).arg(timer.elapsed()));
+
+    for (const auto& hit : hits) {
+        // 先转义再替换命中标记，词库内容不会被当作 HTML
+        QString snippet = Domain::WordSearchHit::highlight(
+            hit.snippet.toHtmlEscaped(), "<b style='color:#e74c3c;'>", "</b>");
+        QString html = QString(
+            "<span style='font-size:16px; font-weight:bold;'>%1</span>"
+            "&nbsp;&nbsp;<span style='color:#7f8c8d;'>%2</span>"
+            "&nbsp;&nbsp;%3<br><span style='color:#34495e;'>%4</span>")
+            .arg(hit.word.word.toHtmlEscaped(), hit.word.phoneticUk.toHtmlEscaped(),
+                 hit.word.gloss.toHtmlEscaped(), snippet);
+
+        auto* label = new QLabel(html);
+        label->setTextFormat(Qt::RichText);
+        label->setContentsMargins(10, 8, 10, 8);
+
+        auto* item = new QListWidgetItem(resultList_);
+        item->setSizeHint(label->sizeHint());
+        resultList_->setItemWidget(item, label);
+    }
+}
+
+} // namespace Presentation
+} // namespace WordMaster
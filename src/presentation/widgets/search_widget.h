@@ -0,0 +1,49 @@
+#ifndef WORDMASTER_PRESENTATION_SEARCH_WIDGET_H
+#define WORDMASTER_PRESENTATION_SEARCH_WIDGET_H
+
+#include <QWidget>
+#include <QLineEdit>
+#include <QCheckBox>
+#include <QLabel>
+#include <QListWidget>
+#include <QTimer>
+#include "domain/repositories.h"
+
+namespace WordMaster {
+namespace Presentation {
+
+/**
+ * @brief 搜索页面
+ *
+ * 全文搜索单词、释义、例句与短语，输入停顿后自动搜索，结果中高亮命中词。
+ */
+class SearchWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit SearchWidget(Domain::IWordRepository* wordRepo,
+                          QWidget* parent = nullptr);
+
+    // 当前词库（"仅当前词库" 勾选时按此过滤）
+    void setBookId(const QString& bookId);
+
+private slots:
+    void search();
+
+private:
+    void setupUI();
+
+    Domain::IWordRepository* wordRepo_;
+    QString bookId_;
+
+    QLineEdit* searchEdit_;
+    QCheckBox* currentBookCheck_;
+    QLabel* summaryLabel_;
+    QListWidget* resultList_;
+    QTimer* debounceTimer_;
+};
+
+} // namespace Presentation
+} // namespace WordMaster
+
+#endif
@@ -2,9 +2,6 @@
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QMessageBox>
-#include <QJsonDocument>
-#include <QJsonArray>
-#include <QJsonObject>
 #include <QTime>
 
 namespace WordMaster {
@@ -239,9 +236,9 @@ void StudyWidget::loadCurrentWord() {
     }
     
     // 加载当前单词
-    currentWord_ = service_->getCurrentWord(session_);
+    currentCard_ = service_->getCurrentCard(session_);
     
-    if (currentWord_.word.isEmpty()) {
+    if (currentCard_.word.word.isEmpty()) {
         QMessageBox::warning(this, "错误", "加载单词失败");
         return;
     }
@@ -250,12 +247,12 @@ void StudyWidget::loadCurrentWord() {
     resetCard();
     
     // 显示单词
-    wordLabel_->setText(currentWord_.word);
+    wordLabel_->setText(currentCard_.word.word);
     
     // 显示音标
-    QString phonetic = currentWord_.phoneticUk;
-    if (!currentWord_.phoneticUs.isEmpty()) {
-        phonetic += " / " + currentWord_.phoneticUs;
+    QString phonetic = currentCard_.word.phoneticUk;
+    if (!currentCard_.word.phoneticUs.isEmpty()) {
+        phonetic += " / " + currentCard_.word.phoneticUs;
     }
     phoneticLabel_->setText(phonetic);
     
@@ -281,35 +278,21 @@ void StudyWidget::onShowTranslation() {
     
     translationVisible_ = true;
     
-    // 解析并显示释义
+    // 释义与例句随卡片预取，不再访问数据库
     QString content;
     
     // 释义
-    QJsonDocument transDoc = QJsonDocument::fromJson(currentWord_.translations.toUtf8());
-    if (transDoc.isArray()) {
-        QJsonArray transArray = transDoc.array();
-        content += "<h3>释义：</h3><ul>";
-        for (const QJsonValue& val : transArray) {
-            QJsonObject obj = val.toObject();
-            QString pos = obj["pos"].toString();
-            QString cn = obj["cn"].toString();
-            content += QString("<li><b>%1</b> %2</li>").arg(pos, cn);
-        }
-        content += "</ul>";
+    content += "<h3>释义：</h3><ul>";
+    for (const Domain::WordTranslation& item : currentCard_.translations) {
+        content += QString("<li><b>%1</b> %2</li>").arg(item.pos, item.meaning);
     }
+    content += "</ul>";
     
     // 例句
-    QJsonDocument sentDoc = QJsonDocument::fromJson(currentWord_.sentences.toUtf8());
-    if (sentDoc.isArray()) {
-        QJsonArray sentArray = sentDoc.array();
-        if (!sentArray.isEmpty()) {
-            content += "<h3>例句：</h3>";
-            for (const QJsonValue& val : sentArray) {
-                QJsonObject obj = val.toObject();
-                QString en = obj["c"].toString();
-                QString cn = obj["cn"].toString();
-                content += QString("<p><i>%1</i><br/>%2</p>").arg(en, cn);
-            }
+    if (!currentCard_.sentences.isEmpty()) {
+        content += "<h3>例句：</h3>";
+        for (const Domain::WordSentence& item : currentCard_.sentences) {
+            content += QString("<p><i>%1</i><br/>%2</p>").arg(item.english, item.chinese);
         }
     }
     
@@ -330,7 +313,7 @@ void StudyWidget::onKnown() {
     
     // 记录结果
     Application::StudyService::StudyResult result;
-    result.wordId = currentWord_.id;
+    result.wordId = currentCard_.word.id;
     result.bookId = bookId_;
     result.known = true;
     result.duration = duration;
@@ -348,7 +331,7 @@ void StudyWidget::onUnknown() {
     
     // 记录结果
     Application::StudyService::StudyResult result;
-    result.wordId = currentWord_.id;
+    result.wordId = currentCard_.word.id;
     result.bookId = bookId_;
     result.known = false;
     result.duration = duration;
@@ -369,14 +352,14 @@ void StudyWidget::onNext() {
 }
 
 void StudyWidget::onToggleDifficult() {
-    if (currentWord_.id > 0) {
-        tagService_->toggleTag(currentWord_.id, Domain::WordTag::TAG_DIFFICULT);
+    if (currentCard_.word.id > 0) {
+        tagService_->toggleTag(currentCard_.word.id, Domain::WordTag::TAG_DIFFICULT);
     }
 }
 
 void StudyWidget::onToggleFavorite() {
-    if (currentWord_.id > 0) {
-        tagService_->toggleTag(currentWord_.id, Domain::WordTag::TAG_FAVORITE);
+    if (currentCard_.word.id > 0) {
+        tagService_->toggleTag(currentCard_.word.id, Domain::WordTag::TAG_FAVORITE);
     }
 }
 
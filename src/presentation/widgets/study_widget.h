@@ -56,7 +56,7 @@ private:
     // 当前状态
     QString bookId_;
     Application::StudyService::StudySession session_;
-    Domain::Word currentWord_;
+    Application::StudyService::WordCard currentCard_;
     QTime wordStartTime_;
     bool translationVisible_;
     
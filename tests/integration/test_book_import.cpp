@@ -1,10 +1,13 @@
 #include <gtest/gtest.h>
 #include "application/services/book_service.h"
+#include "application/services/import_pipeline.h"
+#include "application/services/delta_importer.h"
 #include "infrastructure/repositories/book_repository.h"
 #include "infrastructure/repositories/word_repository.h"
 #include "tests/test_helpers.h"
 #include <QFile>
 #include <QDir>
+#include <QTemporaryDir>
 
 using namespace WordMaster::Application;
 using namespace WordMaster::Domain;
@@ -304,6 +307,262 @@ TEST_F(BookImportIntegrationTest, BatchOperationTransactional) {
     EXPECT_EQ(words.size(), originalCount);
 }
 
+// ============================================
+// 测试：流水线并行导入，批次按序写入，失败词库不留数据
+// ============================================
+TEST_F(BookImportIntegrationTest, PipelineImportsBooksInParallel) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    
+    auto writeBook = [&](const QString& bookId, const QByteArray& json) {
+        QFile file(dir.filePath(bookId + ".json"));
+        EXPECT_TRUE(file.open(QIODevice::WriteOnly));
+        file.write(json);
+        
+        ImportPipeline::Source source;
+        source.book.id = bookId;
+        source.book.name = bookId;
+        source.book.url = bookId + ".json";
+        source.jsonPath = file.fileName();
+        return source;
+    };
+    
+    auto bookJson = [](const QString& bookId, int count) {
+        QStringList items;
+        for (int i = 1; i <= count; ++i) {
+            items << QString(R"({"id":%1,"word":"%2-%1","trans":[]})").arg(i).arg(bookId);
+        }
+        // 重复的 id 出现在最后，按顺序写入时以它为准
+        items << QString(R"({"id":5,"word":"%1-dup"})").arg(bookId);
+        return ("[" + items.join(",") + "]").toUtf8();
+    };
+    
+    QList<ImportPipeline::Source> sources;
+    sources << writeBook("p1", bookJson("p1", 60))
+            << writeBook("bad", "[{\"id\":1,\"word\":\"a\"},{\"id\":2,")
+            << writeBook("p2", bookJson("p2", 60));
+    
+    ImportPipeline::Options options;
+    options.readerThreads = 2;
+    options.parserThreads = 3;
+    options.batchSize = 4;
+    options.maxInFlightBatches = 2;
+    
+    ImportPipeline pipeline(*bookRepo, *wordRepo, options);
+    auto result = pipeline.run(sources);
+    
+    ASSERT_TRUE(result.success);
+    EXPECT_EQ(result.importedBooks, 2);
+    EXPECT_EQ(result.importedWords, 122);
+    ASSERT_EQ(result.books.size(), 3);
+    EXPECT_TRUE(result.books[0].success);
+    EXPECT_FALSE(result.books[1].success);
+    EXPECT_FALSE(result.books[1].error.isEmpty());
+    
+    for (const QString& bookId : QStringList() << "p1" << "p2") {
+        QList<Word> words = wordRepo->getByBookId(bookId);
+        ASSERT_EQ(words.size(), 60);
+        EXPECT_EQ(words[4].word, bookId + "-dup");
+    }
+    
+    EXPECT_TRUE(bookRepo->getById("bad").id.isEmpty());
+    EXPECT_TRUE(wordRepo->getByBookId("bad").isEmpty());
+}
+
+// ============================================
+// 测试：进度回调取消导入，整体回滚
+// ============================================
+TEST_F(BookImportIntegrationTest, PipelineProgressCanCancel) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    QStringList items;
+    for (int i = 1; i <= 20; ++i) {
+        items << QString(R"({"id":%1,"word":"w%1"})").arg(i);
+    }
+    QFile file(dir.filePath("c1.json"));
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write(("[" + items.join(",") + "]").toUtf8());
+    file.close();
+
+    ImportPipeline::Source source;
+    source.book.id = "c1";
+    source.book.name = "c1";
+    source.book.url = "c1.json";
+    source.jsonPath = file.fileName();
+
+    ImportPipeline::Options options;
+    options.batchSize = 5;
+
+    ImportPipeline pipeline(*bookRepo, *wordRepo, options);
+    QList<int> reported;
+    pipeline.setProgressHandler([&reported](const ImportPipeline::Progress& progress) {
+        reported.append(progress.bookWords);
+        return reported.size() < 2;
+    });
+
+    auto result = pipeline.run(QList<ImportPipeline::Source>() << source);
+
+    EXPECT_FALSE(result.success);
+    EXPECT_TRUE(result.cancelled);
+    EXPECT_EQ(reported, QList<int>() << 5 << 10);
+    EXPECT_FALSE(bookRepo->exists("c1"));
+    EXPECT_TRUE(wordRepo->getByBookId("c1").isEmpty());
+}
+
+// ============================================
+// 测试：提交失败时回滚，连接不会停留在未结束的事务中
+// ============================================
+TEST_F(BookImportIntegrationTest, PipelineRollsBackFailedCommit) {
+    // 延迟外键在 COMMIT 时才检查，使提交失败而事务保持打开
+    ASSERT_TRUE(adapter->execute(
+        "CREATE TABLE import_guard ("
+        "word_id INTEGER REFERENCES words(id) DEFERRABLE INITIALLY DEFERRED)"));
+    ASSERT_TRUE(adapter->execute(
+        "CREATE TRIGGER fail_commit AFTER INSERT ON words "
+        "BEGIN INSERT INTO import_guard VALUES (-1); END"));
+
+    ImportPipeline::Source source;
+    source.book.id = "test_cet4";
+    source.book.name = "Test CET-4";
+    source.book.url = "test_cet4_words.json";
+    source.jsonPath = wordsJsonPath;
+
+    ImportPipeline pipeline(*bookRepo, *wordRepo);
+    auto result = pipeline.run(QList<ImportPipeline::Source>() << source);
+
+    EXPECT_FALSE(result.success);
+    EXPECT_EQ(result.importedWords, 0);
+    EXPECT_EQ(adapter->transactionDepth(), 0);
+    EXPECT_FALSE(bookRepo->exists("test_cet4"));
+}
+
+// ============================================
+// 测试：增量更新只写变化的单词，id 与复习计划保留
+// ============================================
+TEST_F(BookImportIntegrationTest, DeltaImportPreservesWordIds) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    auto writeJson = [&](const QByteArray& json) {
+        QFile file(dir.filePath("d1.json"));
+        EXPECT_TRUE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        file.write(json);
+        return file.fileName();
+    };
+
+    ImportPipeline::Source source;
+    source.book.id = "d1";
+    source.book.name = "d1";
+    source.book.url = "d1.json";
+    source.jsonPath = writeJson(R"([
+        {"id":1,"word":"keep","trans":[{"cn":"保留"}]},
+        {"id":2,"word":"change","trans":[{"cn":"旧"}]},
+        {"id":3,"word":"drop","trans":[]}
+    ])");
+
+    ImportPipeline pipeline(*bookRepo, *wordRepo);
+    ASSERT_TRUE(pipeline.run(QList<ImportPipeline::Source>() << source).success);
+
+    Word changed = wordRepo->getByBookAndWord("d1", "change");
+    ASSERT_GT(changed.id, 0);
+    ASSERT_TRUE(adapter->execute(QString(
+        "INSERT INTO review_schedule (word_id, book_id, next_review_date) "
+        "VALUES (%1, 'd1', DATE('now'))").arg(changed.id)));
+
+    // Act - 修改 2，删除 3，新增 4
+    writeJson(R"([
+        {"id":1,"word":"keep","trans":[{"cn":"保留"}]},
+        {"id":2,"word":"change","trans":[{"cn":"新"}]},
+        {"id":4,"word":"add"}
+    ])");
+
+    DeltaImporter importer(*bookRepo, *wordRepo);
+    DeltaImporter::Summary summary = importer.apply(source.book, source.jsonPath);
+
+    // Assert
+    ASSERT_TRUE(summary.success) << qPrintable(summary.error);
+    EXPECT_EQ(summary.inserted, 1);
+    EXPECT_EQ(summary.updated, 1);
+    EXPECT_EQ(summary.deleted, 1);
+    EXPECT_EQ(summary.unchanged, 1);
+
+    Word updated = wordRepo->getById(changed.id);
+    EXPECT_EQ(updated.wordId, 2);
+    EXPECT_TRUE(updated.translations.contains(QString::fromUtf8("新")));
+    EXPECT_TRUE(wordRepo->getByBookAndWord("d1", "drop").word.isEmpty());
+    EXPECT_FALSE(wordRepo->getByBookAndWord("d1", "add").word.isEmpty());
+
+    auto query = adapter->prepare("SELECT COUNT(*) FROM review_schedule WHERE word_id = ?");
+    query.addBindValue(changed.id);
+    ASSERT_TRUE(adapter->exec(query) && query.next());
+    EXPECT_EQ(query.value(0).toInt(), 1);
+
+    // 再次更新没有变化
+    DeltaImporter::Summary again = importer.apply(source.book, source.jsonPath);
+    EXPECT_TRUE(again.success);
+    EXPECT_FALSE(again.hasChanges());
+    EXPECT_EQ(again.unchanged, 3);
+}
+
+// ============================================
+// 测试：批量导入模式结束时重建索引，失败时恢复原状
+// ============================================
+TEST_F(BookImportIntegrationTest, BulkLoadRebuildsIndexes) {
+    ASSERT_TRUE(adapter->execute("CREATE INDEX idx_words_book_id ON words(book_id)"));
+    ASSERT_TRUE(adapter->execute(
+        "CREATE UNIQUE INDEX idx_words_book_word ON words(book_id, word)"));
+    const QString profile = adapter->storageProfile().name;
+
+    auto indexCount = [this]() {
+        QSqlQuery query = adapter->query(
+            "SELECT COUNT(*) FROM sqlite_master WHERE type = 'index' "
+            "AND name IN ('idx_words_book_id', 'idx_words_book_word')");
+        return query.next() ? query.value(0).toInt() : -1;
+    };
+
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    QFile file(dir.filePath("b1.json"));
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    // 4 与 1 是同一个单词，按 INSERT OR REPLACE 语义保留后写入的 4
+    file.write(R"([
+        {"id":3,"word":"gamma"},
+        {"id":4,"word":"alpha","trans":[{"cn":"新"}]},
+        {"id":1,"word":"alpha"},
+        {"id":2,"word":"beta"}
+    ])");
+    file.close();
+
+    ImportPipeline::Source source;
+    source.book.id = "b1";
+    source.book.name = "b1";
+    source.book.url = "b1.json";
+    source.jsonPath = file.fileName();
+
+    ImportPipeline::Options options;
+    options.bulkLoad = true;
+
+    // 取消：回滚后索引仍在
+    ImportPipeline cancelled(*bookRepo, *wordRepo, options);
+    cancelled.setProgressHandler([](const ImportPipeline::Progress&) { return false; });
+    EXPECT_TRUE(cancelled.run(QList<ImportPipeline::Source>() << source).cancelled);
+    EXPECT_EQ(indexCount(), 2);
+    EXPECT_EQ(adapter->storageProfile().name, profile);
+    EXPECT_FALSE(wordRepo->isBulkLoading());
+
+    ImportPipeline pipeline(*bookRepo, *wordRepo, options);
+    ASSERT_TRUE(pipeline.run(QList<ImportPipeline::Source>() << source).success);
+    EXPECT_EQ(indexCount(), 2);
+    EXPECT_EQ(adapter->storageProfile().name, profile);
+
+    QList<Word> words = wordRepo->getByBookId("b1");
+    ASSERT_EQ(words.size(), 3);
+    Word alpha = wordRepo->getByBookAndWord("b1", "alpha");
+    EXPECT_EQ(alpha.wordId, 4);
+    EXPECT_TRUE(alpha.translations.contains(QString::fromUtf8("新")));
+}
+
 // ============================================
 // 主函数
 // ============================================
@@ -0,0 +1,247 @@
+#include <gtest/gtest.h>
+#include "infrastructure/schema_migrator.h"
+#include "infrastructure/repositories/book_repository.h"
+#include "infrastructure/repositories/word_repository.h"
+#include "infrastructure/repositories/study_record_repository.h"
+#include "infrastructure/repositories/review_schedule_repository.h"
+#include "infrastructure/repositories/word_tag_repository.h"
+#include "infrastructure/repositories/user_preference_repository.h"
+#include <QDate>
+#include <QRegularExpression>
+
+using namespace WordMaster::Domain;
+using namespace WordMaster::Infrastructure;
+
+/**
+ * @brief 查询计划回归测试
+ *
+ * 在按正式迁移脚本建立、并填充数据的数据库上调用所有仓储方法，
+ * 再对 profiler 记录到的每条语句执行 EXPLAIN QUERY PLAN：
+ * 除小表（词库、设置）外，出现 SCAN 即视为全表扫描，测试失败。
+ *
+ * 新增仓储查询时应在 exerciseRepositories() 中调用一次。
+ */
+class QueryPlanTest : public ::testing::Test {
+protected:
+    static const int kWordsPerBook = 1000;
+
+    void SetUp() override {
+        adapter = std::make_unique<SQLiteAdapter>(":memory:");
+        ASSERT_TRUE(adapter->open());
+        ASSERT_TRUE(SchemaMigrator(*adapter, WORDMASTER_SCHEMA_DIR).migrate().success);
+
+        bookRepo = std::make_unique<BookRepository>(*adapter);
+        wordRepo = std::make_unique<WordRepository>(*adapter);
+        recordRepo = std::make_unique<StudyRecordRepository>(*adapter);
+        scheduleRepo = std::make_unique<ReviewScheduleRepository>(*adapter);
+        tagRepo = std::make_unique<WordTagRepository>(*adapter);
+        prefRepo = std::make_unique<UserPreferenceRepository>(*adapter);
+
+        populate();
+    }
+
+    void TearDown() override {
+        adapter->close();
+    }
+
+    void populate() {
+        for (const QString& bookId : QStringList() << "cet4" << "cet6") {
+            Book book;
+            book.id = bookId;
+            book.name = bookId.toUpper();
+            book.category = "exam";
+            book.url = bookId + ".json";
+            book.wordCount = kWordsPerBook;
+            ASSERT_TRUE(bookRepo->save(book));
+
+            QList<Word> words;
+            for (int i = 1; i <= kWordsPerBook; ++i) {
+                Word word;
+                word.bookId = bookId;
+                word.wordId = i;
+                word.word = QString("%1word%2").arg(bookId).arg(i, 5, 10, QChar('0'));
+                word.translations = "[]";
+                words.append(word);
+            }
+            ASSERT_TRUE(wordRepo->saveBatch(words));
+        }
+
+        QList<Word> words = wordRepo->getByBookId("cet4");
+        QDate today = QDate::currentDate();
+        for (int i = 0; i < words.size() / 2; ++i) {
+            ReviewPlan plan;
+            plan.wordId = words[i].id;
+            plan.bookId = "cet4";
+            plan.nextReviewDate = today.addDays(i % 21 - 10);
+            plan.lastReviewDate = today.addDays(-1);
+            plan.masteryLevel = ReviewPlan::intToMasteryLevel(i % 3);
+            ASSERT_TRUE(scheduleRepo->save(plan));
+
+            StudyRecord record;
+            record.wordId = words[i].id;
+            record.bookId = "cet4";
+            record.studyType = i % 2 ? StudyRecord::Type::Learn : StudyRecord::Type::Review;
+            record.result = StudyRecord::Result::Known;
+            record.studyDuration = 5;
+            ASSERT_TRUE(recordRepo->save(record));
+
+            if (i % 10 == 0) {
+                ASSERT_TRUE(tagRepo->add(words[i].id, WordTag::TAG_WRONG));
+            }
+        }
+    }
+
+    // 每个仓储方法至少调用一次，使其 SQL 进入 profiler
+    void exerciseRepositories() {
+        QList<Word> words = wordRepo->getByBookId("cet4", 20, 0);
+        ASSERT_FALSE(words.isEmpty());
+        int wordId = words.first().id;
+        QList<int> ids;
+        for (const Word& word : words) {
+            ids.append(word.id);
+        }
+        QDate today = QDate::currentDate();
+
+        bookRepo->update(bookRepo->getById("cet4"));
+        bookRepo->getAll();
+        bookRepo->exists("cet4");
+        bookRepo->getByCategory("exam");
+        bookRepo->setActive("cet4", true);
+        bookRepo->getActiveBook();
+        bookRepo->getTotalWordCount("cet4");
+        bookRepo->getLearnedWordCount("cet4");
+        bookRepo->getMasteredWordCount("cet4");
+
+        wordRepo->getById(wordId);
+        wordRepo->getByIds(ids);
+        wordRepo->exists(wordId);
+        wordRepo->getByBookId("cet4");
+        wordRepo->searchByWord("cet4word001");
+        wordRepo->getByBookAndWord("cet4", words.first().word);
+        wordRepo->save(words.first());
+        wordRepo->update(words.first());
+        wordRepo->getFingerprints("cet4");
+        wordRepo->getTranslations(wordId);
+        wordRepo->getSentences(wordId);
+        wordRepo->getPhrases(wordId);
+        wordRepo->getWordIdsByPos("cet4", QStringList() << "v." << "vt." << "vi.");
+
+        recordRepo->getById(1);
+        recordRepo->getByWordId(wordId);
+        recordRepo->getByDateRange(today.addDays(-7), today);
+        recordRepo->getTodayRecords();
+        recordRepo->getByBookId("cet4");
+        recordRepo->getTodayLearnCount("cet4");
+        recordRepo->getTodayReviewCount("cet4");
+        recordRepo->getTotalStudyDuration(today);
+
+        scheduleRepo->get(wordId);
+        scheduleRepo->exists(wordId);
+        scheduleRepo->getTodayReviewWords("cet4");
+        scheduleRepo->getOverdueWords("cet4");
+        scheduleRepo->getUnlearnedWords("cet4", 20);
+        scheduleRepo->getUnlearnedWords("cet4");
+        scheduleRepo->getLearnedCount("cet4");
+        scheduleRepo->getMasteredCount("cet4");
+
+        tagRepo->exists(wordId, WordTag::TAG_WRONG);
+        tagRepo->getWordsByTag(WordTag::TAG_WRONG);
+        tagRepo->getWordTags(wordId);
+        tagRepo->getTagCount(WordTag::TAG_WRONG);
+        tagRepo->addBatch(ids, WordTag::TAG_FAVORITE);
+        tagRepo->removeBatch(ids, WordTag::TAG_FAVORITE);
+
+        prefRepo->get("theme");
+        prefRepo->exists("theme");
+        prefRepo->getAll();
+
+        // 删除放在最后
+        scheduleRepo->remove(wordId);
+        tagRepo->remove(wordId, WordTag::TAG_WRONG);
+        prefRepo->remove("theme");
+        wordRepo->remove(wordId);
+        wordRepo->removeByBookId("cet6");
+        bookRepo->remove("cet6");
+    }
+
+    // 计划中对大表的全表扫描（SQLite 3.36 前为 "SCAN TABLE x"，之后为 "SCAN x"）
+    static QStringList fullScans(const QStringList& plan) {
+        static const QRegularExpression scan("\\bSCAN (?:TABLE )?(\\w+)");
+        static const QStringList smallTables = QStringList()
+            << "books" << "user_preferences" << "schema_migrations" << "CONSTANT";
+        // 虚表总以 SCAN 出现；idxNum 非 0 表示用上了约束（如 FTS5 按 rowid 查找）
+        static const QRegularExpression keyedVirtualTable("VIRTUAL TABLE INDEX [1-9]\\d*:");
+
+        QStringList scans;
+        for (const QString& step : plan) {
+            if (keyedVirtualTable.match(step).hasMatch()) {
+                continue;
+            }
+            QRegularExpressionMatch match = scan.match(step);
+            if (match.hasMatch() && !smallTables.contains(match.captured(1))) {
+                scans << step;
+            }
+        }
+        return scans;
+    }
+
+    std::unique_ptr<SQLiteAdapter> adapter;
+    std::unique_ptr<BookRepository> bookRepo;
+    std::unique_ptr<WordRepository> wordRepo;
+    std::unique_ptr<StudyRecordRepository> recordRepo;
+    std::unique_ptr<ReviewScheduleRepository> scheduleRepo;
+    std::unique_ptr<WordTagRepository> tagRepo;
+    std::unique_ptr<UserPreferenceRepository> prefRepo;
+};
+
+// ============================================
+// 测试：所有仓储查询都走索引
+// ============================================
+TEST_F(QueryPlanTest, RepositoryQueriesAvoidFullScans) {
+    adapter->profiler().reset();
+    exerciseRepositories();
+
+    QList<QueryProfiler::StatementStats> stats = adapter->profiler().statementStats();
+    ASSERT_GT(stats.size(), 30);
+
+    int explained = 0;
+    for (const QueryProfiler::StatementStats& statement : stats) {
+        QStringList plan = adapter->explainQueryPlan(statement.sampleSql,
+                                                     statement.sampleValues);
+        if (plan.isEmpty()) {
+            continue;
+        }
+        ++explained;
+
+        QStringList scans = fullScans(plan);
+        EXPECT_TRUE(scans.isEmpty())
+            << "Full scan in: " << qPrintable(statement.sql)
+            << "\nPlan: " << qPrintable(plan.join(" | "));
+    }
+
+    EXPECT_GT(explained, 20);
+}
+
+// ============================================
+// 测试：到期查询由复合索引直接给出顺序
+// ============================================
+TEST_F(QueryPlanTest, DueQueriesUseCompositeIndex) {
+    adapter->profiler().reset();
+    scheduleRepo->getTodayReviewWords("cet4");
+    scheduleRepo->getOverdueWords("cet4");
+
+    QList<QueryProfiler::StatementStats> stats = adapter->profiler().statementStats();
+    ASSERT_EQ(stats.size(), 2);
+
+    for (const QueryProfiler::StatementStats& statement : stats) {
+        QString plan = adapter->explainQueryPlan(statement.sampleSql,
+                                                 statement.sampleValues).join(" | ");
+        EXPECT_TRUE(plan.contains("idx_review_book_due")) << qPrintable(plan);
+        EXPECT_FALSE(plan.contains("TEMP B-TREE")) << qPrintable(plan);
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
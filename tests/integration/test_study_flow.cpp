@@ -1,11 +1,16 @@
 #include <gtest/gtest.h>
 #include "application/services/study_service.h"
 #include "application/services/sm2_scheduler.h"
+#include "application/services/import_job.h"
 #include "infrastructure/repositories/word_repository.h"
 #include "infrastructure/repositories/study_record_repository.h"
 #include "infrastructure/repositories/review_schedule_repository.h"
 #include "infrastructure/repositories/book_repository.h"
 #include "tests/test_helpers.h"
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QFile>
+#include <QTemporaryDir>
 
 using namespace WordMaster::Application;
 using namespace WordMaster::Domain;
@@ -54,6 +59,27 @@ protected:
         adapter.reset();
     }
     
+    /**
+     * @brief 写入一个待导入的词库文件
+     */
+    ImportPipeline::Source writeImportBook(const QTemporaryDir& dir,
+                                           const QString& bookId, int count) {
+        QStringList items;
+        for (int i = 1; i <= count; ++i) {
+            items << QString(R"({"id":%1,"word":"%2-%1"})").arg(i).arg(bookId);
+        }
+        QFile file(dir.filePath(bookId + ".json"));
+        EXPECT_TRUE(file.open(QIODevice::WriteOnly));
+        file.write(("[" + items.join(",") + "]").toUtf8());
+        
+        ImportPipeline::Source source;
+        source.book.id = bookId;
+        source.book.name = bookId;
+        source.book.url = bookId + ".json";
+        source.jsonPath = file.fileName();
+        return source;
+    }
+    
     void setupTestData() {
         // 创建测试词库
         Book book;
@@ -409,10 +435,297 @@ TEST_F(StudyFlowIntegrationTest, ReviewQualityAffectsInterval) {
     EXPECT_GT(updatedPlan.repetitionCount, initialPlan.repetitionCount);
 }
 
+// ============================================
+// 测试：复习计划写入失败时学习记录一起回滚
+// ============================================
+TEST_F(StudyFlowIntegrationTest, ScheduleFailureRollsBackRecord) {
+    // Arrange - 没有复习计划的单词进入复习会话
+    StudyService::StudySession session;
+    session.bookId = "test_cet4";
+    session.type = StudyService::StudySession::Review;
+    session.wordIds << wordRepo->getByBookId("test_cet4").first().id;
+    
+    StudyService::StudyResult result;
+    result.wordId = session.wordIds[0];
+    result.bookId = "test_cet4";
+    result.known = true;
+    result.duration = 5;
+    
+    // Act
+    EXPECT_FALSE(service->recordAndNext(session, result));
+    
+    // Assert
+    EXPECT_EQ(session.currentIndex, 0);
+    EXPECT_EQ(adapter->transactionDepth(), 0);
+    EXPECT_EQ(recordRepo->getTodayRecords().size(), 0);
+}
+
+// ============================================
+// 测试：写后队列批量提交
+// ============================================
+TEST_F(StudyFlowIntegrationTest, WriteBehindCommitsInGroups) {
+    // 每 3 条提交一次，间隔足够长，不依赖定时器
+    service->enableWriteBehind(3, 60000);
+    
+    auto session = service->startSession(
+        "test_cet4",
+        StudyService::StudySession::NewWords,
+        5
+    );
+    ASSERT_EQ(session.wordIds.size(), 5);
+    
+    auto answer = [&]() {
+        Word word = service->getCurrentWord(session);
+        
+        StudyService::StudyResult result;
+        result.wordId = word.id;
+        result.bookId = "test_cet4";
+        result.known = true;
+        result.duration = 5;
+        
+        ASSERT_TRUE(service->recordAndNext(session, result));
+    };
+    
+    // 前两条只入队，不写库
+    answer();
+    answer();
+    EXPECT_EQ(service->pendingWriteCount(), 2);
+    EXPECT_EQ(recordRepo->getTodayRecords().size(), 0);
+    EXPECT_EQ(session.currentIndex, 2);
+    
+    // 第三条触发批量提交
+    answer();
+    EXPECT_EQ(service->pendingWriteCount(), 0);
+    EXPECT_EQ(recordRepo->getTodayRecords().size(), 3);
+    EXPECT_TRUE(scheduleRepo->exists(session.wordIds[0]));
+    
+    // 结束会话前会先提交队列（读自己的写）
+    answer();
+    EXPECT_EQ(service->pendingWriteCount(), 1);
+    
+    auto summary = service->endSession(session);
+    EXPECT_EQ(service->pendingWriteCount(), 0);
+    EXPECT_EQ(summary.totalWords, 4);
+}
+
+// ============================================
+// 测试：同一单词的多次作答合并为一次写入
+// ============================================
+TEST_F(StudyFlowIntegrationTest, WriteBehindMergesAnswersPerWord) {
+    service->enableWriteBehind(10, 60000);
+
+    auto session = service->startSession(
+        "test_cet4",
+        StudyService::StudySession::NewWords,
+        5
+    );
+    int wordId = session.wordIds[0];
+
+    StudyService::StudyResult result;
+    result.wordId = wordId;
+    result.bookId = "test_cet4";
+    result.known = false;
+    result.duration = 4;
+    ASSERT_TRUE(service->recordAndNext(session, result));
+
+    result.known = true;
+    result.duration = 6;
+    ASSERT_TRUE(service->recordAndNext(session, result));
+    EXPECT_EQ(service->pendingWriteCount(), 1);
+
+    ASSERT_TRUE(service->flushPendingWrites());
+
+    // 一条记录：最后一次的结果，时长累加
+    QList<StudyRecord> records = recordRepo->getTodayRecords();
+    ASSERT_EQ(records.size(), 1);
+    EXPECT_EQ(records[0].result, StudyRecord::Result::Known);
+    EXPECT_EQ(records[0].studyDuration, 10);
+    EXPECT_EQ(records[0].studyType, StudyRecord::Type::Learn);
+    EXPECT_TRUE(scheduleRepo->exists(wordId));
+}
+
+// ============================================
+// 测试：提交失败时回滚，之后的提交不会嵌套进未结束的事务
+// ============================================
+TEST_F(StudyFlowIntegrationTest, WriteBehindRollsBackFailedCommit) {
+    // 延迟外键在 COMMIT 时才检查：每写一条学习记录就插入一行违反外键的数据，
+    // 使提交失败而事务保持打开
+    ASSERT_TRUE(adapter->execute(
+        "CREATE TABLE answer_guard ("
+        "word_id INTEGER REFERENCES words(id) DEFERRABLE INITIALLY DEFERRED)"));
+    ASSERT_TRUE(adapter->execute(
+        "CREATE TRIGGER fail_commit AFTER INSERT ON study_records "
+        "BEGIN INSERT INTO answer_guard VALUES (-1); END"));
+
+    service->enableWriteBehind(10, 60000);
+
+    auto session = service->startSession(
+        "test_cet4",
+        StudyService::StudySession::NewWords,
+        5
+    );
+
+    StudyService::StudyResult result;
+    result.wordId = session.wordIds[0];
+    result.bookId = "test_cet4";
+    result.known = true;
+    result.duration = 5;
+    ASSERT_TRUE(service->recordAndNext(session, result));
+
+    // Act - 提交失败，事件保留
+    EXPECT_FALSE(service->flushPendingWrites());
+    EXPECT_EQ(adapter->transactionDepth(), 0);
+    EXPECT_EQ(service->pendingWriteCount(), 1);
+    EXPECT_EQ(recordRepo->getTodayRecords().size(), 0);
+
+    // 排除故障后重试：在新的顶层事务中提交
+    ASSERT_TRUE(adapter->execute("DROP TRIGGER fail_commit"));
+    result.wordId = session.wordIds[1];
+    ASSERT_TRUE(service->recordAndNext(session, result));
+
+    EXPECT_TRUE(service->flushPendingWrites());
+    EXPECT_EQ(adapter->transactionDepth(), 0);
+    EXPECT_EQ(service->pendingWriteCount(), 0);
+    EXPECT_EQ(recordRepo->getTodayRecords().size(), 2);
+}
+
+// ============================================
+// 测试：后台导入期间学习结果照常写入（导入与界面共用写连接，逐批提交）
+// ============================================
+TEST_F(StudyFlowIntegrationTest, StudyWritesWhileImportRunning) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    
+    ImportPipeline::Options options;
+    options.batchSize = 10;
+    options.maxInFlightBatches = 2;
+    ImportJob job(QList<ImportPipeline::Source>() << writeImportBook(dir, "imp", 200),
+                  *bookRepo, *wordRepo, nullptr, options);
+    
+    QEventLoop loop;
+    bool studied = false;
+    int importedWhenStudied = -1;
+    bool importSucceeded = false;
+    
+    // 第一批提交后作答：下一批要等本线程执行，导入一定还没结束
+    QObject::connect(&job, &ImportJob::progress, &loop,
+                     [&](const QString&, int written, int, double, qint64) {
+        if (written != options.batchSize) {
+            return;
+        }
+        auto session = service->startSession(
+            "test_cet4", StudyService::StudySession::NewWords, 1);
+        ASSERT_EQ(session.wordIds.size(), 1);
+        
+        StudyService::StudyResult result;
+        result.wordId = session.wordIds.first();
+        result.bookId = "test_cet4";
+        result.known = true;
+        result.duration = 3;
+        studied = service->recordAndNext(session, result);
+        importedWhenStudied = wordRepo->getByBookId("imp").size();
+        EXPECT_TRUE(job.isRunning());
+    });
+    QObject::connect(&job, &ImportJob::finished, &loop,
+                     [&](bool success, bool, const QString&) {
+        importSucceeded = success;
+        loop.quit();
+    });
+    
+    job.start();
+    loop.exec();
+    
+    EXPECT_TRUE(studied);
+    EXPECT_EQ(importedWhenStudied, 10);
+    EXPECT_TRUE(importSucceeded);
+    EXPECT_EQ(wordRepo->getByBookId("imp").size(), 200);
+    EXPECT_EQ(recordRepo->getTodayRecords().size(), 1);
+    EXPECT_EQ(adapter->transactionDepth(), 0);
+}
+
+// ============================================
+// 测试：取消后台导入，已逐批提交的当前词库被删除
+// ============================================
+TEST_F(StudyFlowIntegrationTest, CancelledImportRemovesPartialBook) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    
+    ImportPipeline::Options options;
+    options.batchSize = 10;
+    options.maxInFlightBatches = 2;
+    ImportJob job(QList<ImportPipeline::Source>() << writeImportBook(dir, "imp", 200),
+                  *bookRepo, *wordRepo, nullptr, options);
+    
+    QEventLoop loop;
+    bool cancelled = false;
+    QObject::connect(&job, &ImportJob::progress, &loop,
+                     [&](const QString&, int written, int, double, qint64) {
+        if (written >= 30) {
+            job.cancel();
+        }
+    });
+    QObject::connect(&job, &ImportJob::finished, &loop,
+                     [&](bool, bool wasCancelled, const QString&) {
+        cancelled = wasCancelled;
+        loop.quit();
+    });
+    
+    job.start();
+    loop.exec();
+    
+    EXPECT_TRUE(cancelled);
+    EXPECT_FALSE(bookRepo->exists("imp"));
+    EXPECT_TRUE(wordRepo->getByBookId("imp").isEmpty());
+    EXPECT_EQ(adapter->transactionDepth(), 0);
+    EXPECT_TRUE(bookRepo->exists("test_cet4"));
+}
+
+// ============================================
+// 测试：卡片按窗口预取，之后只查内存
+// ============================================
+TEST_F(StudyFlowIntegrationTest, PrefetchesCardsAhead) {
+    // Arrange - 读任务先排队，由测试代替后台线程执行
+    QList<StudyService::ReadTask> tasks;
+    service->enablePrefetch([&tasks](const StudyService::ReadTask& task) {
+        tasks.append(task);
+    }, 2);
+    
+    auto session = service->startSession("test_cet4", StudyService::StudySession::NewWords, 5);
+    ASSERT_EQ(tasks.size(), 1);
+    tasks.takeFirst()(*wordRepo);
+    
+    // 预取后删除单词：卡片仍从内存返回
+    int firstId = session.wordIds[0];
+    ASSERT_TRUE(wordRepo->remove(firstId));
+    
+    // Act
+    StudyService::WordCard card = service->getCurrentCard(session);
+    
+    // Assert
+    EXPECT_EQ(card.word.id, firstId);
+    EXPECT_EQ(card.word.word, "word1");
+    ASSERT_EQ(card.translations.size(), 1);
+    EXPECT_EQ(card.translations[0].meaning, QString::fromUtf8("单词"));
+    EXPECT_TRUE(tasks.isEmpty());
+    
+    // 剩余不足半个窗口时预取下一段；未预取到的卡片同步读取
+    session.moveNext();
+    EXPECT_EQ(service->getCurrentCard(session).word.word, "word2");
+    EXPECT_EQ(tasks.size(), 1);
+    session.moveNext();
+    EXPECT_EQ(service->getCurrentCard(session).word.word, "word3");
+    
+    // 新会话丢弃旧卡片，旧任务完成后不再写入
+    service->startSession("test_cet4", StudyService::StudySession::NewWords, 5);
+    tasks.takeFirst()(*wordRepo);
+}
+
 // ============================================
 // 主函数
 // ============================================
 int main(int argc, char **argv) {
+    // 后台导入的写入经事件循环回到测试线程
+    QCoreApplication app(argc, argv);
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
 }
\ No newline at end of file
@@ -55,17 +55,70 @@ public:
                 word TEXT NOT NULL,
                 phonetic_uk TEXT,
                 phonetic_us TEXT,
+                gloss TEXT,
                 translations TEXT,
                 sentences TEXT,
                 phrases TEXT,
                 synonyms TEXT,
                 related_words TEXT,
                 etymology TEXT,
+                content_hash BLOB,
                 created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
                 FOREIGN KEY(book_id) REFERENCES books(id) ON DELETE CASCADE,
                 UNIQUE(book_id, word_id)
             );
             
+            CREATE TABLE word_details (
+                word_id INTEGER PRIMARY KEY,
+                translations TEXT,
+                sentences TEXT,
+                phrases TEXT,
+                synonyms TEXT,
+                related_words TEXT,
+                etymology TEXT,
+                FOREIGN KEY(word_id) REFERENCES words(id) ON DELETE CASCADE
+            );
+            
+            CREATE TABLE word_translations (
+                word_id INTEGER NOT NULL,
+                position INTEGER NOT NULL,
+                book_id TEXT NOT NULL,
+                pos TEXT,
+                meaning TEXT,
+                PRIMARY KEY(word_id, position),
+                FOREIGN KEY(word_id) REFERENCES words(id) ON DELETE CASCADE
+            );
+            
+            CREATE TABLE word_sentences (
+                word_id INTEGER NOT NULL,
+                position INTEGER NOT NULL,
+                english TEXT,
+                chinese TEXT,
+                PRIMARY KEY(word_id, position),
+                FOREIGN KEY(word_id) REFERENCES words(id) ON DELETE CASCADE
+            );
+            
+            CREATE TABLE word_phrases (
+                word_id INTEGER NOT NULL,
+                position INTEGER NOT NULL,
+                phrase TEXT,
+                meaning TEXT,
+                PRIMARY KEY(word_id, position),
+                FOREIGN KEY(word_id) REFERENCES words(id) ON DELETE CASCADE
+            );
+            
+            CREATE TABLE structured_backfill (
+                word_id INTEGER PRIMARY KEY
+            );
+            
+            CREATE TABLE detail_dictionaries (
+                id INTEGER PRIMARY KEY AUTOINCREMENT,
+                book_id TEXT NOT NULL,
+                dictionary BLOB NOT NULL,
+                created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
+                FOREIGN KEY(book_id) REFERENCES books(id) ON DELETE CASCADE
+            );
+            
             CREATE TABLE study_records (
                 id INTEGER PRIMARY KEY AUTOINCREMENT,
                 word_id INTEGER NOT NULL,
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include "infrastructure/repositories/cached_word_repository.h"
+#include "infrastructure/repositories/word_repository.h"
+#include "infrastructure/repositories/book_repository.h"
+#include "tests/test_helpers.h"
+
+using namespace WordMaster::Domain;
+using namespace WordMaster::Infrastructure;
+using namespace WordMaster::Testing;
+
+/**
+ * @brief CachedWordRepository 单元测试
+ *
+ * 测试目标：
+ * 1. 按 id 的重复读取由缓存返回，命中统计正确
+ * 2. 写入、删除后对应单词失效，不返回旧数据
+ * 3. 超出字节预算时淘汰最久未用的单词
+ */
+class CachedWordRepositoryTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        adapter = TestDatabaseHelper::createTestDatabase();
+        ASSERT_TRUE(adapter->isOpen());
+        ASSERT_TRUE(TestDatabaseHelper::initializeTestSchema(*adapter));
+        
+        bookRepo = std::make_unique<BookRepository>(*adapter);
+        Book book;
+        book.id = "test_cet4";
+        book.name = "Test CET-4";
+        book.url = "test.json";
+        ASSERT_TRUE(bookRepo->save(book));
+        
+        repository = std::make_unique<WordRepository>(*adapter);
+        
+        QList<Word> words;
+        for (int i = 1; i <= 3; ++i) {
+            words.append(createTestWord(i, QString("word%1").arg(i)));
+        }
+        ASSERT_TRUE(repository->saveBatch(words));
+        for (const Word& word : repository->getByBookId("test_cet4")) {
+            ids.append(word.id);
+        }
+        ASSERT_EQ(ids.size(), 3);
+    }
+    
+    Word createTestWord(int wordId, const QString& word) {
+        Word w;
+        w.bookId = "test_cet4";
+        w.wordId = wordId;
+        w.word = word;
+        w.translations = QString::fromUtf8(R"([{"pos":"n.","cn":"测试"}])");
+        w.sentences = "[]";
+        return w;
+    }
+    
+    std::unique_ptr<SQLiteAdapter> adapter;
+    std::unique_ptr<BookRepository> bookRepo;
+    std::unique_ptr<WordRepository> repository;
+    QList<int> ids;
+};
+
+// ============================================
+// 测试：命中与失效
+// ============================================
+TEST_F(CachedWordRepositoryTest, ServesRepeatedReadsAndInvalidatesOnWrite) {
+    CachedWordRepository cache(*repository);
+    
+    // Summary 缓存项满足 Summary 读取，不满足 Full 读取
+    EXPECT_EQ(cache.getById(ids[0], WordProjection::Summary).word, "word1");
+    EXPECT_EQ(cache.getById(ids[0], WordProjection::Summary).word, "word1");
+    EXPECT_EQ(cache.stats().hits, 1u);
+    EXPECT_EQ(cache.getById(ids[0]).translations, createTestWord(1, "word1").translations);
+    EXPECT_EQ(cache.stats().misses, 2u);
+    
+    // getByIds 只查询未命中的 id，按参数顺序返回
+    QList<Word> words = cache.getByIds(QList<int>() << ids[2] << ids[0] << ids[1]);
+    ASSERT_EQ(words.size(), 3);
+    EXPECT_EQ(words[0].word, "word3");
+    EXPECT_EQ(words[1].word, "word1");
+    EXPECT_EQ(cache.stats().hits, 2u);
+    EXPECT_EQ(cache.cachedWords(), 3);
+    EXPECT_GT(cache.stats().hitRate(), 0.0);
+    
+    // 按 id 更新
+    Word updated = words[1];
+    updated.word = "word1-updated";
+    ASSERT_TRUE(cache.update(updated));
+    EXPECT_EQ(cache.getById(ids[0]).word, "word1-updated");
+    
+    // 重新导入同一 word_id：旧 id 的行被替换
+    ASSERT_TRUE(cache.save(createTestWord(2, "word2-reimported")));
+    EXPECT_EQ(cache.getById(ids[1]).id, 0);
+    
+    // 按词库删除
+    ASSERT_TRUE(cache.removeByBookId("test_cet4"));
+    EXPECT_EQ(cache.cachedWords(), 0);
+    EXPECT_EQ(cache.getById(ids[2]).id, 0);
+}
+
+// ============================================
+// 测试：字节预算
+// ============================================
+TEST_F(CachedWordRepositoryTest, EvictsLeastRecentlyUsedWithinBudget) {
+    CachedWordRepository probe(*repository);
+    probe.getById(ids[0]);
+    const int wordBytes = probe.cachedBytes();
+    ASSERT_GT(wordBytes, 0);
+    
+    // 只能容纳两个单词
+    CachedWordRepository cache(*repository, wordBytes * 2 + wordBytes / 2);
+    cache.getById(ids[0]);
+    cache.getById(ids[1]);
+    cache.getById(ids[0]);      // ids[1] 成为最久未用
+    cache.getById(ids[2]);
+    
+    EXPECT_EQ(cache.cachedWords(), 2);
+    EXPECT_LE(cache.cachedBytes(), cache.byteBudget());
+    
+    cache.resetStats();
+    cache.getById(ids[0]);
+    cache.getById(ids[1]);
+    EXPECT_EQ(cache.stats().hits, 1u);
+    EXPECT_EQ(cache.stats().misses, 1u);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
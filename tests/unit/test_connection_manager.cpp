@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include "infrastructure/connection_manager.h"
+#include <QDir>
+#include <QFile>
+#include <QThread>
+#include <atomic>
+
+using namespace WordMaster::Infrastructure;
+
+/**
+ * @brief ConnectionManager 单元测试
+ * 
+ * 测试目标：
+ * 1. 读连接在独立线程上执行任务
+ * 2. 读连接能看到写连接已提交的数据
+ * 3. 读连接为只读
+ * 4. 内存数据库退化为写连接同步执行
+ */
+class ConnectionManagerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dbPath = QDir::temp().filePath("test_connection_manager.db");
+        removeDatabaseFiles();
+    }
+    
+    void TearDown() override {
+        removeDatabaseFiles();
+    }
+    
+    void removeDatabaseFiles() {
+        QFile::remove(dbPath);
+        QFile::remove(dbPath + "-wal");
+        QFile::remove(dbPath + "-shm");
+    }
+    
+    QString dbPath;
+};
+
+// ============================================
+// 测试：读任务在读线程上看到已提交的数据
+// ============================================
+TEST_F(ConnectionManagerTest, ReadersSeeCommittedWrites) {
+    ConnectionManager manager(dbPath, 2);
+    ASSERT_TRUE(manager.open());
+    EXPECT_EQ(manager.readerCount(), 2);
+    
+    SQLiteAdapter& writer = manager.writer();
+    ASSERT_TRUE(writer.execute("CREATE TABLE items (id INTEGER PRIMARY KEY, value TEXT)"));
+    ASSERT_TRUE(writer.execute("INSERT INTO items (value) VALUES ('a')"));
+    ASSERT_TRUE(writer.execute("INSERT INTO items (value) VALUES ('b')"));
+    
+    std::atomic<int> total(0);
+    std::atomic<int> offThread(0);
+    QThread* mainThread = QThread::currentThread();
+    
+    for (int i = 0; i < 8; ++i) {
+        manager.submitRead([&](SQLiteAdapter& reader) {
+            if (QThread::currentThread() != mainThread) {
+                ++offThread;
+            }
+            auto query = reader.prepare("SELECT COUNT(*) as cnt FROM items");
+            if (query.exec() && query.next()) {
+                total += query.value("cnt").toInt();
+            }
+        });
+    }
+    manager.waitForReads();
+    
+    EXPECT_EQ(total.load(), 16);
+    EXPECT_EQ(offThread.load(), 8);
+    
+    // 新的提交对后续读任务可见
+    ASSERT_TRUE(writer.execute("INSERT INTO items (value) VALUES ('c')"));
+    
+    std::atomic<int> count(0);
+    manager.submitRead([&](SQLiteAdapter& reader) {
+        auto query = reader.prepare("SELECT COUNT(*) as cnt FROM items");
+        if (query.exec() && query.next()) {
+            count = query.value("cnt").toInt();
+        }
+    });
+    manager.waitForReads();
+    
+    EXPECT_EQ(count.load(), 3);
+}
+
+// ============================================
+// 测试：读连接不能写入
+// ============================================
+TEST_F(ConnectionManagerTest, ReadersAreReadOnly) {
+    ConnectionManager manager(dbPath, 1);
+    ASSERT_TRUE(manager.open());
+    ASSERT_TRUE(manager.writer().execute("CREATE TABLE items (id INTEGER PRIMARY KEY)"));
+    
+    std::atomic<bool> writeSucceeded(true);
+    manager.submitRead([&](SQLiteAdapter& reader) {
+        writeSucceeded = reader.execute("INSERT INTO items (id) VALUES (1)");
+    });
+    manager.waitForReads();
+    
+    EXPECT_FALSE(writeSucceeded.load());
+}
+
+// ============================================
+// 测试：内存数据库没有读连接，任务同步执行
+// ============================================
+TEST_F(ConnectionManagerTest, MemoryDatabaseRunsOnWriter) {
+    ConnectionManager manager(":memory:", 2);
+    ASSERT_TRUE(manager.open());
+    EXPECT_EQ(manager.readerCount(), 0);
+    
+    bool ran = false;
+    manager.submitRead([&](SQLiteAdapter& reader) {
+        ran = (&reader == &manager.writer());
+    });
+    
+    EXPECT_TRUE(ran);
+}
+
+// ============================================
+// 主函数
+// ============================================
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
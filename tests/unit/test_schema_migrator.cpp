@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+#include "infrastructure/schema_migrator.h"
+#include <QTemporaryDir>
+#include <QFile>
+#include <QSqlQuery>
+
+using namespace WordMaster::Infrastructure;
+
+/**
+ * @brief SchemaMigrator 单元测试
+ *
+ * 测试目标：
+ * 1. 按版本号顺序执行迁移并记录版本
+ * 2. 已是最新版本时不再执行任何迁移
+ * 3. 迁移失败时整体回滚，版本号不变
+ * 4. 内置的初始化脚本可在旧库上执行
+ */
+class SchemaMigratorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        adapter = std::make_unique<SQLiteAdapter>(":memory:");
+        ASSERT_TRUE(adapter->open());
+        ASSERT_TRUE(migrationDir.isValid());
+    }
+
+    void TearDown() override {
+        adapter->close();
+    }
+
+    void writeMigration(const QString& fileName, const QByteArray& sql) {
+        QFile file(migrationDir.filePath(fileName));
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        file.write(sql);
+    }
+
+    int countRows(const QString& table) {
+        QSqlQuery query = adapter->query("SELECT COUNT(*) FROM " + table);
+        return query.next() ? query.value(0).toInt() : -1;
+    }
+
+    std::unique_ptr<SQLiteAdapter> adapter;
+    QTemporaryDir migrationDir;
+};
+
+// ============================================
+// 测试：按顺序执行并记录版本
+// ============================================
+TEST_F(SchemaMigratorTest, AppliesMigrationsInOrder) {
+    writeMigration("002_add_items.sql",
+                   "INSERT INTO items (name) VALUES ('second');");
+    writeMigration("001_create_items.sql",
+                   "-- 创建表\n"
+                   "CREATE TABLE items (id INTEGER PRIMARY KEY, name TEXT);\n"
+                   "INSERT INTO items (name) VALUES ('first');");
+    writeMigration("notes.sql", "THIS IS NOT SQL;");
+
+    SchemaMigrator migrator(*adapter, migrationDir.path());
+    ASSERT_EQ(migrator.migrations().size(), 2);
+    EXPECT_EQ(migrator.latestVersion(), 2);
+
+    auto result = migrator.migrate();
+    EXPECT_TRUE(result.success);
+    EXPECT_EQ(result.fromVersion, 0);
+    EXPECT_EQ(result.toVersion, 2);
+    EXPECT_EQ(result.appliedCount, 2);
+
+    EXPECT_EQ(migrator.currentVersion(), 2);
+    EXPECT_EQ(countRows("items"), 2);
+    EXPECT_EQ(countRows("schema_migrations"), 2);
+    EXPECT_TRUE(migrator.verifyChecksums());
+}
+
+// ============================================
+// 测试：热启动不重复执行
+// ============================================
+TEST_F(SchemaMigratorTest, WarmStartAppliesNothing) {
+    writeMigration("001_create_items.sql",
+                   "CREATE TABLE items (id INTEGER PRIMARY KEY, name TEXT);"
+                   "INSERT INTO items (name) VALUES ('first');");
+
+    ASSERT_TRUE(SchemaMigrator(*adapter, migrationDir.path()).migrate().success);
+
+    // 新增一个迁移，只执行新的那个
+    writeMigration("002_add_items.sql",
+                   "INSERT INTO items (name) VALUES ('second');");
+    auto second = SchemaMigrator(*adapter, migrationDir.path()).migrate();
+    EXPECT_TRUE(second.success);
+    EXPECT_EQ(second.appliedCount, 1);
+
+    auto third = SchemaMigrator(*adapter, migrationDir.path()).migrate();
+    EXPECT_TRUE(third.success);
+    EXPECT_EQ(third.appliedCount, 0);
+    EXPECT_EQ(third.toVersion, 2);
+    EXPECT_TRUE(third.checksumsMatch);
+    EXPECT_EQ(countRows("items"), 2);
+
+    // 修改已执行的脚本只会被检测到，不会重新执行
+    writeMigration("001_create_items.sql", "CREATE TABLE items (id INTEGER);");
+    SchemaMigrator changed(*adapter, migrationDir.path());
+    EXPECT_FALSE(changed.verifyChecksums());
+    auto fourth = changed.migrate();
+    EXPECT_TRUE(fourth.success);
+    EXPECT_EQ(fourth.appliedCount, 0);
+    EXPECT_FALSE(fourth.checksumsMatch);
+    
+    // 有新迁移要执行时同样先校验
+    writeMigration("003_more_items.sql",
+                   "INSERT INTO items (name) VALUES ('third');");
+    auto fifth = SchemaMigrator(*adapter, migrationDir.path()).migrate();
+    EXPECT_TRUE(fifth.success);
+    EXPECT_EQ(fifth.appliedCount, 1);
+    EXPECT_FALSE(fifth.checksumsMatch);
+}
+
+// ============================================
+// 测试：失败的迁移整体回滚
+// ============================================
+TEST_F(SchemaMigratorTest, FailedMigrationRollsBack) {
+    writeMigration("001_create_items.sql",
+                   "CREATE TABLE items (id INTEGER PRIMARY KEY, name TEXT);");
+    writeMigration("002_broken.sql",
+                   "INSERT INTO items (name) VALUES ('partial');"
+                   "INSERT INTO missing_table (name) VALUES ('x');");
+
+    SchemaMigrator migrator(*adapter, migrationDir.path());
+    auto result = migrator.migrate();
+
+    EXPECT_FALSE(result.success);
+    EXPECT_EQ(result.toVersion, 1);
+    EXPECT_EQ(migrator.currentVersion(), 1);
+    EXPECT_EQ(countRows("items"), 0);
+}
+
+// ============================================
+// 测试：可选迁移失败时只撤销自身语句，版本照常记录
+// ============================================
+TEST_F(SchemaMigratorTest, OptionalMigrationIsSkippedWhenUnsupported) {
+    writeMigration("001_create_items.sql",
+                   "CREATE TABLE items (id INTEGER PRIMARY KEY, name TEXT);");
+    writeMigration("002_unsupported.sql",
+                   "-- @optional\n"
+                   "CREATE TABLE item_log (id INTEGER);\n"
+                   "CREATE VIRTUAL TABLE item_search USING no_such_module(name);");
+    writeMigration("003_trigger.sql",
+                   "CREATE TABLE item_names (name TEXT);\n"
+                   "CREATE TRIGGER items_insert AFTER INSERT ON items\n"
+                   "BEGIN\n"
+                   "    INSERT INTO item_names VALUES (new.name);\n"
+                   "    INSERT INTO item_names VALUES (new.name || '!');\n"
+                   "END;");
+
+    SchemaMigrator migrator(*adapter, migrationDir.path());
+    auto result = migrator.migrate();
+
+    EXPECT_TRUE(result.success);
+    EXPECT_EQ(result.toVersion, 3);
+    EXPECT_EQ(countRows("schema_migrations"), 3);
+    EXPECT_EQ(countRows("item_log"), -1);
+
+    // 触发器体内的分号不拆分语句
+    ASSERT_TRUE(adapter->execute("INSERT INTO items (name) VALUES ('a')"));
+    EXPECT_EQ(countRows("item_names"), 2);
+}
+
+// ============================================
+// 测试：内置脚本可在无版本号的旧库上执行
+// ============================================
+TEST_F(SchemaMigratorTest, BundledSchemaUpgradesLegacyDatabase) {
+    SchemaMigrator migrator(*adapter, WORDMASTER_SCHEMA_DIR);
+    ASSERT_GE(migrator.latestVersion(), 1);
+
+    // 模拟旧版本：直接执行 001，没有 user_version
+    ASSERT_TRUE(adapter->initializeDatabase(migrator.migrations().first().filePath));
+    ASSERT_EQ(migrator.currentVersion(), 0);
+
+    auto result = migrator.migrate();
+    EXPECT_TRUE(result.success);
+    EXPECT_EQ(result.toVersion, migrator.latestVersion());
+    EXPECT_GT(countRows("user_preferences"), 0);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
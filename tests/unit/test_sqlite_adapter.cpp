@@ -3,6 +3,7 @@
 #include <QSqlQuery>
 #include <QVariant>
 #include <QFile>
+#include <QDir>
 
 using namespace WordMaster::Infrastructure;
 
@@ -171,6 +172,59 @@ TEST_F(SQLiteAdapterTest, TransactionRollback) {
     EXPECT_EQ(query.value("cnt").toInt(), 1);
 }
 
+// ============================================
+// 测试：嵌套事务与作用域事务
+// ============================================
+TEST_F(SQLiteAdapterTest, NestedTransactionScopes) {
+    ASSERT_TRUE(adapter->open());
+    ASSERT_TRUE(adapter->execute("CREATE TABLE test_data (id INTEGER PRIMARY KEY, value TEXT)"));
+    
+    auto count = [this]() {
+        auto query = adapter->query("SELECT COUNT(*) FROM test_data");
+        return query.next() ? query.value(0).toInt() : -1;
+    };
+    
+    {
+        SQLiteAdapter::Transaction outer(*adapter);
+        ASSERT_TRUE(outer.isActive());
+        adapter->execute("INSERT INTO test_data (value) VALUES ('outer')");
+        
+        // 内层提交只释放保存点
+        {
+            SQLiteAdapter::Transaction inner(*adapter);
+            ASSERT_TRUE(inner.isActive());
+            EXPECT_EQ(adapter->transactionDepth(), 2);
+            adapter->execute("INSERT INTO test_data (value) VALUES ('kept')");
+            EXPECT_TRUE(inner.commit());
+        }
+        
+        // 内层未提交：析构时只回滚到保存点
+        {
+            SQLiteAdapter::Transaction inner(*adapter);
+            adapter->execute("INSERT INTO test_data (value) VALUES ('discarded')");
+        }
+        
+        EXPECT_EQ(adapter->transactionDepth(), 1);
+        EXPECT_EQ(count(), 2);
+        EXPECT_TRUE(outer.commit());
+    }
+    
+    EXPECT_EQ(adapter->transactionDepth(), 0);
+    EXPECT_EQ(count(), 2);
+    
+    // 外层未提交：内层已提交的写入一并回滚
+    {
+        SQLiteAdapter::Transaction outer(*adapter);
+        SQLiteAdapter::Transaction inner(*adapter);
+        adapter->execute("INSERT INTO test_data (value) VALUES ('lost')");
+        EXPECT_TRUE(inner.commit());
+    }
+    
+    EXPECT_EQ(adapter->transactionDepth(), 0);
+    EXPECT_EQ(count(), 2);
+    EXPECT_FALSE(adapter->commit());
+}
+
 // ============================================
 // 测试：获取最后插入ID
 // ============================================
@@ -248,6 +302,171 @@ TEST_F(SQLiteAdapterTest, ForeignKeyConstraint) {
     EXPECT_FALSE(result);
 }
 
+// ============================================
+// 测试：预处理语句缓存复用
+// ============================================
+TEST_F(SQLiteAdapterTest, StatementCacheReuse) {
+    ASSERT_TRUE(adapter->open());
+    
+    adapter->execute("CREATE TABLE test_cache (id INTEGER PRIMARY KEY, name TEXT)");
+    
+    QString insertSQL = "INSERT INTO test_cache (name) VALUES (?)";
+    
+    auto first = adapter->prepare(insertSQL);
+    first.addBindValue("alpha");
+    EXPECT_TRUE(first.exec());
+    
+    // 同一 SQL 再次准备应命中缓存，并可重新绑定参数
+    auto second = adapter->prepare(insertSQL);
+    second.addBindValue("beta");
+    EXPECT_TRUE(second.exec());
+    
+    auto stats = adapter->statementCacheStats();
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.size, 1);
+    
+    // 未读完的查询再次准备时应被复位
+    auto select = adapter->prepare("SELECT name FROM test_cache WHERE id = ?");
+    select.addBindValue(1);
+    ASSERT_TRUE(select.exec());
+    ASSERT_TRUE(select.next());
+    EXPECT_EQ(select.value("name").toString(), QString("alpha"));
+    
+    select = adapter->prepare("SELECT name FROM test_cache WHERE id = ?");
+    select.addBindValue(2);
+    ASSERT_TRUE(select.exec());
+    ASSERT_TRUE(select.next());
+    EXPECT_EQ(select.value("name").toString(), QString("beta"));
+}
+
+// ============================================
+// 测试：预处理语句缓存容量淘汰
+// ============================================
+TEST_F(SQLiteAdapterTest, StatementCacheEviction) {
+    ASSERT_TRUE(adapter->open());
+    adapter->setStatementCacheCapacity(2);
+    
+    adapter->prepare("SELECT 1");
+    adapter->prepare("SELECT 2");
+    adapter->prepare("SELECT 1");   // 刷新 LRU
+    adapter->prepare("SELECT 3");   // 淘汰 "SELECT 2"
+    adapter->prepare("SELECT 1");   // 仍然命中
+    
+    auto stats = adapter->statementCacheStats();
+    EXPECT_EQ(stats.size, 2);
+    EXPECT_EQ(stats.capacity, 2);
+    EXPECT_EQ(stats.evictions, 1u);
+    EXPECT_EQ(stats.hits, 2u);
+    EXPECT_EQ(stats.misses, 3u);
+}
+
+// ============================================
+// 测试：SQL 执行统计与慢查询日志
+// ============================================
+TEST_F(SQLiteAdapterTest, QueryStatsAndSlowLog) {
+    ASSERT_TRUE(adapter->open());
+    ASSERT_TRUE(adapter->execute("CREATE TABLE items (id INTEGER PRIMARY KEY, name TEXT)"));
+    adapter->profiler().reset();
+    
+    for (int i = 0; i < 10; ++i) {
+        auto insert = adapter->prepare("INSERT INTO items (name) VALUES (?)");
+        insert.addBindValue(QString("item%1").arg(i));
+        ASSERT_TRUE(adapter->exec(insert));
+    }
+    
+    auto stats = adapter->profiler().statementStats();
+    ASSERT_EQ(stats.size(), 1);
+    EXPECT_EQ(stats[0].sql, QString("INSERT INTO items (name) VALUES (?)"));
+    EXPECT_EQ(stats[0].count, 10u);
+    EXPECT_EQ(stats[0].rowsAffected, 10u);
+    EXPECT_LE(stats[0].p50Us, stats[0].p95Us);
+    EXPECT_LE(stats[0].p95Us, stats[0].p99Us);
+    EXPECT_LE(stats[0].p99Us, stats[0].maxUs);
+    
+    // 阈值为 0：每条语句都记入慢查询，附带参数与查询计划
+    adapter->profiler().setSlowQueryThreshold(0);
+    auto select = adapter->prepare("SELECT name FROM items WHERE id = ?");
+    select.addBindValue(3);
+    ASSERT_TRUE(adapter->exec(select));
+    
+    auto slow = adapter->profiler().slowQueries();
+    ASSERT_EQ(slow.size(), 1);
+    ASSERT_EQ(slow[0].boundValues.size(), 1);
+    EXPECT_EQ(slow[0].boundValues[0].toInt(), 3);
+    ASSERT_FALSE(slow[0].plan.isEmpty());
+    EXPECT_TRUE(slow[0].plan.first().contains("items"));
+    
+    // 返回行数由读取方读完结果集后上报
+    adapter->profiler().reset();
+    auto all = adapter->prepare("SELECT name FROM items");
+    ASSERT_TRUE(adapter->exec(all));
+    int rows = 0;
+    while (all.next()) {
+        ++rows;
+    }
+    adapter->recordRowsReturned(all, rows);
+    
+    stats = adapter->profiler().statementStats();
+    ASSERT_EQ(stats.size(), 1);
+    EXPECT_EQ(stats[0].rowsReturned, 10u);
+    EXPECT_EQ(stats[0].rowsAffected, 0u);
+    
+    // 字面量与 IN 列表归一化后合并为同一条统计
+    EXPECT_EQ(QueryProfiler::normalizeSql("SELECT * FROM words\n WHERE id IN (?, ?, ?) AND word = 'a''b';"),
+              QString("SELECT * FROM words WHERE id IN (...) AND word = ?"));
+    EXPECT_EQ(QueryProfiler::normalizeSql("PRAGMA user_version = 12"),
+              QString("PRAGMA user_version = ?"));
+}
+
+// ============================================
+// 测试：存储参数配置
+// ============================================
+TEST_F(SQLiteAdapterTest, StorageProfile) {
+    QString dbPath = QDir::temp().filePath("test_storage_profile.db");
+    QFile::remove(dbPath);
+    
+    auto pragma = [](SQLiteAdapter& db, const QString& name) {
+        QSqlQuery query = db.query("PRAGMA " + name);
+        return query.next() ? query.value(0).toLongLong() : -1;
+    };
+    
+    {
+        SQLiteAdapter db(dbPath);
+        db.setStorageProfile(StorageProfile::bulkImport());
+        ASSERT_TRUE(db.open());
+        ASSERT_TRUE(db.execute("CREATE TABLE items (id INTEGER PRIMARY KEY)"));
+        
+        // 新建数据库按配置的页大小创建
+        EXPECT_EQ(db.pageSize(), 8192);
+        EXPECT_EQ(pragma(db, "cache_size"), -64 * 1024);
+        EXPECT_EQ(pragma(db, "temp_store"), 2);          // MEMORY
+        EXPECT_EQ(pragma(db, "wal_autocheckpoint"), 10000);
+        
+        // 打开后切换配置立即生效，页大小保持不变
+        ASSERT_TRUE(db.setStorageProfile(StorageProfile::lowMemory()));
+        EXPECT_EQ(pragma(db, "cache_size"), -2 * 1024);
+        EXPECT_EQ(pragma(db, "mmap_size"), 0);
+        EXPECT_EQ(db.pageSize(), 8192);
+        
+        // VACUUM 重建后页大小与配置一致，仍为 WAL 模式
+        ASSERT_TRUE(db.rebuildWithPageSize());
+        EXPECT_EQ(db.pageSize(), 4096);
+        QSqlQuery mode = db.query("PRAGMA journal_mode");
+        ASSERT_TRUE(mode.next());
+        EXPECT_EQ(mode.value(0).toString(), QString("wal"));
+    }
+    
+    bool ok = true;
+    StorageProfile::byName("no-such-profile", &ok);
+    EXPECT_FALSE(ok);
+    EXPECT_EQ(StorageProfile::byName("Low-Memory").name, QString("low-memory"));
+    
+    QFile::remove(dbPath);
+    QFile::remove(dbPath + "-wal");
+    QFile::remove(dbPath + "-shm");
+}
+
 // ============================================
 // 测试：数据库初始化
 // ============================================
@@ -284,6 +503,38 @@ TEST_F(SQLiteAdapterTest, InitializeDatabase) {
     QFile::remove(tempFile);
 }
 
+#ifdef WORDMASTER_NATIVE_SQLITE
+// ============================================
+// 测试：原生语句缓存淘汰时跳过仍被持有的语句
+// ============================================
+TEST_F(SQLiteAdapterTest, NativeStatementEvictionSkipsHeldStatements) {
+    ASSERT_TRUE(adapter->open());
+    if (!adapter->isNativeBackendAvailable()) {
+        GTEST_SKIP() << "Qt driver and linked SQLite differ";
+    }
+    adapter->setStatementCacheCapacity(1);
+    
+    // 缓存已满且唯一的语句仍被持有：暂时超出容量，不释放
+    NativeStatement first = adapter->prepareNative("SELECT 1");
+    ASSERT_TRUE(first.isValid());
+    {
+        NativeStatement second = adapter->prepareNative("SELECT 2");
+        ASSERT_TRUE(second.isValid());
+        ASSERT_TRUE(second.next());
+        EXPECT_EQ(second.columnInt(0), 2);
+    }
+    ASSERT_TRUE(first.next());
+    EXPECT_EQ(first.columnInt(0), 1);
+    
+    // "SELECT 1" 仍被持有，淘汰的是已释放的 "SELECT 2"
+    NativeStatement third = adapter->prepareNative("SELECT 3");
+    ASSERT_TRUE(third.next());
+    EXPECT_EQ(third.columnInt(0), 3);
+    EXPECT_FALSE(first.next());
+    EXPECT_FALSE(first.hasError());
+}
+#endif
+
 // ============================================
 // 主函数
 // ============================================
@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+#include "application/services/word_book_reader.h"
+#include "application/services/decompressing_device.h"
+#include <QBuffer>
+
+using namespace WordMaster::Application;
+using namespace WordMaster::Domain;
+
+/**
+ * @brief WordBookReader 单元测试
+ *
+ * 测试目标：
+ * 1. 元素跨越读取块边界时仍能正确切分（字符串中的括号、转义引号）
+ * 2. 跳过非对象元素与缺少单词的对象
+ * 3. 文件不完整或格式错误时报告失败
+ * 4. 回调返回false时停止读取
+ * 5. 字符串转义解码、嵌套字段保留原文、可选校验
+ * 6. 压缩输入流式解压，截断时报告失败
+ */
+class WordBookReaderTest : public ::testing::Test {
+protected:
+    bool readAll(const QByteArray& json, int chunkSize, QList<Word>& words,
+                 WordBookReader& reader) {
+        QBuffer buffer;
+        buffer.setData(json);
+        buffer.open(QIODevice::ReadOnly);
+
+        reader.setChunkSize(chunkSize);
+        return reader.read(buffer, [&words](const Word& word) {
+            words.append(word);
+            return true;
+        });
+    }
+
+    const QByteArray sample =
+        "\xEF\xBB\xBF[\n"
+        "  {\"id\": 1, \"word\": \"brace\", \"phonetic0\": \"breɪs\",\n"
+        "   \"trans\": [{\"pos\": \"n.\", \"cn\": \"括号 } 与 ]\"}]},\n"
+        "  {\"id\": 2, \"word\": \"quote\",\n"
+        "   \"sentences\": [{\"c\": \"He said \\\"{hi}\\\".\", \"cn\": \"他说“嗨”。\"}],\n"
+        "   \"relWords\": {\"root\": \"quote\", \"rels\": []}},\n"
+        "  42,\n"
+        "  {\"id\": 3},\n"
+        "  {\"id\": 4, \"word\": \"last\"}\n"
+        "]\n";
+};
+
+// ============================================
+// 测试：任意块大小结果一致
+// ============================================
+TEST_F(WordBookReaderTest, SplitsItemsAcrossChunks) {
+    for (int chunkSize : {1, 3, 7, 64, WordBookReader::kDefaultChunkSize}) {
+        WordBookReader reader("test");
+        QList<Word> words;
+        ASSERT_TRUE(readAll(sample, chunkSize, words, reader)) << chunkSize;
+
+        ASSERT_EQ(words.size(), 3) << chunkSize;
+        EXPECT_EQ(reader.wordCount(), 3);
+        EXPECT_EQ(reader.skippedCount(), 2);
+
+        EXPECT_EQ(words[0].word, "brace");
+        EXPECT_EQ(words[0].bookId, "test");
+        EXPECT_EQ(words[0].phoneticUk, QString::fromUtf8("breɪs"));
+        EXPECT_TRUE(words[0].translations.contains(QString::fromUtf8("括号 } 与 ]")));
+
+        EXPECT_EQ(words[1].wordId, 2);
+        EXPECT_TRUE(words[1].sentences.contains("{hi}"));
+        EXPECT_TRUE(words[1].relatedWords.contains("\"root\""));
+
+        EXPECT_EQ(words[2].word, "last");
+    }
+}
+
+// ============================================
+// 测试：格式错误
+// ============================================
+TEST_F(WordBookReaderTest, ReportsMalformedInput) {
+    QList<Word> words;
+
+    WordBookReader notArray("test");
+    EXPECT_FALSE(readAll("{\"id\": 1}", 16, words, notArray));
+    EXPECT_FALSE(notArray.errorString().isEmpty());
+
+    WordBookReader truncated("test");
+    EXPECT_FALSE(readAll("[{\"id\": 1, \"word\": \"a\"}, {\"id\": 2, \"wo", 16, words, truncated));
+    EXPECT_EQ(truncated.wordCount(), 1);
+
+    WordBookReader empty("test");
+    EXPECT_FALSE(readAll("", 16, words, empty));
+
+    WordBookReader emptyArray("test");
+    EXPECT_TRUE(readAll(" [ ] ", 16, words, emptyArray));
+    EXPECT_EQ(emptyArray.wordCount(), 0);
+}
+
+// ============================================
+// 测试：回调中止
+// ============================================
+TEST_F(WordBookReaderTest, HandlerCanAbort) {
+    QBuffer buffer;
+    buffer.setData(sample);
+    buffer.open(QIODevice::ReadOnly);
+
+    WordBookReader reader("test");
+    int seen = 0;
+    bool ok = reader.read(buffer, [&seen](const Word&) {
+        return ++seen < 2;
+    });
+
+    EXPECT_FALSE(ok);
+    EXPECT_EQ(seen, 2);
+}
+
+// ============================================
+// 测试：字段解析
+// ============================================
+TEST_F(WordBookReaderTest, ParsesFieldsWithoutReserializing) {
+    const QByteArray item =
+        "{\"id\": 7.0, \"word\": \"caf\\u00e9\\n\\\"x\\\"\", \"phonetic1\": null,\n"
+        " \"extra\": {\"trans\": 1},\n"
+        " \"trans\": [ {\"cn\": \"\\ud83d\\ude00\"} ], \"synos\": null}";
+
+    Word word;
+    ASSERT_TRUE(WordBookReader::parseItem("test", item, word));
+    EXPECT_EQ(word.wordId, 7);
+    EXPECT_EQ(word.word, QString::fromUtf8("café\n\"x\""));
+    EXPECT_TRUE(word.phoneticUs.isEmpty());
+
+    // 嵌套字段是源文本原样截取（含空白），未出现的字段为空
+    EXPECT_EQ(word.translations, "[ {\"cn\": \"\\ud83d\\ude00\"} ]");
+    EXPECT_EQ(word.synonyms, "[]");
+    EXPECT_TRUE(word.sentences.isEmpty());
+
+    const QByteArray broken = "{\"id\": 1, \"word\": \"a\", \"trans\": [1 2]}";
+    EXPECT_TRUE(WordBookReader::parseItem("test", broken, word));
+    EXPECT_FALSE(WordBookReader::parseItem("test", broken, word, true));
+}
+
+// ============================================
+// 测试：压缩输入
+// ============================================
+TEST_F(WordBookReaderTest, ReadsCompressedInput) {
+    if (!DecompressingDevice::isSupported(DecompressingDevice::Compression::Gzip)) {
+        GTEST_SKIP() << "built without zlib";
+    }
+
+    EXPECT_EQ(DecompressingDevice::compressionForPath("cet4.json.gz"),
+              DecompressingDevice::Compression::Gzip);
+    EXPECT_EQ(DecompressingDevice::compressionForPath("cet4.json.zst"),
+              DecompressingDevice::Compression::Zstd);
+
+    // qCompress 输出 4 字节长度 + zlib 流；解码器同时识别 zlib 与 gzip 头
+    const QByteArray compressed = qCompress(sample, 9).mid(4);
+
+    for (int length : {compressed.size(), compressed.size() - 4}) {
+        QBuffer buffer;
+        buffer.setData(compressed.left(length));
+        buffer.open(QIODevice::ReadOnly);
+
+        DecompressingDevice device(&buffer, DecompressingDevice::Compression::Gzip);
+        ASSERT_TRUE(device.open(QIODevice::ReadOnly));
+
+        WordBookReader reader("test");
+        reader.setChunkSize(7);
+        bool ok = reader.read(device, [](const Word&) { return true; });
+
+        if (length == compressed.size()) {
+            EXPECT_TRUE(ok);
+            EXPECT_EQ(reader.wordCount(), 3);
+            EXPECT_TRUE(device.atEnd());
+        } else {
+            EXPECT_FALSE(ok);
+            EXPECT_TRUE(device.hasError());
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include "application/services/word_pack.h"
+#include <QTemporaryDir>
+#include <QFile>
+#include <QtEndian>
+
+using namespace WordMaster::Application;
+using namespace WordMaster::Domain;
+
+/**
+ * @brief WordPack 单元测试
+ *
+ * 测试目标：
+ * 1. 编译后的词库包与 JSON 读取结果一致，内容哈希与 Word::contentHash() 一致
+ * 2. 按原始ID二分查找；重复的 word_id 以后出现的为准
+ * 3. 截断或损坏的词库包打开失败
+ */
+class WordPackTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_TRUE(dir_.isValid());
+        jsonPath_ = dir_.filePath("book.json");
+        packPath_ = dir_.filePath("book.wmpack");
+
+        QFile file(jsonPath_);
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        file.write(
+            "[\n"
+            "  {\"id\": 30, \"word\": \"zebra\", \"phonetic0\": \"ˈzebrə\", \"trans\": []},\n"
+            "  {\"id\": 10, \"word\": \"apple\", \"sentences\": [{\"c\": \"An apple.\"}]},\n"
+            "  {\"id\": 20, \"word\": \"old\"},\n"
+            "  {\"id\": 20, \"word\": \"mango\", \"trans\": []}\n"
+            "]\n");
+    }
+
+    QByteArray readPack() {
+        QFile file(packPath_);
+        file.open(QIODevice::ReadOnly);
+        return file.readAll();
+    }
+
+    void writePack(const QByteArray& data) {
+        QFile file(packPath_);
+        file.open(QIODevice::WriteOnly | QIODevice::Truncate);
+        file.write(data);
+    }
+
+    QTemporaryDir dir_;
+    QString jsonPath_;
+    QString packPath_;
+};
+
+// ============================================
+// 测试：编译与读取
+// ============================================
+TEST_F(WordPackTest, CompilesAndLooksUpWords) {
+    EXPECT_TRUE(WordPack::isPackPath(packPath_));
+    EXPECT_FALSE(WordPack::isPackPath(jsonPath_));
+
+    QString error;
+    int wordCount = 0;
+    ASSERT_TRUE(WordPack::compile(jsonPath_, packPath_, &error, &wordCount)) << qPrintable(error);
+    EXPECT_EQ(wordCount, 3);
+
+    WordPack pack;
+    ASSERT_TRUE(pack.open(packPath_)) << qPrintable(pack.errorString());
+    ASSERT_EQ(pack.count(), 3);
+
+    // 记录保持文件中首次出现的顺序
+    EXPECT_EQ(pack.wordIdAt(0), 30);
+    EXPECT_EQ(pack.wordIdAt(1), 10);
+    EXPECT_EQ(pack.wordIdAt(2), 20);
+
+    Word zebra = pack.wordAt(pack.indexOf(30), "book");
+    EXPECT_EQ(zebra.bookId, "book");
+    EXPECT_EQ(zebra.word, "zebra");
+    EXPECT_EQ(zebra.phoneticUk, QString::fromUtf8("ˈzebrə"));
+    EXPECT_EQ(zebra.translations, "[]");
+    EXPECT_EQ(pack.contentHashAt(0), zebra.contentHash());
+
+    Word apple = pack.wordAt(pack.indexOf(10), "book");
+    EXPECT_EQ(apple.word, "apple");
+    EXPECT_TRUE(apple.sentences.contains("An apple."));
+
+    EXPECT_EQ(pack.wordAt(pack.indexOf(20), "book").word, "mango");
+    EXPECT_EQ(pack.indexOf(15), -1);
+}
+
+// ============================================
+// 测试：损坏的词库包
+// ============================================
+TEST_F(WordPackTest, RejectsCorruptPacks) {
+    ASSERT_TRUE(WordPack::compile(jsonPath_, packPath_));
+    const QByteArray valid = readPack();
+
+    WordPack pack;
+
+    writePack(valid.left(valid.size() - 1));
+    EXPECT_FALSE(pack.open(packPath_));
+    EXPECT_FALSE(pack.isOpen());
+
+    QByteArray badMagic = valid;
+    badMagic[0] = 'X';
+    writePack(badMagic);
+    EXPECT_FALSE(pack.open(packPath_));
+
+    // 第一条记录的单词长度指向字符串表之外
+    QByteArray badReference = valid;
+    qToLittleEndian<quint32>(0x7FFFFFFF, reinterpret_cast<uchar*>(badReference.data())
+                             + WordPack::kHeaderSize + 28);
+    writePack(badReference);
+    EXPECT_FALSE(pack.open(packPath_));
+
+    writePack(valid);
+    EXPECT_TRUE(pack.open(packPath_));
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -5,6 +5,8 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <QFile>
+#include <QSqlQuery>
 
 using namespace WordMaster::Domain;
 using namespace WordMaster::Infrastructure;
@@ -64,6 +66,27 @@ protected:
         return w;
     }
     
+    // 执行建立全文索引的迁移（008），并重建仓储以重新检测索引；SQLite 不含 FTS5 时返回 false
+    bool applySearchMigration() {
+        QFile file(QString(WORDMASTER_SCHEMA_DIR) + "/008_word_search.sql");
+        if (!file.open(QIODevice::ReadOnly)) {
+            return false;
+        }
+        const QString sql = QString::fromUtf8(file.readAll());
+        for (const QString& statement : SQLiteAdapter::splitSqlStatements(sql)) {
+            if (!adapter->execute(statement)) {
+                return false;
+            }
+        }
+        repository = std::make_unique<WordRepository>(*adapter);
+        return true;
+    }
+    
+    int countSearchRows() {
+        QSqlQuery query = adapter->query("SELECT COUNT(*) FROM word_search");
+        return query.next() ? query.value(0).toInt() : -1;
+    }
+    
     std::unique_ptr<SQLiteAdapter> adapter;
     std::unique_ptr<BookRepository> bookRepo;
     std::unique_ptr<WordRepository> repository;
@@ -166,6 +189,16 @@ TEST_F(WordRepositoryTest, SearchByWord) {
     EXPECT_EQ(results.size(), 2);
     EXPECT_TRUE(results[0].word.contains("app") || 
                 results[1].word.contains("app"));
+    
+    // 前缀不区分大小写，以 Z 结尾的大写前缀同样命中
+    repository->save(createTestWord(4, "zebra"));
+    repository->save(createTestWord(5, "jazz"));
+    
+    EXPECT_EQ(repository->searchByWord("APP").size(), 2);
+    ASSERT_EQ(repository->searchByWord("Z").size(), 1);
+    EXPECT_EQ(repository->searchByWord("Z")[0].word, "zebra");
+    ASSERT_EQ(repository->searchByWord("JAZZ").size(), 1);
+    EXPECT_EQ(repository->searchByWord("JAZZ")[0].word, "jazz");
 }
 
 // ============================================
@@ -224,6 +257,149 @@ TEST_F(WordRepositoryTest, SaveBatch) {
     EXPECT_EQ(retrieved.size(), 100);
 }
 
+// ============================================
+// 测试：多行 INSERT 批量写入
+// ============================================
+TEST_F(WordRepositoryTest, SaveBatchUsesMultiRowInsert) {
+    // Arrange - words 1 组 142 行 + 58 行余数，word_details 1 组 124 行 + 76 行余数；
+    // 第 200 个与第 1 个 word_id 相同，word_translations 去重后 1 组 166 行 + 33 行余数
+    QList<Word> words;
+    for (int i = 1; i <= 199; ++i) {
+        words.append(createTestWord(i, QString("bulk%1").arg(i)));
+    }
+    words.append(createTestWord(1, "bulk1-last"));
+    
+    // Act
+    ASSERT_TRUE(repository->saveBatch(words));
+    
+    // Assert - 重复的 word_id 以后出现的为准
+    QList<Word> retrieved = repository->getByBookId("test_cet4");
+    ASSERT_EQ(retrieved.size(), 199);
+    EXPECT_EQ(retrieved[0].word, "bulk1-last");
+    EXPECT_EQ(retrieved[198].word, "bulk199");
+    EXPECT_EQ(retrieved[198].translations, words[198].translations);
+    
+    WordRepository::BulkLoadStats stats = repository->bulkLoadStats();
+    EXPECT_EQ(stats.rows, 200u);
+    EXPECT_EQ(stats.statements, 170u);
+    EXPECT_GT(stats.rowsPerSecond(), 0.0);
+}
+
+// ============================================
+// 测试：Summary 只读热数据，详情按需补读
+// ============================================
+TEST_F(WordRepositoryTest, SummaryProjectionSkipsDetails) {
+    // Arrange
+    Word word = createTestWord(1, "hot");
+    ASSERT_TRUE(repository->save(word));
+    int id = repository->getByBookAndWord("test_cet4", "hot").id;
+    ASSERT_GT(id, 0);
+    
+    // Act
+    Word summary = repository->getById(id, WordProjection::Summary);
+    QList<Word> listed = repository->getByBookId("test_cet4", -1, 0, WordProjection::Summary);
+    
+    // Assert - 简释由释义生成，JSON 字段为空
+    EXPECT_EQ(summary.word, "hot");
+    EXPECT_EQ(summary.phoneticUk, "/test/");
+    EXPECT_EQ(summary.gloss, QString::fromUtf8("测试"));
+    EXPECT_TRUE(summary.translations.isEmpty());
+    EXPECT_TRUE(summary.sentences.isEmpty());
+    ASSERT_EQ(listed.size(), 1);
+    EXPECT_TRUE(listed[0].translations.isEmpty());
+    
+    ASSERT_TRUE(repository->loadDetails(summary));
+    EXPECT_EQ(summary.translations, word.translations);
+    EXPECT_EQ(summary.sentences, "[]");
+    
+    // 删除单词时详情随之删除
+    ASSERT_TRUE(repository->remove(id));
+    Word missing;
+    missing.id = id;
+    EXPECT_FALSE(repository->loadDetails(missing));
+}
+
+// ============================================
+// 测试：释义、例句、短语写入结构化子表
+// ============================================
+TEST_F(WordRepositoryTest, StructuredFieldsAreQueryable) {
+    // Arrange
+    Word verb = createTestWord(1, "run");
+    verb.translations = QString::fromUtf8(
+        R"([{"pos":"v.","cn":"跑"},{"pos":"n.","cn":"跑步"}])");
+    verb.sentences = QString::fromUtf8(R"([{"c":"I run.","cn":"我跑步。"}])");
+    verb.phrases = QString::fromUtf8(R"([{"c":"run out","cn":"用完"}])");
+    Word noun = createTestWord(2, "desk");
+    ASSERT_TRUE(repository->saveBatch(QList<Word>() << verb << noun));
+    int verbId = repository->getByBookAndWord("test_cet4", "run").id;
+    int nounId = repository->getByBookAndWord("test_cet4", "desk").id;
+    
+    // Assert - 保持词库文件中的顺序
+    QList<WordTranslation> translations = repository->getTranslations(verbId);
+    ASSERT_EQ(translations.size(), 2);
+    EXPECT_EQ(translations[0].pos, "v.");
+    EXPECT_EQ(translations[0].meaning, QString::fromUtf8("跑"));
+    EXPECT_EQ(translations[1].meaning, QString::fromUtf8("跑步"));
+    
+    QList<WordSentence> sentences = repository->getSentences(verbId);
+    ASSERT_EQ(sentences.size(), 1);
+    EXPECT_EQ(sentences[0].english, "I run.");
+    EXPECT_EQ(sentences[0].chinese, QString::fromUtf8("我跑步。"));
+    ASSERT_EQ(repository->getPhrases(verbId).size(), 1);
+    EXPECT_EQ(repository->getPhrases(verbId)[0].phrase, "run out");
+    EXPECT_TRUE(repository->getSentences(nounId).isEmpty());
+    
+    EXPECT_EQ(repository->getWordIdsByPos("test_cet4", QStringList() << "v." << "vt."),
+              QList<int>() << verbId);
+    EXPECT_EQ(repository->getWordIdsByPos("test_cet4", QStringList() << "n."),
+              QList<int>() << verbId << nounId);
+    
+    // 更新时子表整体替换
+    verb.id = verbId;
+    verb.translations = QString::fromUtf8(R"([{"pos":"n.","cn":"奔跑"}])");
+    ASSERT_TRUE(repository->update(verb));
+    translations = repository->getTranslations(verbId);
+    ASSERT_EQ(translations.size(), 1);
+    EXPECT_EQ(translations[0].meaning, QString::fromUtf8("奔跑"));
+    EXPECT_TRUE(repository->getWordIdsByPos("test_cet4", QStringList() << "v.").isEmpty());
+    
+    // 子表为空即没有释义，不再解析 JSON
+    ASSERT_TRUE(adapter->execute("DELETE FROM word_translations"));
+    EXPECT_TRUE(repository->getTranslations(nounId).isEmpty());
+}
+
+// ============================================
+// 测试：补建子表启用前导入的单词
+// ============================================
+TEST_F(WordRepositoryTest, StructuredFieldsBackfill) {
+    // Arrange - 模拟 006 之前导入：只有 word_details，迁移 009 记录待补建（含已删除的单词）
+    Word noun = createTestWord(1, "desk");
+    ASSERT_TRUE(repository->save(noun));
+    int nounId = repository->getByBookAndWord("test_cet4", "desk").id;
+    ASSERT_TRUE(adapter->execute("DELETE FROM word_translations"));
+    ASSERT_TRUE(adapter->execute(QString("INSERT INTO structured_backfill (word_id) "
+                                         "VALUES (%1), (%2)").arg(nounId).arg(nounId + 100)));
+    
+    // 补建前：按词性查不到，读取释义时解析 JSON
+    EXPECT_EQ(repository->structuredBackfillRemaining(), 2);
+    EXPECT_TRUE(repository->getWordIdsByPos("test_cet4", QStringList() << "n.").isEmpty());
+    QList<WordTranslation> translations = repository->getTranslations(nounId);
+    ASSERT_EQ(translations.size(), 1);
+    EXPECT_EQ(translations[0].meaning, QString::fromUtf8("测试"));
+    
+    // Act - 每次补建一个
+    EXPECT_EQ(repository->backfillStructuredFields(1), 1);
+    EXPECT_EQ(repository->backfillStructuredFields(1), 0);
+    
+    // Assert
+    EXPECT_EQ(repository->structuredBackfillRemaining(), 0);
+    EXPECT_EQ(repository->getWordIdsByPos("test_cet4", QStringList() << "n."),
+              QList<int>() << nounId);
+    translations = repository->getTranslations(nounId);
+    ASSERT_EQ(translations.size(), 1);
+    EXPECT_EQ(translations[0].meaning, QString::fromUtf8("测试"));
+}
+
 // ============================================
 // 测试：批量保存事务回滚
 // ============================================
@@ -295,6 +471,211 @@ TEST_F(WordRepositoryTest, GetByIds) {
     EXPECT_EQ(words.size(), 3);
 }
 
+// ============================================
+// 测试：超过一组的 id 按参数顺序返回
+// ============================================
+TEST_F(WordRepositoryTest, GetByIdsPreservesOrderAcrossChunks) {
+    // Arrange - 600 个 id 分三组，末组补齐
+    QList<Word> batch;
+    for (int i = 1; i <= 600; ++i) {
+        batch.append(createTestWord(i, QString("chunk%1").arg(i)));
+    }
+    ASSERT_TRUE(repository->saveBatch(batch));
+    
+    QList<int> ids;
+    for (const Word& word : repository->getByBookId("test_cet4", -1, 0, WordProjection::Summary)) {
+        ids.prepend(word.id);
+    }
+    ASSERT_EQ(ids.size(), 600);
+    
+    // 倒序，加一个重复 id 和一个不存在的 id
+    QList<int> requested = ids;
+    requested.insert(300, ids.first());
+    requested.append(999999);
+    
+    // Act
+    QList<Word> words = repository->getByIds(requested, WordProjection::Summary);
+    
+    // Assert
+    ASSERT_EQ(words.size(), 600);
+    for (int i = 0; i < words.size(); ++i) {
+        ASSERT_EQ(words[i].id, ids[i]);
+    }
+    EXPECT_EQ(words.first().word, "chunk600");
+}
+
+// ============================================
+// 测试：压缩详情字段后读取结果不变
+// ============================================
+TEST_F(WordRepositoryTest, CompressedDetailsReadTransparently) {
+    // Arrange - 足够训练字典的样本
+    QList<Word> words;
+    for (int i = 1; i <= 400; ++i) {
+        Word word = createTestWord(i, QString("compress%1").arg(i));
+        word.translations = QString::fromUtf8(
+            R"([{"pos":"v.","tranCn":"压缩；缩短 %1"},{"pos":"n.","tranCn":"压缩机 %1"}])").arg(i);
+        word.sentences = QString::fromUtf8(
+            R"([{"c":"Sentence %1 shows how the word is used.","cn":"第 %1 个例句。"}])").arg(i);
+        words.append(word);
+    }
+    ASSERT_TRUE(repository->saveBatch(words));
+    Word expected = repository->getByBookAndWord("test_cet4", "compress7");
+
+    if (!DetailCodec::isAvailable()) {
+        EXPECT_FALSE(repository->compressDetails("test_cet4"));
+        EXPECT_EQ(repository->getById(expected.id).sentences, expected.sentences);
+        return;
+    }
+
+    // Act
+    ASSERT_TRUE(repository->compressDetails("test_cet4"));
+
+    // Assert
+    WordRepository::DetailCompressionStats stats = repository->compressionStats();
+    EXPECT_EQ(stats.rows, 400);
+    EXPECT_GT(stats.dictionaryBytes, 0);
+    EXPECT_GT(stats.ratio(), 1.0);
+
+    QSqlQuery query = adapter->query(
+        "SELECT COUNT(*) FROM word_details WHERE typeof(sentences) = 'blob'");
+    ASSERT_TRUE(query.next());
+    EXPECT_EQ(query.value(0).toInt(), 400);
+    query.finish();
+
+    // 新的仓储按需加载字典
+    WordRepository reader(*adapter);
+    Word actual = reader.getById(expected.id);
+    EXPECT_EQ(actual.translations, expected.translations);
+    EXPECT_EQ(actual.sentences, expected.sentences);
+    EXPECT_EQ(actual.synonyms, expected.synonyms);
+
+    Word details;
+    details.id = expected.id;
+    ASSERT_TRUE(reader.loadDetails(details));
+    EXPECT_EQ(details.sentences, expected.sentences);
+
+    // 之后写入的单词保持 TEXT，再次压缩时复用已有字典
+    Word added = createTestWord(401, "compress401");
+    added.sentences = words[0].sentences;
+    ASSERT_TRUE(repository->save(added));
+    ASSERT_TRUE(repository->compressDetails("test_cet4"));
+    EXPECT_EQ(repository->compressionStats().rows, 1);
+    EXPECT_EQ(repository->compressionStats().dictionaryBytes, 0);
+    EXPECT_EQ(reader.getByBookAndWord("test_cet4", "compress401").sentences, added.sentences);
+}
+
+// ============================================
+// 测试：全文搜索单词、中文释义与例句
+// ============================================
+TEST_F(WordRepositoryTest, FullTextSearch) {
+    if (!applySearchMigration()) {
+        GTEST_SKIP() << "SQLite is built without FTS5";
+    }
+
+    // Arrange
+    Book other;
+    other.id = "test_cet6";
+    other.name = "Test CET-6";
+    other.url = "test6.json";
+    ASSERT_TRUE(bookRepo->save(other));
+
+    Word abandon = createTestWord(1, "abandon");
+    abandon.translations = QString::fromUtf8(R"([{"pos":"v.","cn":"放弃；抛弃"}])");
+    abandon.sentences = QString::fromUtf8(
+        R"([{"c":"They had to give up and abandon the car.","cn":"他们只好弃车。"}])");
+    Word ability = createTestWord(2, "ability");
+    ability.translations = QString::fromUtf8(R"([{"pos":"n.","cn":"能力；才能"}])");
+    Word give = createTestWord(3, "give");
+    give.bookId = "test_cet6";
+    give.phrases = QString::fromUtf8(R"([{"c":"give up","cn":"放弃"}])");
+    ASSERT_TRUE(repository->saveBatch(QList<Word>() << abandon << ability << give));
+
+    // Act & Assert - 英文前缀
+    QList<WordSearchHit> hits = repository->search("ab");
+    ASSERT_EQ(hits.size(), 2);
+    EXPECT_TRUE(hits[0].snippet.contains(WordSearchHit::kMatchBegin));
+    EXPECT_FALSE(hits[0].word.gloss.isEmpty());
+
+    // 单词本身命中的排在例句命中之前
+    hits = repository->search("give");
+    ASSERT_EQ(hits.size(), 2);
+    EXPECT_EQ(hits[0].word.word, "give");
+    EXPECT_EQ(hits[1].word.word, "abandon");
+    EXPECT_LT(hits[0].score, hits[1].score);
+
+    // 中文按字匹配多字短语，片段中不含分隔符
+    hits = repository->search(QString::fromUtf8("放弃"), "test_cet4");
+    ASSERT_EQ(hits.size(), 1);
+    EXPECT_EQ(WordSearchHit::highlight(hits[0].snippet, "[", "]"),
+              QString::fromUtf8("[放弃]；抛弃"));
+    EXPECT_EQ(repository->search(QString::fromUtf8("放弃")).size(), 2);
+    EXPECT_TRUE(repository->search(QString::fromUtf8("弃放")).isEmpty());
+
+    // 例句与按词库过滤
+    EXPECT_EQ(repository->search(QString::fromUtf8("弃车")).size(), 1);
+    EXPECT_EQ(repository->search("car", "test_cet6").size(), 0);
+    hits = repository->search(QString::fromUtf8("放弃"), "test_cet6");
+    ASSERT_EQ(hits.size(), 1);
+    EXPECT_EQ(hits[0].word.word, "give");
+
+    // 查询语法字符按普通文本处理
+    EXPECT_TRUE(repository->search("\"* OR (").isEmpty());
+
+    // 更新与删除同步到索引
+    Word updated = repository->getByBookAndWord("test_cet4", "ability");
+    updated.translations = QString::fromUtf8(R"([{"pos":"n.","cn":"本领"}])");
+    ASSERT_TRUE(repository->update(updated));
+    EXPECT_TRUE(repository->search(QString::fromUtf8("才能")).isEmpty());
+    EXPECT_EQ(repository->search(QString::fromUtf8("本领")).size(), 1);
+
+    ASSERT_TRUE(repository->removeByBookId("test_cet6"));
+    EXPECT_EQ(repository->search(QString::fromUtf8("放弃")).size(), 1);
+    ASSERT_TRUE(repository->rebuildSearchIndex());
+    EXPECT_EQ(repository->search("ab").size(), 2);
+}
+
+// ============================================
+// 测试：迁移前已有的单词分批补建索引，替换单词不遗留旧行
+// ============================================
+TEST_F(WordRepositoryTest, SearchIndexBackfill) {
+    // Arrange - 迁移前已有 3 个单词
+    ASSERT_TRUE(repository->saveBatch(QList<Word>() << createTestWord(1, "abandon")
+                                                    << createTestWord(2, "ability")
+                                                    << createTestWord(3, "able")));
+    if (!applySearchMigration()) {
+        GTEST_SKIP() << "SQLite is built without FTS5";
+    }
+    EXPECT_EQ(repository->searchBackfillRemaining(), 3);
+    EXPECT_FALSE(repository->isSearchIndexReady());
+    
+    // 补建完成前回退为 LIKE，结果完整
+    EXPECT_EQ(repository->search("ab").size(), 3);
+    
+    // 迁移后写入的单词同步建索引，不计入补建
+    ASSERT_TRUE(repository->save(createTestWord(4, "abroad")));
+    EXPECT_EQ(repository->searchBackfillRemaining(), 3);
+    
+    // Act - 每次最多 2 个
+    EXPECT_EQ(repository->backfillSearchIndex(2), 1);
+    EXPECT_FALSE(repository->isSearchIndexReady());
+    EXPECT_EQ(repository->backfillSearchIndex(2), 0);
+    
+    // Assert
+    EXPECT_TRUE(repository->isSearchIndexReady());
+    EXPECT_EQ(adapter->transactionDepth(), 0);
+    EXPECT_EQ(countSearchRows(), 4);
+    EXPECT_EQ(repository->search("ab").size(), 4);
+    EXPECT_EQ(repository->backfillSearchIndex(2), 0);
+    
+    // 重新导入同一单词（INSERT OR REPLACE 换了 id）后旧 id 的索引行被删除
+    Word replaced = createTestWord(1, "abandon");
+    replaced.translations = QString::fromUtf8(R"([{"pos":"v.","cn":"放弃"}])");
+    ASSERT_TRUE(repository->saveBatch(QList<Word>() << replaced << createTestWord(5, "absent")));
+    EXPECT_EQ(countSearchRows(), 5);
+    EXPECT_EQ(repository->search(QString::fromUtf8("放弃")).size(), 1);
+    EXPECT_EQ(repository->search("ab").size(), 5);
+}
+
 // ============================================
 // 测试：事务管理
 // ============================================
@@ -316,6 +697,60 @@ TEST_F(WordRepositoryTest, TransactionManagement) {
     EXPECT_EQ(words.size(), 2);
 }
 
+#ifdef WORDMASTER_NATIVE_SQLITE
+// ============================================
+// 测试：原生后端与 QSqlQuery 读取结果一致
+// ============================================
+TEST_F(WordRepositoryTest, NativeBackendMatchesQtBackend) {
+    if (!adapter->isNativeBackendAvailable()) {
+        GTEST_SKIP() << "Qt driver and linked SQLite differ";
+    }
+    
+    Word word = createTestWord(1, "café");
+    word.phoneticUk = QString();
+    ASSERT_TRUE(repository->save(word));
+    ASSERT_TRUE(repository->save(createTestWord(2, "second")));
+    
+    QList<Word> native = repository->getByBookId("test_cet4");
+    adapter->setNativeBackendEnabled(false);
+    QList<Word> qt = repository->getByBookId("test_cet4");
+    
+    ASSERT_EQ(native.size(), 2);
+    ASSERT_EQ(native.size(), qt.size());
+    for (int i = 0; i < native.size(); ++i) {
+        EXPECT_EQ(native[i].id, qt[i].id);
+        EXPECT_EQ(native[i].word, qt[i].word);
+        EXPECT_EQ(native[i].phoneticUk, qt[i].phoneticUk);
+        EXPECT_EQ(native[i].translations, qt[i].translations);
+        EXPECT_EQ(native[i].createdAt, qt[i].createdAt);
+    }
+    EXPECT_EQ(native[0].word, QString("café"));
+}
+
+// ============================================
+// 测试：原生语句计入执行统计
+// ============================================
+TEST_F(WordRepositoryTest, NativeQueriesAreProfiled) {
+    if (!adapter->isNativeBackendAvailable()) {
+        GTEST_SKIP() << "Qt driver and linked SQLite differ";
+    }
+    
+    ASSERT_TRUE(repository->save(createTestWord(1, "apple")));
+    ASSERT_TRUE(repository->save(createTestWord(2, "banana")));
+    adapter->profiler().reset();
+    
+    ASSERT_EQ(repository->getByBookId("test_cet4").size(), 2);
+    
+    auto stats = adapter->profiler().statementStats();
+    ASSERT_EQ(stats.size(), 1);
+    EXPECT_EQ(stats[0].count, 1u);
+    EXPECT_EQ(stats[0].rowsReturned, 2u);
+    ASSERT_EQ(stats[0].sampleValues.size(), 1);
+    EXPECT_EQ(stats[0].sampleValues[0].toString(), QString("test_cet4"));
+}
+
+#endif
+
 // ============================================
 // 主函数
 // ============================================
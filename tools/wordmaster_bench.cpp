@@ -0,0 +1,477 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QCommandLineOption>
+#include <QElapsedTimer>
+#include <QDate>
+#include <QDir>
+#include <QFile>
+#include <QSqlQuery>
+#include <iostream>
+#include <iomanip>
+
+#include "infrastructure/sqlite_adapter.h"
+#include "infrastructure/schema_migrator.h"
+#include "infrastructure/storage_profile.h"
+#include "infrastructure/detail_codec.h"
+#include "infrastructure/repositories/book_repository.h"
+#include "infrastructure/repositories/word_repository.h"
+#include "infrastructure/repositories/review_schedule_repository.h"
+
+using namespace WordMaster::Infrastructure;
+using namespace WordMaster::Domain;
+
+/**
+ * @brief WordMaster 存储性能基准
+ *
+ * 对每个存储配置分别新建数据库，测量：
+ * - import: 通过 WordRepository::saveBatch 导入 N 个单词
+ * - due:    重新打开数据库后反复执行今日复习查询（getTodayReviewWords）
+ *
+ * --backends 时改为比较两种读取路径（QSqlQuery / 原生 sqlite3）：
+ * - load: 整本加载单词（getByBookId）
+ * - due:  今日复习列表
+ *
+ * --compression 时比较单词详情字段压缩前后（需以 WORDMASTER_ZSTD 构建）：
+ * - detail bytes: word_details 各字段的存储字节数
+ * - db bytes:     VACUUM 后的数据库大小
+ * - details(us):  逐个单词 loadDetails 的平均耗时（含解压）
+ * - load all(ms): 整本加载单词（getByBookId，含解压）
+ */
+namespace {
+
+const char* const kBenchBookId = "bench";
+
+struct BenchResult {
+    QString profile;
+    int pageSize = 0;
+    qint64 importMs = 0;
+    double dueQueryMs = 0.0;
+    int dueCount = 0;
+};
+
+void removeDatabaseFiles(const QString& dbPath) {
+    QFile::remove(dbPath);
+    QFile::remove(dbPath + "-wal");
+    QFile::remove(dbPath + "-shm");
+}
+
+// 生成与真实词库体量相近的单词（释义/例句为 JSON 字符串）
+QList<Word> makeWords(int count) {
+    QList<Word> words;
+    words.reserve(count);
+
+    for (int i = 1; i <= count; ++i) {
+        Word word;
+        word.bookId = kBenchBookId;
+        word.wordId = i;
+        word.word = QString("word%1").arg(i, 6, 10, QChar('0'));
+        word.phoneticUk = "ˈwɜːd";
+        word.phoneticUs = "wɝd";
+        word.translations = QString(R"([{"pos":"n.","tranCn":"单词 %1；话语"},{"pos":"v.","tranCn":"措辞"}])").arg(i);
+        word.sentences = QString(R"([{"c":"Example sentence number %1 for the benchmark.","cn":"基准测试的第 %1 个例句。"}])").arg(i);
+        word.phrases = R"([{"c":"in a word","cn":"总之"}])";
+        word.synonyms = R"([{"pos":"n.","tran":"话语","hwds":[{"w":"term"}]}])";
+        word.relatedWords = R"({"rels":[]})";
+        word.etymology = "[]";
+        words.append(word);
+    }
+
+    return words;
+}
+
+// 为全部单词生成复习计划：到期日期分布在 [-30, +30] 天，掌握程度 0-2
+bool seedReviewSchedule(SQLiteAdapter& adapter) {
+    QList<int> ids;
+    QSqlQuery select = adapter.prepare("SELECT id FROM words WHERE book_id = ?");
+    select.addBindValue(kBenchBookId);
+    if (!adapter.exec(select)) {
+        return false;
+    }
+    while (select.next()) {
+        ids.append(select.value(0).toInt());
+    }
+    select.finish();
+
+    QDate today = QDate::currentDate();
+
+    adapter.beginTransaction();
+    QSqlQuery insert = adapter.prepare(
+        "INSERT INTO review_schedule (word_id, book_id, next_review_date, mastery_level) "
+        "VALUES (?, ?, ?, ?)");
+
+    for (int i = 0; i < ids.size(); ++i) {
+        insert.addBindValue(ids[i]);
+        insert.addBindValue(kBenchBookId);
+        insert.addBindValue(today.addDays(i % 61 - 30).toString(Qt::ISODate));
+        insert.addBindValue(i % 3);
+        if (!adapter.exec(insert)) {
+            adapter.rollback();
+            return false;
+        }
+    }
+
+    return adapter.commit();
+}
+
+// 新建数据库：导入单词并生成复习计划
+bool buildDatabase(const StorageProfile& profile, const QString& dbPath,
+                   const QList<Word>& words, BenchResult& result) {
+    removeDatabaseFiles(dbPath);
+    result.profile = profile.name;
+
+    SQLiteAdapter adapter(dbPath);
+    adapter.setStorageProfile(profile);
+    if (!adapter.open() || !SchemaMigrator(adapter).migrate().success) {
+        return false;
+    }
+    result.pageSize = adapter.pageSize();
+
+    Book book;
+    book.id = kBenchBookId;
+    book.name = "Benchmark";
+    book.url = "bench.json";
+    book.wordCount = words.size();
+    BookRepository bookRepo(adapter);
+    if (!bookRepo.save(book)) {
+        return false;
+    }
+
+    WordRepository wordRepo(adapter);
+    QElapsedTimer timer;
+    timer.start();
+    if (!wordRepo.saveBatch(words)) {
+        return false;
+    }
+    result.importMs = timer.elapsed();
+
+    return seedReviewSchedule(adapter);
+}
+
+bool runProfile(const StorageProfile& profile, const QString& dbPath,
+                const QList<Word>& words, int iterations, BenchResult& result) {
+    if (!buildDatabase(profile, dbPath, words, result)) {
+        return false;
+    }
+
+    // 重新打开，排除导入阶段留在页缓存中的数据
+    SQLiteAdapter adapter(dbPath);
+    adapter.setStorageProfile(profile);
+    if (!adapter.open()) {
+        return false;
+    }
+
+    ReviewScheduleRepository scheduleRepo(adapter);
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < iterations; ++i) {
+        result.dueCount = scheduleRepo.getTodayReviewWords(kBenchBookId).size();
+    }
+    result.dueQueryMs = static_cast<double>(timer.nsecsElapsed()) / 1e6 / iterations;
+
+    adapter.close();
+    removeDatabaseFiles(dbPath);
+    return true;
+}
+
+// 比较 QSqlQuery 与原生 sqlite3 两种读取路径：整本加载单词、到期列表
+int runBackendComparison(const QString& dbPath, const QList<Word>& words, int iterations) {
+    BenchResult built;
+    if (!buildDatabase(StorageProfile::desktop(), dbPath, words, built)) {
+        std::cerr << "基准失败: 无法创建数据库" << std::endl;
+        return 1;
+    }
+
+    QStringList backends;
+    backends << "qsqlquery";
+#ifdef WORDMASTER_NATIVE_SQLITE
+    backends << "native";
+#endif
+
+    std::cout << std::left
+              << std::setw(14) << "backend"
+              << std::setw(16) << "load all(ms)"
+              << std::setw(14) << "rows/s"
+              << std::setw(14) << "due(ms)"
+              << "due rows" << std::endl;
+    std::cout << std::string(66, '-') << std::endl;
+
+    for (const QString& backend : backends) {
+        SQLiteAdapter adapter(dbPath);
+        if (!adapter.open()) {
+            return 1;
+        }
+#ifdef WORDMASTER_NATIVE_SQLITE
+        adapter.setNativeBackendEnabled(backend == "native");
+        if (backend == "native" && !adapter.isNativeBackendAvailable()) {
+            std::cerr << "原生后端不可用（Qt 驱动与链接的 SQLite 不是同一份）" << std::endl;
+            continue;
+        }
+#endif
+
+        WordRepository wordRepo(adapter);
+        ReviewScheduleRepository scheduleRepo(adapter);
+
+        int loaded = 0;
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < iterations; ++i) {
+            loaded = wordRepo.getByBookId(kBenchBookId).size();
+        }
+        double loadMs = static_cast<double>(timer.nsecsElapsed()) / 1e6 / iterations;
+
+        int dueCount = 0;
+        timer.restart();
+        for (int i = 0; i < iterations; ++i) {
+            dueCount = scheduleRepo.getTodayReviewWords(kBenchBookId).size();
+        }
+        double dueMs = static_cast<double>(timer.nsecsElapsed()) / 1e6 / iterations;
+
+        std::cout << std::left
+                  << std::setw(14) << qPrintable(backend)
+                  << std::setw(16) << std::fixed << std::setprecision(2) << loadMs
+                  << std::setw(14) << std::setprecision(0) << (loadMs > 0 ? loaded * 1000.0 / loadMs : 0.0)
+                  << std::setw(14) << std::setprecision(2) << dueMs
+                  << dueCount << std::endl;
+    }
+
+#ifndef WORDMASTER_NATIVE_SQLITE
+    std::cout << "\n（未启用 WORDMASTER_NATIVE_SQLITE，仅测试 QSqlQuery 路径）" << std::endl;
+#endif
+
+    removeDatabaseFiles(dbPath);
+    return 0;
+}
+
+// word_details 各字段的存储字节数（TEXT 按 UTF-8 计）
+qint64 detailBytes(SQLiteAdapter& adapter) {
+    QStringList columns;
+    columns << "translations" << "sentences" << "phrases"
+            << "synonyms" << "related_words" << "etymology";
+    QStringList lengths;
+    for (const QString& column : columns) {
+        lengths << QString("IFNULL(LENGTH(CAST(%1 AS BLOB)), 0)").arg(column);
+    }
+
+    QSqlQuery query = adapter.query(
+        QString("SELECT SUM(%1) FROM word_details").arg(lengths.join(" + ")));
+    return query.next() ? query.value(0).toLongLong() : -1;
+}
+
+// VACUUM 后的数据库大小
+qint64 databaseBytes(SQLiteAdapter& adapter) {
+    if (!adapter.execute("VACUUM")) {
+        return -1;
+    }
+    QSqlQuery query = adapter.query("PRAGMA page_count");
+    return query.next() ? query.value(0).toLongLong() * adapter.pageSize() : -1;
+}
+
+// 比较单词详情字段压缩前后的存储大小与读取耗时
+int runCompressionComparison(const QString& dbPath, const QList<Word>& words, int iterations) {
+    if (!DetailCodec::isAvailable()) {
+        std::cerr << "未启用 WORDMASTER_ZSTD，无法测试详情字段压缩" << std::endl;
+        return 1;
+    }
+
+    BenchResult built;
+    if (!buildDatabase(StorageProfile::desktop(), dbPath, words, built)) {
+        std::cerr << "基准失败: 无法创建数据库" << std::endl;
+        return 1;
+    }
+
+    SQLiteAdapter adapter(dbPath);
+    if (!adapter.open()) {
+        return 1;
+    }
+    WordRepository wordRepo(adapter);
+
+    // 逐个读取详情的样本：均匀取至多 2000 个单词
+    QList<int> ids;
+    QSqlQuery select = adapter.prepare("SELECT id FROM words WHERE book_id = ? ORDER BY id");
+    select.addBindValue(kBenchBookId);
+    if (!adapter.exec(select)) {
+        return 1;
+    }
+    while (select.next()) {
+        ids.append(select.value(0).toInt());
+    }
+    select.finish();
+    const int stride = qMax(1, ids.size() / 2000);
+
+    std::cout << std::left
+              << std::setw(14) << "state"
+              << std::setw(16) << "detail bytes"
+              << std::setw(14) << "db bytes"
+              << std::setw(14) << "details(us)"
+              << "load all(ms)" << std::endl;
+    std::cout << std::string(72, '-') << std::endl;
+
+    auto measure = [&](const char* state) {
+        qint64 details = detailBytes(adapter);
+        qint64 database = databaseBytes(adapter);
+
+        int loaded = 0;
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < iterations; ++i) {
+            for (int j = 0; j < ids.size(); j += stride) {
+                Word word;
+                word.id = ids[j];
+                loaded += wordRepo.loadDetails(word) ? 1 : 0;
+            }
+        }
+        double detailUs = loaded > 0 ? timer.nsecsElapsed() / 1e3 / loaded : 0.0;
+
+        timer.restart();
+        for (int i = 0; i < iterations; ++i) {
+            wordRepo.getByBookId(kBenchBookId);
+        }
+        double loadMs = static_cast<double>(timer.nsecsElapsed()) / 1e6 / iterations;
+
+        std::cout << std::left
+                  << std::setw(14) << state
+                  << std::setw(16) << details
+                  << std::setw(14) << database
+                  << std::setw(14) << std::fixed << std::setprecision(2) << detailUs
+                  << loadMs << std::endl;
+        return details;
+    };
+
+    qint64 before = measure("text");
+
+    if (!wordRepo.compressDetails(kBenchBookId)) {
+        std::cerr << "基准失败: 压缩详情字段失败" << std::endl;
+        return 1;
+    }
+    WordRepository::DetailCompressionStats stats = wordRepo.compressionStats();
+
+    qint64 after = measure("compressed");
+
+    std::cout << "\n字典: " << stats.dictionaryBytes << " 字节，压缩耗时: "
+              << stats.elapsedMs << " ms，详情字段缩小 " << std::fixed << std::setprecision(2)
+              << (after > 0 ? static_cast<double>(before) / after : 0.0) << "x" << std::endl;
+
+    adapter.close();
+    removeDatabaseFiles(dbPath);
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("WordMaster Bench");
+    QCoreApplication::setApplicationVersion("1.0.0");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("WordMaster 存储性能基准");
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    QCommandLineOption wordsOption(
+        QStringList() << "n" << "words",
+        "单词数量 (默认: 100000)",
+        "count",
+        "100000"
+    );
+    parser.addOption(wordsOption);
+
+    QCommandLineOption iterationsOption(
+        QStringList() << "iterations",
+        "到期查询重复次数 (默认: 20)",
+        "count",
+        "20"
+    );
+    parser.addOption(iterationsOption);
+
+    QCommandLineOption profileOption(
+        QStringList() << "p" << "profile",
+        "只测试指定的存储配置（可重复）",
+        "profile"
+    );
+    parser.addOption(profileOption);
+
+    QCommandLineOption dirOption(
+        QStringList() << "dir",
+        "临时数据库目录 (默认: 系统临时目录)",
+        "path",
+        QDir::tempPath()
+    );
+    parser.addOption(dirOption);
+
+    QCommandLineOption backendsOption(
+        QStringList() << "backends",
+        "比较 QSqlQuery 与原生 sqlite3 读取路径（而不是存储配置）"
+    );
+    parser.addOption(backendsOption);
+
+    QCommandLineOption compressionOption(
+        QStringList() << "compression",
+        "比较单词详情字段压缩前后的存储大小与读取耗时（需 zstd 构建）"
+    );
+    parser.addOption(compressionOption);
+
+    parser.process(app);
+
+    int wordCount = qMax(1, parser.value(wordsOption).toInt());
+    int iterations = qMax(1, parser.value(iterationsOption).toInt());
+    QString dbPath = QDir(parser.value(dirOption)).filePath("wordmaster_bench.db");
+
+    QStringList profileNames = parser.values(profileOption);
+    if (profileNames.isEmpty()) {
+        profileNames = StorageProfile::presetNames();
+    }
+
+    QList<Word> words = makeWords(wordCount);
+
+    if (parser.isSet(backendsOption)) {
+        std::cout << "单词数: " << wordCount << "，重复次数: " << iterations << std::endl;
+        return runBackendComparison(dbPath, words, iterations);
+    }
+
+    if (parser.isSet(compressionOption)) {
+        std::cout << "单词数: " << wordCount << "，重复次数: " << iterations << std::endl;
+        return runCompressionComparison(dbPath, words, iterations);
+    }
+
+    std::cout << "单词数: " << wordCount << "，到期查询次数: " << iterations << std::endl;
+    std::cout << std::left
+              << std::setw(14) << "profile"
+              << std::setw(10) << "page"
+              << std::setw(14) << "import(ms)"
+              << std::setw(14) << "words/s"
+              << std::setw(14) << "due(ms)"
+              << "due rows" << std::endl;
+    std::cout << std::string(76, '-') << std::endl;
+
+    int failures = 0;
+    for (const QString& name : profileNames) {
+        bool ok = false;
+        StorageProfile profile = StorageProfile::byName(name, &ok);
+        if (!ok) {
+            std::cerr << "未知的存储配置: " << qPrintable(name) << std::endl;
+            ++failures;
+            continue;
+        }
+
+        BenchResult result;
+        if (!runProfile(profile, dbPath, words, iterations, result)) {
+            std::cerr << "基准失败: " << qPrintable(name) << std::endl;
+            ++failures;
+            continue;
+        }
+
+        double wordsPerSec = result.importMs > 0
+            ? wordCount * 1000.0 / result.importMs : 0.0;
+
+        std::cout << std::left
+                  << std::setw(14) << qPrintable(result.profile)
+                  << std::setw(10) << result.pageSize
+                  << std::setw(14) << result.importMs
+                  << std::setw(14) << std::fixed << std::setprecision(0) << wordsPerSec
+                  << std::setw(14) << std::setprecision(2) << result.dueQueryMs
+                  << result.dueCount << std::endl;
+    }
+
+    return failures == 0 ? 0 : 1;
+}
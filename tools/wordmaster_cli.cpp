@@ -4,16 +4,22 @@
 #include <QDebug>
 #include <QFileInfo>
 #include <QDir>
+#include <QElapsedTimer>
 #include <iostream>
+#include <iomanip>
 
 #include "application/services/book_service.h"
 #include "application/services/study_service.h"
 #include "application/services/sm2_scheduler.h"
+#include "application/services/word_pack.h"
 #include "infrastructure/repositories/book_repository.h"
 #include "infrastructure/repositories/word_repository.h"
 #include "infrastructure/repositories/study_record_repository.h"
 #include "infrastructure/repositories/review_schedule_repository.h"
+#include "infrastructure/repositories/user_preference_repository.h"
 #include "infrastructure/sqlite_adapter.h"
+#include "infrastructure/schema_migrator.h"
+#include "infrastructure/detail_codec.h"
 
 using namespace WordMaster::Application;
 using namespace WordMaster::Infrastructure;
@@ -24,6 +30,7 @@ using namespace WordMaster::Domain;
  * 
  * 功能：
  * - 导入词库
+ * - 压缩词库详情字段
  * - 查看词库列表
  * - 激活词库
  * - 查看词库统计
@@ -31,17 +38,29 @@ using namespace WordMaster::Domain;
  */
 class WordMasterCLI {
 public:
-    WordMasterCLI(const QString& dbPath) 
+    WordMasterCLI(const QString& dbPath, const QString& profileName = QString()) 
         : adapter_(dbPath)
     {
+        // 命令行指定的存储配置在打开前设置，新建数据库按其 page_size 创建
+        if (!profileName.isEmpty()) {
+            adapter_.setStorageProfile(resolveProfile(profileName));
+        }
+        
         if (!adapter_.open()) {
             qFatal("Failed to open database: %s", qPrintable(dbPath));
         }
         
-        // 初始化数据库
-        QString schemaPath = "../resources/database/001_initial_schema.sql";
-        if (QFile::exists(schemaPath)) {
-            adapter_.initializeDatabase(schemaPath);
+        // 执行未应用的结构迁移（脚本内置于 Qt 资源中）
+        SchemaMigrator migrator(adapter_);
+        if (!migrator.migrate().success) {
+            qFatal("Failed to migrate database schema: %s", qPrintable(dbPath));
+        }
+        
+        // 未指定时使用用户设置中的存储配置
+        if (profileName.isEmpty()) {
+            UserPreferenceRepository prefRepo(adapter_);
+            adapter_.setStorageProfile(resolveProfile(
+                prefRepo.get(StorageProfile::kPreferenceKey, "desktop")));
         }
         
         // 创建仓储
@@ -50,6 +69,24 @@ public:
         recordRepo_ = std::make_unique<StudyRecordRepository>(adapter_);
         scheduleRepo_ = std::make_unique<ReviewScheduleRepository>(adapter_);
         
+        // 006 之前导入的单词一次补建完结构化子表（按词性查询依赖子表）
+        int structuredRemaining = wordRepo_->structuredBackfillRemaining();
+        if (structuredRemaining > 0) {
+            std::cerr << "正在整理 " << structuredRemaining << " 个单词的数据..." << std::endl;
+            while (structuredRemaining > 0) {
+                structuredRemaining = wordRepo_->backfillStructuredFields(5000);
+            }
+            if (structuredRemaining < 0) {
+                std::cerr << "警告: 整理单词数据失败，按词性查询可能不完整" << std::endl;
+            }
+        }
+        
+        // 全文索引由迁移创建；迁移前已有的单词由 --rebuild-search-index 或图形界面补建，
+        // 补建完成前搜索回退为 LIKE
+        if (wordRepo_->searchBackfillRemaining() > 0) {
+            std::cerr << "提示: 全文索引尚未建立完成，可运行 --rebuild-search-index" << std::endl;
+        }
+        
         // 创建服务
         bookService_ = std::make_unique<BookService>(*bookRepo_, *wordRepo_);
         scheduler_ = std::make_unique<SM2Scheduler>(*scheduleRepo_);
@@ -57,17 +94,87 @@ public:
     }
     
     // 导入词库
-    void importBooks(const QString& metaJsonPath) {
+    void importBooks(const QString& metaJsonPath, bool bulkLoad, bool compressDetails) {
         std::cout << "开始导入词库..." << std::endl;
         std::cout << "元数据文件: " << qPrintable(metaJsonPath) << std::endl;
+        if (bulkLoad) {
+            std::cout << "批量导入模式: 导入结束后重建单词索引" << std::endl;
+        }
+        if (compressDetails) {
+            std::cout << "导入后压缩单词详情字段" << std::endl;
+        }
         
-        auto result = bookService_->importBooksFromMeta(metaJsonPath);
+        wordRepo_->resetBulkLoadStats();
+        auto result = bookService_->importBooksFromMeta(metaJsonPath, bulkLoad, compressDetails);
+        WordRepository::BulkLoadStats bulk = wordRepo_->bulkLoadStats();
         
         std::cout << "\n导入结果:" << std::endl;
         std::cout << "  状态: " << (result.success ? "成功" : "失败") << std::endl;
         std::cout << "  消息: " << qPrintable(result.message) << std::endl;
         std::cout << "  导入词库数: " << result.importedBooks << std::endl;
         std::cout << "  导入单词数: " << result.importedWords << std::endl;
+        std::cout << "  写入速度: " << static_cast<qint64>(bulk.rowsPerSecond())
+                  << " 行/秒" << std::endl;
+    }
+    
+    // 增量更新已导入的词库
+    void updateBooks(const QString& metaJsonPath) {
+        std::cout << "开始增量更新词库..." << std::endl;
+        std::cout << "元数据文件: " << qPrintable(metaJsonPath) << std::endl;
+        
+        auto result = bookService_->updateBooksFromMeta(metaJsonPath);
+        
+        std::cout << "\n更新结果:" << std::endl;
+        std::cout << "  状态: " << (result.success ? "成功" : "失败") << std::endl;
+        std::cout << "  消息: " << qPrintable(result.message) << std::endl;
+        std::cout << "  新导入词库数: " << result.importedBooks << std::endl;
+        
+        for (const DeltaImporter::Summary& summary : result.updates) {
+            std::cout << "\n  " << qPrintable(summary.bookId) << ": ";
+            if (!summary.success) {
+                std::cout << "失败 (" << qPrintable(summary.error) << ")" << std::endl;
+                continue;
+            }
+            std::cout << (summary.hasChanges() ? "" : "无变化 ")
+                      << "新增 " << summary.inserted
+                      << "，修改 " << summary.updated
+                      << "，删除 " << summary.deleted
+                      << "，未变 " << summary.unchanged
+                      << " (" << summary.elapsedMs << " ms)" << std::endl;
+        }
+    }
+    
+    // 压缩已导入词库的单词详情字段
+    void compressDetails(const QString& bookId) {
+        Book book = bookService_->getBookById(bookId);
+        
+        if (book.id.isEmpty()) {
+            std::cout << "错误: 词库不存在: " << qPrintable(bookId) << std::endl;
+            return;
+        }
+        
+        if (!wordRepo_->compressDetails(bookId)) {
+            std::cout << "压缩失败" << (DetailCodec::isAvailable() ? "" : "（未启用 WORDMASTER_ZSTD）")
+                      << std::endl;
+            return;
+        }
+        
+        WordRepository::DetailCompressionStats stats = wordRepo_->compressionStats();
+        if (stats.rows == 0) {
+            std::cout << "没有需要压缩的字段（已压缩或词库过小）" << std::endl;
+            return;
+        }
+        
+        std::cout << "\n压缩结果:" << std::endl;
+        std::cout << "  单词数: " << stats.rows << "，字段数: " << stats.fields << std::endl;
+        std::cout << "  压缩前: " << stats.bytesBefore << " 字节" << std::endl;
+        std::cout << "  压缩后: " << stats.bytesAfter << " 字节 ("
+                  << std::fixed << std::setprecision(2) << stats.ratio() << "x)" << std::endl;
+        if (stats.dictionaryBytes > 0) {
+            std::cout << "  新字典: " << stats.dictionaryBytes << " 字节" << std::endl;
+        }
+        std::cout << "  耗时: " << stats.elapsedMs << " ms" << std::endl;
+        std::cout << "释放的空间需执行 --vacuum 后才会从文件中回收" << std::endl;
     }
     
     // 列出所有词库
@@ -130,26 +237,51 @@ public:
         }
     }
     
-    // 搜索单词
-    void searchWord(const QString& word) {
-        QList<Word> words = wordRepo_->searchByWord(word);
+    // 搜索单词（全文搜索单词、释义、例句、短语）
+    void searchWord(const QString& text, const QString& bookId) {
+        QElapsedTimer timer;
+        timer.start();
+        QList<WordSearchHit> hits = wordRepo_->search(text, bookId);
+        qint64 elapsedUs = timer.nsecsElapsed() / 1000;
         
-        if (words.isEmpty()) {
+        if (hits.isEmpty()) {
             std::cout << "未找到匹配的单词。" << std::endl;
             return;
         }
         
-        std::cout << "\n搜索结果 (共 " << words.size() << " 个):" << std::endl;
+        std::cout << "\n搜索结果 (共 " << hits.size() << " 个，耗时 "
+                  << std::fixed << std::setprecision(2) << elapsedUs / 1000.0 << " ms"
+                  << (wordRepo_->isSearchIndexReady() ? "" : "，未启用全文索引") << "):" << std::endl;
         std::cout << std::string(80, '=') << std::endl;
         
-        for (const Word& w : words) {
+        for (const WordSearchHit& hit : hits) {
+            const Word& w = hit.word;
             std::cout << "\n单词: " << qPrintable(w.word) << std::endl;
             std::cout << "音标: " << qPrintable(w.phoneticUk) << std::endl;
+            std::cout << "释义: " << qPrintable(w.gloss) << std::endl;
+            std::cout << "命中: " << qPrintable(WordSearchHit::highlight(
+                hit.snippet, QString::fromUtf8("【"), QString::fromUtf8("】"))) << std::endl;
             std::cout << "词库: " << qPrintable(w.bookId) << std::endl;
             std::cout << std::string(80, '-') << std::endl;
         }
     }
     
+    // 重建全文索引
+    void rebuildSearchIndex() {
+        if (!wordRepo_->hasSearchIndex()) {
+            std::cout << "全文索引不可用（SQLite 未启用 FTS5）" << std::endl;
+            return;
+        }
+        
+        QElapsedTimer timer;
+        timer.start();
+        if (wordRepo_->rebuildSearchIndex()) {
+            std::cout << "全文索引已重建，耗时 " << timer.elapsed() << " ms" << std::endl;
+        } else {
+            std::cout << "重建全文索引失败" << std::endl;
+        }
+    }
+    
     // 显示词库中的单词样本
     void showWordSamples(const QString& bookId, int count = 10) {
         Book book = bookService_->getBookById(bookId);
@@ -159,7 +291,7 @@ public:
             return;
         }
         
-        QList<Word> words = wordRepo_->getByBookId(bookId, count, 0);
+        QList<Word> words = wordRepo_->getByBookId(bookId, count, 0, WordProjection::Summary);
         
         if (words.isEmpty()) {
             std::cout << "该词库暂无单词。" << std::endl;
@@ -175,6 +307,80 @@ public:
             std::cout << "\n" << (i + 1) << ". " << qPrintable(w.word) << std::endl;
             std::cout << "   音标: " << qPrintable(w.phoneticUk) 
                       << " / " << qPrintable(w.phoneticUs) << std::endl;
+            std::cout << "   释义: " << qPrintable(w.gloss) << std::endl;
+        }
+    }
+    
+    // 配置慢查询日志
+    void configureQueryProfiler(int slowQueryMs, const QString& logFile) {
+        adapter_.profiler().setSlowQueryThreshold(slowQueryMs);
+        adapter_.profiler().setSlowQueryLogFile(logFile);
+    }
+    
+    // 输出 SQL 执行统计
+    void showQueryStats(int limit = 20) {
+        const QueryProfiler& profiler = adapter_.profiler();
+        QList<QueryProfiler::StatementStats> stats = profiler.statementStats();
+        
+        std::cout << "\nSQL 执行统计 (按总耗时排序，共 " << stats.size() << " 条语句):" << std::endl;
+        std::cout << std::string(100, '=') << std::endl;
+        std::cout << std::left
+                  << std::setw(8) << "次数"
+                  << std::setw(12) << "总计(ms)"
+                  << std::setw(10) << "p50(us)"
+                  << std::setw(10) << "p95(us)"
+                  << std::setw(10) << "p99(us)"
+                  << std::setw(10) << "影响行数"
+                  << std::setw(10) << "返回行数"
+                  << "SQL" << std::endl;
+        std::cout << std::string(100, '-') << std::endl;
+        
+        for (int i = 0; i < stats.size() && i < limit; ++i) {
+            const auto& s = stats[i];
+            std::cout << std::left
+                      << std::setw(8) << s.count
+                      << std::setw(12) << std::fixed << std::setprecision(2) << s.totalUs / 1000.0
+                      << std::setw(10) << s.p50Us
+                      << std::setw(10) << s.p95Us
+                      << std::setw(10) << s.p99Us
+                      << std::setw(10) << s.rowsAffected
+                      << std::setw(10) << s.rowsReturned
+                      << qPrintable(s.sql.left(120)) << std::endl;
+        }
+        
+        QList<QueryProfiler::SlowQuery> slow = profiler.slowQueries();
+        if (slow.isEmpty()) {
+            return;
+        }
+        
+        std::cout << "\n慢查询 (阈值 " << profiler.slowQueryThreshold() << " ms):" << std::endl;
+        std::cout << std::string(100, '=') << std::endl;
+        for (const auto& q : slow) {
+            QStringList params;
+            for (const QVariant& value : q.boundValues) {
+                params << (value.isNull() ? QString("NULL") : value.toString());
+            }
+            
+            std::cout << std::fixed << std::setprecision(2) << q.elapsedUs / 1000.0 << " ms  "
+                      << qPrintable(QueryProfiler::normalizeSql(q.sql)) << std::endl;
+            std::cout << "  参数: [" << qPrintable(params.join(", ")) << "]" << std::endl;
+            for (const QString& step : q.plan) {
+                std::cout << "  计划: " << qPrintable(step) << std::endl;
+            }
+        }
+    }
+    
+    // 按当前存储配置的页大小重建数据库
+    void rebuildStorage() {
+        StorageProfile profile = adapter_.storageProfile();
+        std::cout << "存储配置: " << qPrintable(profile.name) << std::endl;
+        std::cout << "当前页大小: " << adapter_.pageSize()
+                  << "，目标页大小: " << profile.pageSize << std::endl;
+        
+        if (adapter_.rebuildWithPageSize()) {
+            std::cout << "重建完成，页大小: " << adapter_.pageSize() << std::endl;
+        } else {
+            std::cout << "重建失败: " << qPrintable(adapter_.lastError()) << std::endl;
         }
     }
     
@@ -203,6 +409,17 @@ public:
     }
 
 private:
+    static StorageProfile resolveProfile(const QString& name) {
+        bool ok = false;
+        StorageProfile profile = StorageProfile::byName(name, &ok);
+        if (!ok) {
+            std::cerr << "未知的存储配置: " << qPrintable(name)
+                      << "，可选: " << qPrintable(StorageProfile::presetNames().join(", "))
+                      << "，使用 desktop" << std::endl;
+        }
+        return profile;
+    }
+    
     SQLiteAdapter adapter_;
     std::unique_ptr<BookRepository> bookRepo_;
     std::unique_ptr<WordRepository> wordRepo_;
@@ -213,6 +430,42 @@ private:
     std::unique_ptr<StudyService> studyService_;
 };
 
+/**
+ * @brief 把词库 JSON 编译为二进制词库包，不需要数据库
+ * @param outputPath 为空时与输入同目录，扩展名换为 .wmpack
+ */
+int compilePack(const QString& jsonPath, QString outputPath) {
+    if (outputPath.isEmpty()) {
+        QString base = jsonPath;
+        for (const QString& suffix : QStringList() << ".gz" << ".zst" << ".json") {
+            if (base.endsWith(suffix, Qt::CaseInsensitive)) {
+                base.chop(suffix.size());
+            }
+        }
+        outputPath = base + ".wmpack";
+    }
+
+    std::cout << "编译词库包..." << std::endl;
+    std::cout << "输入: " << qPrintable(jsonPath) << std::endl;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QString error;
+    int wordCount = 0;
+    if (!WordPack::compile(jsonPath, outputPath, &error, &wordCount)) {
+        std::cout << "编译失败: " << qPrintable(error) << std::endl;
+        return 1;
+    }
+
+    std::cout << "输出: " << qPrintable(outputPath) << std::endl;
+    std::cout << "  单词数: " << wordCount << std::endl;
+    std::cout << "  原始大小: " << QFileInfo(jsonPath).size() << " 字节" << std::endl;
+    std::cout << "  词库包大小: " << QFileInfo(outputPath).size() << " 字节" << std::endl;
+    std::cout << "  耗时: " << timer.elapsed() << " ms" << std::endl;
+    return 0;
+}
+
 int main(int argc, char *argv[]) {
     QCoreApplication app(argc, argv);
     QCoreApplication::setApplicationName("WordMaster CLI");
@@ -241,6 +494,46 @@ int main(int argc, char *argv[]) {
     );
     parser.addOption(importOption);
     
+    QCommandLineOption bulkLoadOption(
+        QStringList() << "bulk-load",
+        "与 --import 一起使用：导入期间暂停单词索引维护，结束时一次性重建"
+    );
+    parser.addOption(bulkLoadOption);
+    
+    QCommandLineOption compressDetailsOption(
+        QStringList() << "compress-details",
+        "与 --import 一起使用：导入后按词库训练字典压缩单词详情字段（需 zstd 构建）"
+    );
+    parser.addOption(compressDetailsOption);
+    
+    QCommandLineOption compressOption(
+        QStringList() << "compress",
+        "压缩已导入词库的单词详情字段（需 zstd 构建）",
+        "book-id"
+    );
+    parser.addOption(compressOption);
+    
+    QCommandLineOption updateOption(
+        QStringList() << "u" << "update",
+        "增量更新词库（只写入变化的单词，保留学习进度）",
+        "meta-json"
+    );
+    parser.addOption(updateOption);
+    
+    QCommandLineOption compilePackOption(
+        QStringList() << "compile-pack",
+        "把词库JSON编译为二进制词库包 (.wmpack)",
+        "book-json"
+    );
+    parser.addOption(compilePackOption);
+    
+    QCommandLineOption outputOption(
+        QStringList() << "o" << "output",
+        "--compile-pack 的输出文件 (默认: 同名 .wmpack)",
+        "file"
+    );
+    parser.addOption(outputOption);
+    
     QCommandLineOption listOption(
         QStringList() << "l" << "list",
         "列出所有词库"
@@ -263,11 +556,24 @@ int main(int argc, char *argv[]) {
     
     QCommandLineOption searchOption(
         QStringList() << "search",
-        "搜索单词",
-        "word"
+        "全文搜索单词、释义、例句与短语（中文按字匹配）",
+        "text"
     );
     parser.addOption(searchOption);
     
+    QCommandLineOption bookOption(
+        QStringList() << "book",
+        "与 --search 一起使用：只搜索指定词库",
+        "book-id"
+    );
+    parser.addOption(bookOption);
+    
+    QCommandLineOption rebuildSearchOption(
+        QStringList() << "rebuild-search-index",
+        "重建全文搜索索引"
+    );
+    parser.addOption(rebuildSearchOption);
+    
     QCommandLineOption samplesOption(
         QStringList() << "samples",
         "显示词库单词样本",
@@ -282,11 +588,52 @@ int main(int argc, char *argv[]) {
     );
     parser.addOption(deleteOption);
     
+    QCommandLineOption profileOption(
+        QStringList() << "storage-profile",
+        "存储配置: " + StorageProfile::presetNames().join(" / ") + " (默认读取用户设置)",
+        "profile"
+    );
+    parser.addOption(profileOption);
+    
+    QCommandLineOption vacuumOption(
+        QStringList() << "vacuum",
+        "按存储配置的页大小重建数据库"
+    );
+    parser.addOption(vacuumOption);
+    
+    QCommandLineOption queryStatsOption(
+        QStringList() << "query-stats",
+        "命令执行完成后输出 SQL 执行统计与慢查询"
+    );
+    parser.addOption(queryStatsOption);
+    
+    QCommandLineOption slowQueryOption(
+        QStringList() << "slow-query-ms",
+        "慢查询阈值，毫秒 (默认: 100，负数关闭)",
+        "ms",
+        QString::number(QueryProfiler::kDefaultSlowQueryThresholdMs)
+    );
+    parser.addOption(slowQueryOption);
+    
+    QCommandLineOption slowLogOption(
+        QStringList() << "slow-query-log",
+        "慢查询日志文件",
+        "file"
+    );
+    parser.addOption(slowLogOption);
+    
     parser.process(app);
     
+    // 编译词库包不打开数据库
+    if (parser.isSet(compilePackOption)) {
+        return compilePack(parser.value(compilePackOption), parser.value(outputOption));
+    }
+    
     // 创建 CLI 工具实例
     QString dbPath = parser.value(dbOption);
-    WordMasterCLI cli(dbPath);
+    WordMasterCLI cli(dbPath, parser.value(profileOption));
+    cli.configureQueryProfiler(parser.value(slowQueryOption).toInt(),
+                               parser.value(slowLogOption));
     
     std::cout << "WordMaster CLI v1.0.0" << std::endl;
     std::cout << "数据库: " << qPrintable(dbPath) << std::endl;
@@ -295,7 +642,16 @@ int main(int argc, char *argv[]) {
     // 执行命令
     if (parser.isSet(importOption)) {
         QString metaPath = parser.value(importOption);
-        cli.importBooks(metaPath);
+        cli.importBooks(metaPath, parser.isSet(bulkLoadOption),
+                        parser.isSet(compressDetailsOption));
+    }
+    else if (parser.isSet(updateOption)) {
+        QString metaPath = parser.value(updateOption);
+        cli.updateBooks(metaPath);
+    }
+    else if (parser.isSet(compressOption)) {
+        QString bookId = parser.value(compressOption);
+        cli.compressDetails(bookId);
     }
     else if (parser.isSet(listOption)) {
         cli.listBooks();
@@ -309,8 +665,11 @@ int main(int argc, char *argv[]) {
         cli.activateBook(bookId);
     }
     else if (parser.isSet(searchOption)) {
-        QString word = parser.value(searchOption);
-        cli.searchWord(word);
+        QString text = parser.value(searchOption);
+        cli.searchWord(text, parser.value(bookOption));
+    }
+    else if (parser.isSet(rebuildSearchOption)) {
+        cli.rebuildSearchIndex();
     }
     else if (parser.isSet(samplesOption)) {
         QString bookId = parser.value(samplesOption);
@@ -320,9 +679,16 @@ int main(int argc, char *argv[]) {
         QString bookId = parser.value(deleteOption);
         cli.deleteBook(bookId);
     }
-    else {
+    else if (parser.isSet(vacuumOption)) {
+        cli.rebuildStorage();
+    }
+    else if (!parser.isSet(queryStatsOption)) {
         parser.showHelp();
     }
     
+    if (parser.isSet(queryStatsOption)) {
+        cli.showQueryStats();
+    }
+    
     return 0;
 }
\ No newline at end of file